@@ -0,0 +1,114 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+void BenchmarkRegistry::Add(std::string name, BenchmarkFunction function) {
+    entries_.push_back(Entry{.name = std::move(name), .function = std::move(function)});
+}
+
+std::vector<BenchmarkResult> BenchmarkRegistry::Run(const std::string_view filter,
+                                                    const std::chrono::nanoseconds min_time,
+                                                    const std::size_t repetition_count) const {
+    using Clock = std::chrono::steady_clock;
+
+    const auto measure = [](const BenchmarkFunction& function, const std::size_t iterations) {
+        const Clock::time_point start = Clock::now();
+        function(iterations);
+        return Clock::now() - start;
+    };
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& [name, function] : entries_) {
+        if (name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        std::size_t iterations = 1;
+        while (measure(function, iterations) < min_time && iterations < std::numeric_limits<std::size_t>::max() / 2) {
+            iterations *= 2;
+        }
+
+        auto best_time = Clock::duration::max();
+        for (std::size_t repetition = 0; repetition < repetition_count; ++repetition) {
+            best_time = (std::min)(best_time, Clock::duration{measure(function, iterations)});
+        }
+
+        const double nanoseconds = std::chrono::duration<double, std::nano>{best_time}.count();
+        const double nanoseconds_per_operation = nanoseconds / static_cast<double>(iterations);
+        results.push_back(BenchmarkResult{
+            .name = name,
+            .nanoseconds_per_operation = nanoseconds_per_operation,
+            .operations_per_second = 1e9 / nanoseconds_per_operation,
+        });
+    }
+    return results;
+}
+
+Baseline LoadBaseline(const std::filesystem::path& path) {
+    std::ifstream stream{path};
+    if (!stream) {
+        throw std::runtime_error{"Could not open the baseline " + path.string()};
+    }
+
+    Baseline baseline;
+    std::string name;
+    double nanoseconds_per_operation;
+    while (stream >> name >> nanoseconds_per_operation) {
+        baseline.insert_or_assign(name, nanoseconds_per_operation);
+    }
+    return baseline;
+}
+
+void SaveBaseline(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results) {
+    std::ofstream stream{path};
+    if (!stream) {
+        throw std::runtime_error{"Could not write the baseline " + path.string()};
+    }
+
+    stream.precision(std::numeric_limits<double>::max_digits10);
+    for (const BenchmarkResult& result : results) {
+        stream << result.name << ' ' << result.nanoseconds_per_operation << '\n';
+    }
+}
+
+std::shared_ptr<borov_engine::MeshCollision> SphereMesh(const std::size_t triangle_count,
+                                                       const borov_engine::math::Vector3& center, const float radius) {
+    namespace math = borov_engine::math;
+    using Index = borov_engine::MeshCollision::Index;
+
+    // Every quad of the grid is two triangles, and there are twice as many slices as stacks
+    const auto stack_count =
+        (std::max)(Index{2}, static_cast<Index>(std::lround(std::sqrt(static_cast<double>(triangle_count) / 4.0))));
+    const Index slice_count = stack_count * 2;
+
+    borov_engine::MeshCollision::VertexCollection vertices;
+    for (Index stack = 0; stack <= stack_count; ++stack) {
+        const float polar = std::numbers::pi_v<float> * static_cast<float>(stack) / static_cast<float>(stack_count);
+        for (Index slice = 0; slice <= slice_count; ++slice) {
+            const float azimuth =
+                2.0f * std::numbers::pi_v<float> * static_cast<float>(slice) / static_cast<float>(slice_count);
+            const math::Vector3 direction{
+                std::sin(polar) * std::cos(azimuth),
+                std::cos(polar),
+                std::sin(polar) * std::sin(azimuth),
+            };
+            vertices.push_back(center + direction * radius);
+        }
+    }
+
+    borov_engine::MeshCollision::IndexCollection indices;
+    for (Index stack = 0; stack < stack_count; ++stack) {
+        for (Index slice = 0; slice < slice_count; ++slice) {
+            const Index top_left = stack * (slice_count + 1) + slice;
+            const Index bottom_left = top_left + slice_count + 1;
+            indices.insert(indices.end(), {top_left, bottom_left, top_left + 1});
+            indices.insert(indices.end(), {top_left + 1, bottom_left, bottom_left + 1});
+        }
+    }
+    return std::make_shared<borov_engine::MeshCollision>(std::move(vertices), std::move(indices));
+}
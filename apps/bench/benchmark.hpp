@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef BENCH_BENCHMARK_HPP_INCLUDED
+#define BENCH_BENCHMARK_HPP_INCLUDED
+
+#include <borov_engine/collision.hpp>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Runs the body the given number of times, everything it computes must be passed to `DoNotOptimize`
+using BenchmarkFunction = std::function<void(std::size_t iterations)>;
+
+struct BenchmarkResult {
+    std::string name;
+    double nanoseconds_per_operation;
+    double operations_per_second;
+};
+
+// Keeps the compiler from removing the computation whose result is never used otherwise. The value is only made
+// observable in place, so unlike storing it somewhere the barrier costs no more than keeping it in a register
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    // No inline assembly on x64, so the value is read back as volatile behind the compiler barrier
+    static_cast<void>(*reinterpret_cast<const volatile char*>(std::addressof(value)));
+    _ReadWriteBarrier();
+#else
+    // Values which do not fit into a register are left in memory, where the barrier reads them
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*)) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    } else {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+#endif
+}
+
+class BenchmarkRegistry {
+  public:
+    void Add(std::string name, BenchmarkFunction function);
+
+    // Iterations are doubled until one repetition takes the min time, then the fastest of the repetitions is kept,
+    // which is the least disturbed by the rest of the system
+    [[nodiscard]] std::vector<BenchmarkResult> Run(std::string_view filter, std::chrono::nanoseconds min_time,
+                                                   std::size_t repetition_count) const;
+
+  private:
+    struct Entry {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+// Baseline is a text file with the name and nanoseconds per operation of one benchmark on every line
+using Baseline = std::map<std::string, double, std::less<>>;
+
+[[nodiscard]] Baseline LoadBaseline(const std::filesystem::path& path);
+void SaveBaseline(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results);
+
+// UV sphere with about the given number of triangles, which is the typical closed mesh for every query
+[[nodiscard]] std::shared_ptr<borov_engine::MeshCollision> SphereMesh(std::size_t triangle_count,
+                                                                     const borov_engine::math::Vector3& center,
+                                                                     float radius);
+
+void RegisterBroadPhaseBenchmarks(BenchmarkRegistry& registry);
+void RegisterCollisionBenchmarks(BenchmarkRegistry& registry);
+void RegisterCollisionWorldBenchmarks(BenchmarkRegistry& registry);
+void RegisterMeshBenchmarks(BenchmarkRegistry& registry);
+void RegisterTransformBenchmarks(BenchmarkRegistry& registry);
+void RegisterTriangleBenchmarks(BenchmarkRegistry& registry);
+
+#endif  // BENCH_BENCHMARK_HPP_INCLUDED
@@ -0,0 +1,153 @@
+#include <array>
+#include <borov_engine/broad_phase.hpp>
+#include <borov_engine/sweep_and_prune_broad_phase.hpp>
+#include <borov_engine/tree_broad_phase.hpp>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+using borov_engine::BroadPhase;
+
+// Moving bodies of the whole level, from a small scene up to the target size
+constexpr std::array body_counts{std::size_t{1000}, std::size_t{10000}, std::size_t{100000}};
+// Every pair is tested by the baseline, so one step of the largest scene would take seconds
+constexpr std::size_t max_brute_force_body_count = 10000;
+
+constexpr float body_extent = 0.5f;
+// Field grows with the count of bodies, so every body overlaps about the same number of others at any size
+constexpr float field_area_per_body = 8.0f;
+constexpr float field_height = 2.0f;
+constexpr float max_speed = 0.05f;
+
+// Bodies roam the field like the objects of the katamari level and bounce off its edges.
+// Scene without the broad phase only moves the bodies
+struct BroadPhaseScene {
+    std::unique_ptr<BroadPhase> broad_phase;
+    std::vector<math::Vector3> positions;
+    std::vector<math::Vector3> velocities;
+    std::vector<BroadPhase::ProxyId> proxies;
+    math::Vector3 field_extents;
+
+    BroadPhaseScene(std::unique_ptr<BroadPhase> phase, const std::size_t body_count)
+        : broad_phase{std::move(phase)} {
+        const float field_size = std::sqrt(field_area_per_body * static_cast<float>(body_count));
+        field_extents = math::Vector3{field_size * 0.5f, field_height * 0.5f, field_size * 0.5f};
+
+        std::mt19937 generator{42};
+        std::uniform_real_distribution<float> unit{-1.0f, 1.0f};
+        const auto random_vector = [&](const math::Vector3& scale) {
+            return math::Vector3{unit(generator), unit(generator), unit(generator)} * scale;
+        };
+        for (std::size_t body = 0; body < body_count; ++body) {
+            positions.push_back(random_vector(field_extents));
+            velocities.push_back(random_vector(math::Vector3{max_speed}));
+        }
+        if (broad_phase == nullptr) {
+            return;
+        }
+
+        for (std::size_t body = 0; body < body_count; ++body) {
+            proxies.push_back(broad_phase->Add(Bounds(body)));
+        }
+        broad_phase->UpdatePairs();
+    }
+
+    [[nodiscard]] math::AxisAlignedBox Bounds(const std::size_t body) const {
+        return math::AxisAlignedBox{positions[body], math::Vector3{body_extent}};
+    }
+
+    // Moves every body by its velocity and finds the pairs, which is what the collision world does every update
+    void Step() {
+        for (std::size_t body = 0; body < positions.size(); ++body) {
+            math::Vector3& position = positions[body];
+            math::Vector3& velocity = velocities[body];
+            position += velocity;
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                float& coordinate = (&position.x)[axis];
+                const float extent = (&field_extents.x)[axis];
+                if (std::abs(coordinate) > extent) {
+                    (&velocity.x)[axis] = -(&velocity.x)[axis];
+                    coordinate = std::copysign(extent, coordinate);
+                }
+            }
+        }
+        if (broad_phase == nullptr) {
+            return;
+        }
+
+        for (std::size_t body = 0; body < positions.size(); ++body) {
+            broad_phase->Move(proxies[body], Bounds(body));
+        }
+        broad_phase->UpdatePairs();
+    }
+};
+
+void RegisterBroadPhaseBenchmark(BenchmarkRegistry& registry, const std::string& name,
+                                 std::unique_ptr<BroadPhase> broad_phase, const std::size_t body_count) {
+    const auto scene = std::make_shared<BroadPhaseScene>(std::move(broad_phase), body_count);
+
+    // Measured per body, so the sizes compare directly and show how the cost grows with the count
+    registry.Add("broad_phase/" + name + "/" + std::to_string(body_count) + "/Update",
+                 [scene, body_count](const std::size_t iterations) {
+                     const std::size_t step_count = (iterations + body_count - 1) / body_count;
+                     for (std::size_t i = 0; i < step_count; ++i) {
+                         scene->Step();
+                         DoNotOptimize(scene->broad_phase->Pairs().size());
+                     }
+                 });
+}
+
+// Baseline which tests the bounds of every pair of bodies, measured the same way as the broad phases
+void RegisterBruteForceBenchmark(BenchmarkRegistry& registry, const std::size_t body_count) {
+    const auto scene = std::make_shared<BroadPhaseScene>(nullptr, body_count);
+    registry.Add("broad_phase/BruteForce/" + std::to_string(body_count) + "/Update",
+                 [scene, body_count](const std::size_t iterations) {
+                     std::vector<BroadPhase::ProxyPair> pairs;
+                     std::vector<math::AxisAlignedBox> bounds(body_count);
+                     const std::size_t step_count = (iterations + body_count - 1) / body_count;
+                     for (std::size_t i = 0; i < step_count; ++i) {
+                         scene->Step();
+                         for (std::size_t body = 0; body < body_count; ++body) {
+                             bounds[body] = scene->Bounds(body);
+                         }
+
+                         pairs.clear();
+                         for (std::size_t lhs = 0; lhs < body_count; ++lhs) {
+                             for (std::size_t rhs = lhs + 1; rhs < body_count; ++rhs) {
+                                 if (bounds[lhs].Intersects(bounds[rhs])) {
+                                     pairs.emplace_back(static_cast<BroadPhase::ProxyId>(lhs),
+                                                        static_cast<BroadPhase::ProxyId>(rhs));
+                                 }
+                             }
+                         }
+                         DoNotOptimize(pairs.size());
+                     }
+                 });
+}
+
+}  // namespace
+
+void RegisterBroadPhaseBenchmarks(BenchmarkRegistry& registry) {
+    for (const std::size_t body_count : body_counts) {
+        RegisterBroadPhaseBenchmark(registry, "Tree", std::make_unique<borov_engine::TreeBroadPhase>(), body_count);
+
+        using SweepAndPrune = borov_engine::SweepAndPruneBroadPhase;
+        RegisterBroadPhaseBenchmark(registry, "SweepAndPrune", std::make_unique<SweepAndPrune>(), body_count);
+        RegisterBroadPhaseBenchmark(registry, "SweepAndPruneX",
+                                    std::make_unique<SweepAndPrune>(SweepAndPrune::Axes::X), body_count);
+
+        if (body_count <= max_brute_force_body_count) {
+            RegisterBruteForceBenchmark(registry, body_count);
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include <array>
+#include <borov_engine/collision.hpp>
+#include <borov_engine/quickhull.hpp>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+using CollisionPointer = std::shared_ptr<const borov_engine::Collision>;
+
+constexpr std::size_t mesh_triangle_count = 1024;
+
+// Every shape is moved a bit from the common center in its own direction, so the shapes overlap partially
+// and the exact tests do not stop at the first check. The frustum looks from the origin down -Z at the center
+math::Vector3 CenterOf(const std::size_t shape, const std::size_t shape_count) {
+    const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(shape) / static_cast<float>(shape_count);
+    return math::Vector3{0.0f, 0.0f, -2.0f} + math::Vector3{std::cos(angle), std::sin(angle), 0.0f} * 0.75f;
+}
+
+std::vector<std::pair<std::string, CollisionPointer>> Collisions() {
+    constexpr std::size_t shape_count = 9;
+    std::size_t shape = 0;
+    const auto next_center = [&] { return CenterOf(shape++, shape_count); };
+
+    std::vector<std::pair<std::string, CollisionPointer>> collisions;
+    collisions.emplace_back("Sphere",
+                            std::make_shared<borov_engine::SphereCollision>(math::Sphere{next_center(), 1.0f}));
+    collisions.emplace_back("AxisAlignedBox", std::make_shared<borov_engine::AxisAlignedBoxCollision>(
+                                                  math::AxisAlignedBox{next_center(), math::Vector3{1.0f}}));
+    collisions.emplace_back("Box", std::make_shared<borov_engine::BoxCollision>(math::Box{
+                                       next_center(),
+                                       math::Vector3{1.0f, 0.5f, 0.5f},
+                                       math::Quaternion::CreateFromYawPitchRoll(0.3f, 0.5f, 0.7f),
+                                   }));
+    next_center();
+    collisions.emplace_back(
+        "Frustum", std::make_shared<borov_engine::FrustumCollision>(math::Frustum{
+                       math::Matrix4x4::CreatePerspectiveFieldOfView(1.0f, 1.0f, 0.1f, 5.0f),
+                       true,
+                   }));
+    collisions.emplace_back("Plane", std::make_shared<borov_engine::PlaneCollision>(
+                                         math::Plane{next_center(), math::Normalize(math::Vector3{1.0f, 1.0f, 0.0f})}));
+
+    const math::Vector3 triangle_center = next_center();
+    collisions.emplace_back("Triangle", std::make_shared<borov_engine::TriangleCollision>(math::Triangle{
+                                            .point0 = triangle_center + math::Vector3{-1.0f, -1.0f, 0.0f},
+                                            .point1 = triangle_center + math::Vector3{1.0f, -1.0f, 0.5f},
+                                            .point2 = triangle_center + math::Vector3{0.0f, 1.0f, -0.5f},
+                                        }));
+
+    collisions.emplace_back("Mesh", SphereMesh(mesh_triangle_count, next_center(), 1.0f));
+
+    // Instance and hull share the mesh at the origin and are placed by their transforms
+    const std::shared_ptr<const borov_engine::MeshCollision> mesh =
+        SphereMesh(mesh_triangle_count, math::Vector3::Zero, 1.0f);
+    collisions.emplace_back("MeshInstance", std::make_shared<borov_engine::MeshInstanceCollision>(
+                                                mesh, borov_engine::Transform{.position = next_center()}));
+
+    auto hull = std::make_shared<const borov_engine::Quickhull>(mesh->Vertices());
+    collisions.emplace_back("ConvexHull", std::make_shared<borov_engine::ConvexHullCollision>(
+                                              std::move(hull), borov_engine::Transform{.position = next_center()}));
+    return collisions;
+}
+
+// Shape whose intersection function does nothing, so testing it costs exactly the dispatch
+class TrivialCollision final : public borov_engine::Collision {
+  public:
+    explicit TrivialCollision(const borov_engine::CollisionShape shape) : Collision{shape} {}
+
+    [[nodiscard]] bool Intersects(const Collision& other) const override {
+        return IntersectsByShape(other);
+    }
+
+    [[nodiscard]] bool Intersects(const math::Ray&, float&) const override {
+        return false;
+    }
+};
+
+void RegisterDispatchBenchmarks(BenchmarkRegistry& registry) {
+    const borov_engine::CollisionShape shape = borov_engine::Collision::RegisterShape();
+    borov_engine::Collision::RegisterIntersection(
+        shape, shape, [](const borov_engine::Collision&, const borov_engine::Collision&) { return true; });
+    const auto lhs = std::make_shared<const TrivialCollision>(shape);
+    const auto rhs = std::make_shared<const TrivialCollision>(shape);
+    registry.Add("dispatch/Trivial", [lhs, rhs](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool intersects = lhs->Intersects(*rhs);
+            DoNotOptimize(intersects);
+        }
+    });
+
+    // Same primitives as the collisions of the same names, called directly to compare with the dispatched tests
+    const math::Sphere sphere{CenterOf(0, 2), 1.0f};
+    const math::Sphere other_sphere{CenterOf(1, 2), 1.0f};
+    registry.Add("direct/Sphere-Sphere", [sphere, other_sphere](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool intersects = sphere.Intersects(other_sphere);
+            DoNotOptimize(intersects);
+        }
+    });
+    const math::Box box{CenterOf(0, 2), math::Vector3{1.0f, 0.5f, 0.5f},
+                        math::Quaternion::CreateFromYawPitchRoll(0.3f, 0.5f, 0.7f)};
+    const math::Box other_box{CenterOf(1, 2), math::Vector3{1.0f, 0.5f, 0.5f},
+                              math::Quaternion::CreateFromYawPitchRoll(0.7f, 0.5f, 0.3f)};
+    registry.Add("direct/Box-Box", [box, other_box](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool intersects = box.Intersects(other_box);
+            DoNotOptimize(intersects);
+        }
+    });
+}
+
+}  // namespace
+
+void RegisterCollisionBenchmarks(BenchmarkRegistry& registry) {
+    const std::vector collisions = Collisions();
+
+    // Every pair once, both orders share the same intersection and distance functions
+    for (std::size_t lhs = 0; lhs < collisions.size(); ++lhs) {
+        for (std::size_t rhs = lhs; rhs < collisions.size(); ++rhs) {
+            const auto& [lhs_name, lhs_collision] = collisions[lhs];
+            const auto& [rhs_name, rhs_collision] = collisions[rhs];
+            registry.Add("collision/" + lhs_name + "-" + rhs_name,
+                         [lhs_collision, rhs_collision](const std::size_t iterations) {
+                             for (std::size_t i = 0; i < iterations; ++i) {
+                                 const bool intersects = lhs_collision->Intersects(*rhs_collision);
+                                 DoNotOptimize(intersects);
+                             }
+                         });
+            registry.Add("distance/" + lhs_name + "-" + rhs_name,
+                         [lhs_collision, rhs_collision](const std::size_t iterations) {
+                             for (std::size_t i = 0; i < iterations; ++i) {
+                                 const float distance = lhs_collision->Distance(*rhs_collision);
+                                 DoNotOptimize(distance);
+                             }
+                         });
+        }
+    }
+
+    // Rays pass through the common center from different directions
+    for (const auto& [name, collision] : collisions) {
+        registry.Add("collision/" + name + "-Ray", [collision](const std::size_t iterations) {
+            const math::Vector3 origin{0.0f, 5.0f, -2.0f};
+            std::array<math::Ray, 16> rays;
+            for (std::size_t i = 0; i < rays.size(); ++i) {
+                rays[i] = math::Ray{origin, math::Normalize(CenterOf(i, rays.size()) - origin)};
+            }
+
+            for (std::size_t i = 0; i < iterations; ++i) {
+                float distance = 0.0f;
+                const bool is_hit = collision->Intersects(rays[i % rays.size()], distance);
+                DoNotOptimize(is_hit);
+                DoNotOptimize(distance);
+            }
+        });
+    }
+
+    RegisterDispatchBenchmarks(registry);
+}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <borov_engine/collision.hpp>
+#include <borov_engine/collision_world.hpp>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+using borov_engine::CollisionWorld;
+using borov_engine::RaycastHit;
+
+// Grid of spheres, boxes and meshes, which is as many collisions as a level has in view
+constexpr std::size_t grid_size = 16;
+constexpr std::size_t grid_layer_count = 4;
+constexpr std::size_t mesh_triangle_count = 256;
+
+// Rays of the image seen by the camera above the grid, so the neighbouring rays go in similar directions
+constexpr std::size_t image_size = 64;
+
+// Holds the collisions too, so they outlive the world which refers to them
+struct CollisionScene {
+    std::vector<std::shared_ptr<borov_engine::Collision>> collisions;
+    CollisionWorld world;
+
+    CollisionScene() {
+        for (std::size_t layer = 0; layer < grid_layer_count; ++layer) {
+            for (std::size_t row = 0; row < grid_size; ++row) {
+                for (std::size_t column = 0; column < grid_size; ++column) {
+                    const math::Vector3 center{
+                        (static_cast<float>(column) - grid_size * 0.5f) * 3.0f,
+                        static_cast<float>(layer) * 3.0f,
+                        (static_cast<float>(row) - grid_size * 0.5f) * 3.0f,
+                    };
+                    switch ((row + column + layer) % 3) {
+                        case 0:
+                            collisions.push_back(
+                                std::make_shared<borov_engine::SphereCollision>(math::Sphere{center, 1.0f}));
+                            break;
+                        case 1:
+                            collisions.push_back(std::make_shared<borov_engine::BoxCollision>(math::Box{
+                                center,
+                                math::Vector3{1.0f, 0.5f, 0.75f},
+                                math::Quaternion::CreateFromYawPitchRoll(0.3f, 0.5f, 0.7f),
+                            }));
+                            break;
+                        default:
+                            collisions.push_back(SphereMesh(mesh_triangle_count, center, 1.0f));
+                            break;
+                    }
+                }
+            }
+        }
+
+        for (const auto& collision : collisions) {
+            world.Add(*collision);
+        }
+        world.Update();
+    }
+};
+
+std::vector<math::Ray> ImageRays() {
+    const math::Vector3 origin{0.0f, 30.0f, -40.0f};
+    const math::Vector3 forward = math::Normalize(math::Vector3{0.0f, 4.5f, 0.0f} - origin);
+    const math::Vector3 right = math::Normalize(math::Vector3::Up.Cross(forward));
+    const math::Vector3 up = forward.Cross(right);
+
+    std::vector<math::Ray> rays;
+    rays.reserve(image_size * image_size);
+    for (std::size_t y = 0; y < image_size; ++y) {
+        for (std::size_t x = 0; x < image_size; ++x) {
+            const float u = (static_cast<float>(x) + 0.5f) / image_size * 2.0f - 1.0f;
+            const float v = (static_cast<float>(y) + 0.5f) / image_size * 2.0f - 1.0f;
+            rays.emplace_back(origin, math::Normalize(forward + right * (u * 0.6f) + up * (v * 0.6f)));
+        }
+    }
+    return rays;
+}
+
+}  // namespace
+
+void RegisterCollisionWorldBenchmarks(BenchmarkRegistry& registry) {
+    const auto scene = std::make_shared<const CollisionScene>();
+    const auto rays = std::make_shared<const std::vector<math::Ray>>(ImageRays());
+
+    // Measured per ray, so operations per second are rays per second
+    registry.Add("world/Raycast", [scene, rays](const std::size_t iterations) {
+        std::vector<RaycastHit> hits(rays->size());
+        for (std::size_t i = 0; i < iterations; i += rays->size()) {
+            const std::size_t count = (std::min)(rays->size(), iterations - i);
+            scene->world.Raycast(std::span{*rays}.first(count), std::span{hits}.first(count));
+            DoNotOptimize(hits.front());
+        }
+    });
+    // Same rays one at a time, which is what the packets are measured against
+    registry.Add("world/RaycastSingle", [scene, rays](const std::size_t iterations) {
+        RaycastHit hit{};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            scene->world.Raycast(std::span{*rays}.subspan(i % rays->size(), 1), std::span{&hit, 1});
+            DoNotOptimize(hit);
+        }
+    });
+}
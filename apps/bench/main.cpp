@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+struct Options {
+    std::string filter;
+    std::chrono::milliseconds min_time{100};
+    std::size_t repetition_count = 5;
+    std::optional<std::filesystem::path> baseline_path;
+    std::optional<std::filesystem::path> save_baseline_path;
+    // Slowdown against the baseline in percents which fails the run
+    std::optional<double> max_regression;
+};
+
+void PrintUsage(const std::string_view program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter <text>            run only the benchmarks whose names contain the text\n"
+              << "  --min-time <ms>            min time of one repetition, 100 by default\n"
+              << "  --repetitions <count>      repetitions of which the fastest is kept, 5 by default\n"
+              << "  --baseline <file>          compare the results with the stored baseline\n"
+              << "  --save-baseline <file>     store the results as the baseline\n"
+              << "  --max-regression <percent> fail if any benchmark is slower than the baseline by more\n";
+}
+
+std::optional<Options> ParseOptions(const int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument == "--help") {
+            return std::nullopt;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument{"Missing value of " + std::string{argument}};
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--filter") {
+            options.filter = value;
+        } else if (argument == "--min-time") {
+            options.min_time = std::chrono::milliseconds{std::stoll(value)};
+        } else if (argument == "--repetitions") {
+            options.repetition_count = std::stoull(value);
+        } else if (argument == "--baseline") {
+            options.baseline_path = value;
+        } else if (argument == "--save-baseline") {
+            options.save_baseline_path = value;
+        } else if (argument == "--max-regression") {
+            options.max_regression = std::stod(value);
+        } else {
+            throw std::invalid_argument{"Unknown option " + std::string{argument}};
+        }
+    }
+    return options;
+}
+
+// Returns false if any benchmark regressed by more than allowed
+bool PrintResults(const std::vector<BenchmarkResult>& results, const Baseline* baseline,
+                  const std::optional<double> max_regression) {
+    std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "ns/op" << std::setw(16)
+              << "ops/sec";
+    if (baseline != nullptr) {
+        std::cout << std::setw(14) << "baseline" << std::setw(10) << "change";
+    }
+    std::cout << '\n';
+
+    bool is_passed = true;
+    std::cout << std::fixed;
+    for (const auto& [name, nanoseconds_per_operation, operations_per_second] : results) {
+        std::cout << std::left << std::setw(48) << name << std::right << std::setprecision(2) << std::setw(14)
+                  << nanoseconds_per_operation << std::setprecision(0) << std::setw(16) << operations_per_second;
+
+        if (baseline != nullptr) {
+            if (const auto it = baseline->find(name); it != baseline->end()) {
+                // Positive change is slower than the baseline
+                const double change = (nanoseconds_per_operation / it->second - 1.0) * 100.0;
+                std::cout << std::setprecision(2) << std::setw(14) << it->second << std::showpos << std::setw(9)
+                          << change << '%' << std::noshowpos;
+                if (max_regression && change > *max_regression) {
+                    std::cout << "  REGRESSION";
+                    is_passed = false;
+                }
+            } else {
+                std::cout << std::setw(14) << "-" << std::setw(10) << "new";
+            }
+        }
+        std::cout << '\n';
+    }
+    return is_passed;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const std::optional<Options> options = ParseOptions(argc, argv);
+        if (!options) {
+            PrintUsage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+
+        BenchmarkRegistry registry;
+        RegisterBroadPhaseBenchmarks(registry);
+        RegisterCollisionBenchmarks(registry);
+        RegisterCollisionWorldBenchmarks(registry);
+        RegisterMeshBenchmarks(registry);
+        RegisterTransformBenchmarks(registry);
+        RegisterTriangleBenchmarks(registry);
+
+        const std::vector results = registry.Run(options->filter, options->min_time, options->repetition_count);
+
+        std::optional<Baseline> baseline;
+        if (options->baseline_path) {
+            baseline = LoadBaseline(*options->baseline_path);
+        }
+        const bool is_passed = PrintResults(results, baseline ? &*baseline : nullptr, options->max_regression);
+
+        if (options->save_baseline_path) {
+            SaveBaseline(*options->save_baseline_path, results);
+        }
+        return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << '\n';
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <array>
+#include <borov_engine/collision.hpp>
+#include <borov_engine/ray_packet.hpp>
+#include <borov_engine/triangle_bvh.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+using borov_engine::MeshCollision;
+
+// Small meshes fit into the cache, the largest one is as big as a detailed level
+constexpr std::array triangle_counts{std::size_t{1024}, std::size_t{16384}, std::size_t{131072}};
+
+constexpr std::size_t query_count = 1024;
+
+math::Vector3 RandomDirection(std::mt19937& generator) {
+    std::normal_distribution<float> distribution;
+    return math::Normalize(math::Vector3{distribution(generator), distribution(generator), distribution(generator)});
+}
+
+// Rays start outside of the unit sphere and point near its center, so most of them hit
+std::vector<math::Ray> RandomRays() {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> offset{-0.5f, 0.5f};
+
+    std::vector<math::Ray> rays(query_count);
+    for (math::Ray& ray : rays) {
+        const math::Vector3 origin = RandomDirection(generator) * 3.0f;
+        const math::Vector3 target{offset(generator), offset(generator), offset(generator)};
+        ray = math::Ray{origin, math::Normalize(target - origin)};
+    }
+    return rays;
+}
+
+// Small shapes near the surface of the unit sphere, which are the hardest for the hierarchy
+std::vector<math::Vector3> RandomCenters() {
+    std::mt19937 generator{7};
+    std::uniform_real_distribution<float> radius{0.8f, 1.2f};
+
+    std::vector<math::Vector3> centers(query_count);
+    for (math::Vector3& center : centers) {
+        center = RandomDirection(generator) * radius(generator);
+    }
+    return centers;
+}
+
+void RegisterMeshSizeBenchmarks(BenchmarkRegistry& registry, const std::size_t triangle_count) {
+    const std::shared_ptr<const MeshCollision> mesh = SphereMesh(triangle_count, math::Vector3::Zero, 1.0f);
+    const auto rays = std::make_shared<const std::vector<math::Ray>>(RandomRays());
+    const auto centers = std::make_shared<const std::vector<math::Vector3>>(RandomCenters());
+    const std::string prefix = "mesh/" + std::to_string(triangle_count) + "/";
+
+    registry.Add(prefix + "ClosestHit", [=](const std::size_t iterations) {
+        MeshCollision::RayHit hit{};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool is_hit = mesh->ClosestHit((*rays)[i % query_count], hit);
+            DoNotOptimize(is_hit);
+            DoNotOptimize(hit);
+        }
+    });
+    registry.Add(prefix + "AnyHit", [=](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool is_hit = mesh->AnyHit((*rays)[i % query_count], 10.0f);
+            DoNotOptimize(is_hit);
+        }
+    });
+
+    // Measured per ray, so it compares directly with the single closest hit
+    registry.Add(prefix + "ClosestHits", [=](const std::size_t iterations) {
+        constexpr std::size_t width = borov_engine::RayPacket::width;
+        std::array<MeshCollision::RayHit, width> hits;
+        for (std::size_t i = 0; i < iterations; i += width) {
+            const std::size_t first = i % query_count;
+            const std::size_t count = (std::min)({width, iterations - i, query_count - first});
+            const borov_engine::RayPacket packet{std::span{*rays}.subspan(first, count)};
+            for (MeshCollision::RayHit& hit : hits) {
+                hit.distance = std::numeric_limits<float>::infinity();
+            }
+            const std::uint32_t mask = mesh->ClosestHits(packet, hits);
+            DoNotOptimize(mask);
+            DoNotOptimize(hits);
+        }
+    });
+
+    registry.Add(prefix + "Sphere", [=](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const borov_engine::SphereCollision sphere{math::Sphere{(*centers)[i % query_count], 0.05f}};
+            const bool intersects = mesh->Intersects(sphere);
+            DoNotOptimize(intersects);
+        }
+    });
+
+    // Same queries with the leaves tested one triangle at a time, which the packets of the leaves are measured against
+    registry.Add(prefix + "ClosestHitTriangles", [=](const std::size_t iterations) {
+        const borov_engine::TriangleBvh& hierarchy = mesh->Hierarchy();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const math::Ray& ray = (*rays)[i % query_count];
+            const float distance = hierarchy.MinOf(
+                [&](const math::AxisAlignedBox& bounds) {
+                    float entry = 0.0f;
+                    return ray.Intersects(bounds, entry) ? entry : std::numeric_limits<float>::infinity();
+                },
+                [&](const math::Triangle& triangle) {
+                    float hit_distance = 0.0f;
+                    return triangle.Intersects(ray, hit_distance) ? hit_distance
+                                                                  : std::numeric_limits<float>::infinity();
+                });
+            DoNotOptimize(distance);
+        }
+    });
+    registry.Add(prefix + "SphereTriangles", [=](const std::size_t iterations) {
+        const borov_engine::TriangleBvh& hierarchy = mesh->Hierarchy();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const math::Sphere sphere{(*centers)[i % query_count], 0.05f};
+            const bool intersects =
+                hierarchy.AnyOf([&](const math::AxisAlignedBox& bounds) { return bounds.Intersects(sphere); },
+                                [&](const math::Triangle& triangle) { return triangle.Intersects(sphere); });
+            DoNotOptimize(intersects);
+        }
+    });
+    registry.Add(prefix + "Box", [=](const std::size_t iterations) {
+        const math::Quaternion rotation = math::Quaternion::CreateFromYawPitchRoll(0.3f, 0.5f, 0.7f);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const math::Box primitive{(*centers)[i % query_count], math::Vector3{0.05f}, rotation};
+            const borov_engine::BoxCollision box{primitive};
+            const bool intersects = mesh->Intersects(box);
+            DoNotOptimize(intersects);
+        }
+    });
+
+    registry.Add(prefix + "ClosestPoint", [=](const std::size_t iterations) {
+        MeshCollision::PointHit hit{};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const bool is_hit = mesh->ClosestPoint((*centers)[i % query_count], hit);
+            DoNotOptimize(is_hit);
+            DoNotOptimize(hit);
+        }
+    });
+
+    // Hierarchy maintenance is measured per triangle, so the meshes of different sizes compare directly
+    registry.Add(prefix + "Build", [=](const std::size_t iterations) {
+        const std::size_t build_count = (iterations + triangle_count - 1) / triangle_count;
+        for (std::size_t i = 0; i < build_count; ++i) {
+            const borov_engine::TriangleBvh hierarchy{mesh->Vertices(), mesh->Indices()};
+            DoNotOptimize(hierarchy);
+        }
+    });
+    const auto hierarchy = std::make_shared<borov_engine::TriangleBvh>(mesh->Vertices(), mesh->Indices());
+    registry.Add(prefix + "Refit", [=](const std::size_t iterations) {
+        const std::size_t refit_count = (iterations + triangle_count - 1) / triangle_count;
+        for (std::size_t i = 0; i < refit_count; ++i) {
+            hierarchy->Refit(mesh->Vertices(), mesh->Indices());
+            DoNotOptimize(*hierarchy);
+        }
+    });
+}
+
+}  // namespace
+
+void RegisterMeshBenchmarks(BenchmarkRegistry& registry) {
+    for (const std::size_t triangle_count : triangle_counts) {
+        RegisterMeshSizeBenchmarks(registry, triangle_count);
+    }
+}
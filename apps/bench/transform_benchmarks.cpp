@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <array>
+#include <borov_engine/thread_pool.hpp>
+#include <borov_engine/transform.hpp>
+#include <borov_engine/transform_system.hpp>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+using borov_engine::ThreadPool;
+using borov_engine::Transform;
+using borov_engine::TransformSystem;
+
+// Enough transforms to leave the cache warm, but not so few that the compiler sees through the loop
+constexpr std::size_t transform_count = 1024;
+
+std::vector<Transform> RandomTransforms() {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> position{-10.0f, 10.0f};
+    std::uniform_real_distribution<float> angle{-3.14f, 3.14f};
+    std::uniform_real_distribution<float> scale{0.5f, 2.0f};
+
+    std::vector<Transform> transforms(transform_count);
+    for (Transform& transform : transforms) {
+        transform.position = math::Vector3{position(generator), position(generator), position(generator)};
+        transform.rotation =
+            math::Quaternion::CreateFromYawPitchRoll(angle(generator), angle(generator), angle(generator));
+        transform.scale = math::Vector3{scale(generator), scale(generator), scale(generator)};
+    }
+    return transforms;
+}
+
+// Every node of the hierarchy is animated. The smaller one is a typical scene which fits into the cache,
+// the larger one is the target size of a scene
+constexpr std::array node_counts{std::size_t{10000}, std::size_t{100000}};
+
+// Wide and shallow tree like in a typical scene, where every node has up to eight children.
+// Holds the thread pool too, so it outlives the transform system which refers to it
+struct TransformHierarchy {
+    std::shared_ptr<ThreadPool> thread_pool;
+    TransformSystem system;
+    std::vector<TransformSystem::Handle> handles;
+
+    TransformHierarchy(std::shared_ptr<ThreadPool> pool, const std::size_t node_count,
+                       const TransformSystem::UpdateMode mode)
+        : thread_pool{std::move(pool)}, system{thread_pool.get()} {
+        system.Mode() = mode;
+        const std::vector transforms = RandomTransforms();
+        handles.reserve(node_count);
+        for (std::size_t node = 0; node < node_count; ++node) {
+            const TransformSystem::Handle parent =
+                (node > 0) ? handles[(node - 1) / 8] : TransformSystem::invalid_handle;
+            handles.push_back(system.Add(transforms[node % transform_count], parent));
+        }
+        system.Update();
+    }
+};
+
+// How world transforms were found before the transform system: every node concatenates the local transforms
+// of all its ancestors up to the root again, nothing is shared between siblings
+Transform RecursiveWorldTransform(const std::span<const Transform> locals, const std::span<const std::size_t> parents,
+                                  const std::size_t node) {
+    if (node == 0) {
+        return locals[node];
+    }
+    return Transform::Concatenate(RecursiveWorldTransform(locals, parents, parents[node]), locals[node]);
+}
+
+void RegisterTransformSystemBenchmarks(BenchmarkRegistry& registry, const std::shared_ptr<ThreadPool>& thread_pool,
+                                       const std::size_t node_count) {
+    const std::string prefix = "transform/System/" + std::to_string(node_count) + "/";
+    const std::array modes{
+        std::pair{TransformSystem::UpdateMode::Sequential, std::string{"Update"}},
+        std::pair{TransformSystem::UpdateMode::Parallel, std::string{"UpdateParallel"}},
+    };
+
+    // Measured per node, every update rotates all the nodes, so the whole hierarchy is recomputed
+    for (const auto& [mode, name] : modes) {
+        const auto hierarchy = std::make_shared<TransformHierarchy>(thread_pool, node_count, mode);
+        registry.Add(prefix + name, [hierarchy, node_count](const std::size_t iterations) {
+            TransformSystem& system = hierarchy->system;
+            const std::size_t update_count = (iterations + node_count - 1) / node_count;
+            for (std::size_t i = 0; i < update_count; ++i) {
+                const math::Quaternion rotation =
+                    math::Quaternion::CreateFromAxisAngle(math::Vector3::Up, 0.01f * static_cast<float>(i));
+                for (const TransformSystem::Handle handle : hierarchy->handles) {
+                    system.LocalTransform(handle).rotation = rotation;
+                    system.MarkWorldTransformDirty(handle);
+                }
+                system.Update();
+                DoNotOptimize(system.WorldMatrix(hierarchy->handles.back()));
+            }
+        });
+    }
+
+    // Same tree and the same work per update, walked to the root by every node like the scene components did
+    const std::vector transforms = RandomTransforms();
+    const auto locals = std::make_shared<std::vector<Transform>>(node_count);
+    const auto parents = std::make_shared<std::vector<std::size_t>>(node_count);
+    for (std::size_t node = 0; node < node_count; ++node) {
+        (*locals)[node] = transforms[node % transform_count];
+        (*parents)[node] = (node > 0) ? (node - 1) / 8 : 0;
+    }
+    registry.Add(prefix + "RecursiveWalk", [locals, parents, node_count](const std::size_t iterations) {
+        const std::size_t update_count = (iterations + node_count - 1) / node_count;
+        for (std::size_t i = 0; i < update_count; ++i) {
+            const math::Quaternion rotation =
+                math::Quaternion::CreateFromAxisAngle(math::Vector3::Up, 0.01f * static_cast<float>(i));
+            for (Transform& local : *locals) {
+                local.rotation = rotation;
+            }
+            for (std::size_t node = 0; node < node_count; ++node) {
+                DoNotOptimize(RecursiveWorldTransform(*locals, *parents, node).ToMatrix());
+            }
+        }
+    });
+}
+
+}  // namespace
+
+void RegisterTransformBenchmarks(BenchmarkRegistry& registry) {
+    const auto parents = std::make_shared<const std::vector<Transform>>(RandomTransforms());
+    const auto children = std::make_shared<const std::vector<Transform>>(RandomTransforms());
+
+    registry.Add("transform/Concatenate", [=](const std::size_t iterations) {
+        Transform result;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const std::size_t index = i % transform_count;
+            Transform::Concatenate((*parents)[index], (*children)[index], result);
+            DoNotOptimize(result);
+        }
+    });
+    registry.Add("transform/Inverse", [=](const std::size_t iterations) {
+        Transform result;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Transform::Inverse((*parents)[i % transform_count], result);
+            DoNotOptimize(result);
+        }
+    });
+    registry.Add("transform/ToMatrix", [=](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const math::Matrix4x4 matrix = (*parents)[i % transform_count].ToMatrix();
+            DoNotOptimize(matrix);
+        }
+    });
+
+    // Batches are measured per transform, so they compare directly with the single versions
+    registry.Add("transform/ConcatenateBatch", [=](const std::size_t iterations) {
+        std::vector<Transform> results(transform_count);
+        for (std::size_t i = 0; i < iterations; i += transform_count) {
+            const std::size_t count = (std::min)(transform_count, iterations - i);
+            Transform::ConcatenateBatch(std::span{*parents}.first(count), std::span{*children}.first(count),
+                                        std::span{results}.first(count));
+            DoNotOptimize(results.front());
+        }
+    });
+    registry.Add("transform/InverseBatch", [=](const std::size_t iterations) {
+        std::vector<Transform> results(transform_count);
+        for (std::size_t i = 0; i < iterations; i += transform_count) {
+            const std::size_t count = (std::min)(transform_count, iterations - i);
+            Transform::InverseBatch(std::span{*parents}.first(count), std::span{results}.first(count));
+            DoNotOptimize(results.front());
+        }
+    });
+    registry.Add("transform/ToMatrixBatch", [=](const std::size_t iterations) {
+        std::vector<math::Matrix4x4> matrices(transform_count);
+        for (std::size_t i = 0; i < iterations; i += transform_count) {
+            const std::size_t count = (std::min)(transform_count, iterations - i);
+            Transform::ToMatrixBatch(std::span{*parents}.first(count), std::span{matrices}.first(count));
+            DoNotOptimize(matrices.front());
+        }
+    });
+
+    // Same transforms as separate arrays, which is how the transform system stores them
+    const auto positions = std::make_shared<std::vector<math::Vector3>>();
+    const auto rotations = std::make_shared<std::vector<math::Quaternion>>();
+    const auto scales = std::make_shared<std::vector<math::Vector3>>();
+    for (const Transform& transform : *parents) {
+        positions->push_back(transform.position);
+        rotations->push_back(transform.rotation);
+        scales->push_back(transform.scale);
+    }
+    registry.Add("transform/ToMatrixBatchSoA", [=](const std::size_t iterations) {
+        const borov_engine::ConstTransformSpan transforms{
+            .positions = *positions,
+            .rotations = *rotations,
+            .scales = *scales,
+        };
+        std::vector<math::Matrix4x4> matrices(transform_count);
+        for (std::size_t i = 0; i < iterations; i += transform_count) {
+            const std::size_t count = (std::min)(transform_count, iterations - i);
+            Transform::ToMatrixBatch(transforms.Subspan(0, count), std::span{matrices}.first(count));
+            DoNotOptimize(matrices.front());
+        }
+    });
+
+    const auto thread_pool = std::make_shared<ThreadPool>();
+    for (const std::size_t node_count : node_counts) {
+        RegisterTransformSystemBenchmarks(registry, thread_pool, node_count);
+    }
+}
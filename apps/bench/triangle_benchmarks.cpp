@@ -0,0 +1,79 @@
+#include <borov_engine/math.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace {
+
+namespace math = borov_engine::math;
+
+// Scattered around the primitives, so that both hits and misses are measured
+constexpr std::size_t triangle_count = 1024;
+
+std::vector<math::Triangle> RandomTriangles() {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> center{-3.0f, 3.0f};
+    std::uniform_real_distribution<float> offset{-1.0f, 1.0f};
+
+    std::vector<math::Triangle> triangles(triangle_count);
+    for (math::Triangle& triangle : triangles) {
+        const math::Vector3 point{center(generator), center(generator), center(generator)};
+        const auto random_offset = [&] { return math::Vector3{offset(generator), offset(generator), offset(generator)}; };
+        triangle = math::Triangle{
+            .point0 = point + random_offset(),
+            .point1 = point + random_offset(),
+            .point2 = point + random_offset(),
+        };
+    }
+    return triangles;
+}
+
+template <typename T>
+BenchmarkFunction TriangleTest(std::shared_ptr<const std::vector<math::Triangle>> triangles, const T& primitive) {
+    return [triangles = std::move(triangles), primitive](const std::size_t iterations) {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const auto result = (*triangles)[i % triangle_count].Intersects(primitive);
+            DoNotOptimize(result);
+        }
+    };
+}
+
+}  // namespace
+
+void RegisterTriangleBenchmarks(BenchmarkRegistry& registry) {
+    const auto triangles = std::make_shared<const std::vector<math::Triangle>>(RandomTriangles());
+
+    const math::AxisAlignedBox axis_aligned_box{math::Vector3::Zero, math::Vector3{1.0f}};
+    const math::Box box{
+        math::Vector3::Zero,
+        math::Vector3{1.5f, 0.5f, 1.0f},
+        math::Quaternion::CreateFromYawPitchRoll(0.3f, 0.5f, 0.7f),
+    };
+    const math::Sphere sphere{math::Vector3::Zero, 1.5f};
+    const math::Frustum frustum{math::Matrix4x4::CreatePerspectiveFieldOfView(1.0f, 1.0f, 0.1f, 5.0f), true};
+    const math::Plane plane{math::Vector3::Zero, math::Normalize(math::Vector3{1.0f, 2.0f, 3.0f})};
+    const math::Triangle triangle{
+        .point0 = math::Vector3{-2.0f, -1.0f, 0.0f},
+        .point1 = math::Vector3{2.0f, -1.0f, 0.5f},
+        .point2 = math::Vector3{0.0f, 2.0f, -0.5f},
+    };
+
+    registry.Add("triangle/AxisAlignedBox", TriangleTest(triangles, axis_aligned_box));
+    registry.Add("triangle/Box", TriangleTest(triangles, box));
+    registry.Add("triangle/Sphere", TriangleTest(triangles, sphere));
+    registry.Add("triangle/Frustum", TriangleTest(triangles, frustum));
+    registry.Add("triangle/Plane", TriangleTest(triangles, plane));
+    registry.Add("triangle/Triangle", TriangleTest(triangles, triangle));
+
+    registry.Add("triangle/Ray", [triangles](const std::size_t iterations) {
+        const math::Ray ray{math::Vector3{0.0f, 0.0f, -5.0f}, math::Vector3::UnitZ};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            float distance = 0.0f;
+            const bool is_hit = (*triangles)[i % triangle_count].Intersects(ray, distance);
+            DoNotOptimize(is_hit);
+            DoNotOptimize(distance);
+        }
+    });
+}
@@ -45,3 +45,7 @@ void SquareComponent::Update(const float delta_time) {
         position.x -= 3.0f;
     }
 }
+
+bool SquareComponent::IsUpdateParallelSafe() const {
+    return true;
+}
@@ -10,6 +10,9 @@ class SquareComponent final : public borov_engine::TriangleComponent {
     explicit SquareComponent(borov_engine::Game &game);
 
     void Update(float delta_time) override;
+
+    // Moves nothing but itself and has no children
+    [[nodiscard]] bool IsUpdateParallelSafe() const override;
 };
 
 #endif  // EXAMPLE_SQUARE_COMPONENT_HPP_INCLUDED
@@ -2,6 +2,7 @@
 
 #include <borov_engine/camera.hpp>
 #include <borov_engine/orbit_camera_manager.hpp>
+#include <borov_engine/sweep_and_prune_broad_phase.hpp>
 
 #include "viewport_manager.hpp"
 
@@ -86,6 +87,16 @@ Game::Game(borov_engine::Window &window, borov_engine::Input &input)
         .zoom_speed = 10.0f,
     });
     ViewportManager<::ViewportManager>();
+    // Objects are spread over the field and mostly stay in place, so the sorted endpoints barely change
+    CollisionWorld().BroadPhase<borov_engine::SweepAndPruneBroadPhase>();
+    CollisionWorld().OnBeginOverlap().AddRaw(this, &Game::OnBeginOverlap);
+
+    // Objects only stick to the player, so the rest of the pairs are never tested
+    player_.get().Layer(player_layer);
+    field_.get().Layer(field_layer);
+    CollisionWorld().LayerMask(field_layer, 0);
+    CollisionWorld().LayerMask(borov_engine::Collision::default_layer,
+                               borov_engine::CollisionLayerMask{1} << player_layer);
 
     namespace math = borov_engine::math;
 
@@ -117,6 +128,8 @@ Game::Game(borov_engine::Window &window, borov_engine::Input &input)
 }
 
 void Game::Update(const float delta_time) {
+    // Picked before anything moves, so the collision world is still the one refreshed by the last update
+    Pick(delta_time);
     borov_engine::Game::Update(delta_time);
 
     namespace math = borov_engine::math;
@@ -152,59 +165,43 @@ void Game::Update(const float delta_time) {
         player_transform.rotation = math::Quaternion::Concatenate(additional, player_transform.rotation);
     }
     player_.get().WorldTransform(player_transform);
+}
 
-    // ReSharper disable once CppTooWideScopeInitStatement
-    auto is_scene_and_collision = [](const borov_engine::Component &component) {
-        return dynamic_cast<const borov_engine::SceneComponent *>(&component) != nullptr &&
-               dynamic_cast<const borov_engine::Collision *>(&component) != nullptr;
-    };
-    for (borov_engine::Component &component : Components() | std::views::filter(is_scene_and_collision)) {
-        if (&component == &player_.get() || &component == &field_.get()) {
-            continue;
-        }
-
-        auto &scene_component = dynamic_cast<borov_engine::SceneComponent &>(component);
-        auto &collision_primitive = dynamic_cast<const borov_engine::Collision &>(component);
-
-        if (collision_primitive.Intersects(player_)) {
-            scene_component.Parent(&player_.get());
-        }
-    }
+void Game::Pick(const float delta_time) {
+    namespace math = borov_engine::math;
 
+    const borov_engine::Input *input = Input();
     const borov_engine::Window *window = Window();
-    if (window != nullptr && input->IsKeyDown(borov_engine::InputKey::LeftButton)) {
-        const math::Vector3 world_cursor_position = ScreenToWorld(window->CursorPosition());
-        if (std::isnan(world_cursor_position.LengthSquared())) {
-            return;
-        }
-        const math::Vector3 ray_position = camera_.get().WorldTransform().position;
-        const math::Vector3 ray_direction = math::Normalize(world_cursor_position - ray_position);
-        const math::Ray ray{ray_position, ray_direction};
-
-        const borov_engine::Collision *target = nullptr;
-        float nearest_distance = std::numeric_limits<float>::infinity();
-
-        auto is_collision = [](const borov_engine::Component &component) {
-            return dynamic_cast<const borov_engine::Collision *>(&component) != nullptr;
-        };
-        for (borov_engine::Component &component : Components() | std::views::filter(is_collision)) {
-            auto &collision = dynamic_cast<const borov_engine::Collision &>(component);
-            if (float distance = 100.0f; collision.Intersects(ray, distance)) {
-                if (target == nullptr || distance < nearest_distance) {
-                    target = &collision;
-                    nearest_distance = distance;
-                }
-            }
-        }
-
-        if (target != nullptr) {
-            const math::Vector3 hit_position = ray_position + ray_direction * nearest_distance;
-            const math::Vector3 light_direction = math::Normalize(hit_position - SpotLight().WorldTransform().position);
-            SpotLight().Direction(light_direction);
-
-            const borov_engine::Transform debug_transform{.position = hit_position};
-            DebugDraw().DrawPivot(debug_transform, {.duration = delta_time});
-        }
+    if (input == nullptr || window == nullptr || !input->IsKeyDown(borov_engine::InputKey::LeftButton)) {
+        return;
+    }
+
+    const math::Vector3 world_cursor_position = ScreenToWorld(window->CursorPosition());
+    if (std::isnan(world_cursor_position.LengthSquared())) {
+        return;
+    }
+    const math::Vector3 ray_position = camera_.get().WorldTransform().position;
+    const math::Vector3 ray_direction = math::Normalize(world_cursor_position - ray_position);
+    const math::Ray ray{ray_position, ray_direction};
+
+    borov_engine::RaycastHit hit;
+    CollisionWorld().Raycast(std::span{&ray, 1}, std::span{&hit, 1});
+
+    if (hit.collision != nullptr) {
+        const math::Vector3 hit_position = ray_position + ray_direction * hit.distance;
+        const math::Vector3 light_direction = math::Normalize(hit_position - SpotLight().WorldTransform().position);
+        SpotLight().Direction(light_direction);
+
+        const borov_engine::Transform debug_transform{.position = hit_position};
+        DebugDraw().DrawPivot(debug_transform, {.duration = delta_time});
+    }
+}
+
+void Game::OnBeginOverlap(const borov_engine::CollisionPair &pair) {
+    // Layers leave only the pairs of the player and some object, which sticks to the player as soon as they touch
+    borov_engine::Collision *object = (pair.first == &player_.get()) ? pair.second : pair.first;
+    if (auto *scene_component = dynamic_cast<borov_engine::SceneComponent *>(object); scene_component != nullptr) {
+        scene_component->Parent(&player_.get());
     }
 }
 
@@ -28,6 +28,14 @@ class Game final : public borov_engine::Game {
     void Draw(const borov_engine::Camera *camera) override;
 
   private:
+    // Objects stay on the default layer
+    static constexpr borov_engine::CollisionLayer player_layer = 1;
+    static constexpr borov_engine::CollisionLayer field_layer = 2;
+
+    // Points the spot light at the surface under the cursor while the left button is down
+    void Pick(float delta_time);
+    void OnBeginOverlap(const borov_engine::CollisionPair &pair);
+
     std::reference_wrapper<borov_engine::Camera> camera_;
     std::reference_wrapper<Field> field_;
     std::reference_wrapper<Player> player_;
@@ -35,12 +35,24 @@ bool Apricot::Intersects(const borov_engine::math::Ray& ray, float& dist) const
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Apricot::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Apricot::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Apricot::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Apricot::CollisionPrimitive() const {
     borov_engine::math::Sphere sphere{
         borov_engine::math::Vector3{0.0f, 0.1375f, 0.0f},
         0.1f,
     };
-    sphere.Transform(sphere, WorldTransform().ToMatrix());
+    sphere.Transform(sphere, WorldMatrix());
 
     return borov_engine::SphereCollision{sphere};
 }
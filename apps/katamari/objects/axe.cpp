@@ -6,6 +6,7 @@ Axe::Axe(borov_engine::Game& game, const Initializer& initializer)
           Game().AddComponent<MeshType>([this] {
               MeshType::Initializer mesh_initializer{
                   .mesh_path = "resources/meshes/axe/axe.fbx",
+                  .proxy_options = borov_engine::CollisionProxyOptions{},
               };
               mesh_initializer.transform = {.scale = borov_engine::math::Vector3::One / 50.0f};
               mesh_initializer.parent = this;
@@ -35,13 +36,23 @@ bool Axe::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Axe::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Axe::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Axe::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::BoxCollision Axe::CollisionPrimitive() const {
-    borov_engine::math::Box box{
-        borov_engine::math::Vector3{0.01f, 0.03f, -0.08f},
-        borov_engine::math::Vector3{0.55f, 0.02f, 0.04f},
-        borov_engine::math::Quaternion::Identity,
-    };
-    box.Transform(box, WorldTransform().ToMatrix());
+    const MeshType& mesh = Mesh();
+
+    borov_engine::math::Box box;
+    mesh.Proxy().Box().Transform(box, mesh.WorldMatrix());
 
     return borov_engine::BoxCollision{box};
 }
@@ -35,13 +35,25 @@ bool Boat::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Boat::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Boat::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Boat::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::BoxCollision Boat::CollisionPrimitive() const {
     borov_engine::math::Box box{
         borov_engine::math::Vector3{0.0f, 0.1f, 0.0f},
         borov_engine::math::Vector3{0.25f, 0.1f, 1.0f},
         borov_engine::math::Quaternion::Identity,
     };
-    box.Transform(box, WorldTransform().ToMatrix());
+    box.Transform(box, WorldMatrix());
 
     return borov_engine::BoxCollision{box};
 }
@@ -35,13 +35,25 @@ bool Bulb::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Bulb::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Bulb::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Bulb::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::BoxCollision Bulb::CollisionPrimitive() const {
     borov_engine::math::Box box{
         borov_engine::math::Vector3{0.0f, 0.125f, 0.0f},
         borov_engine::math::Vector3{0.025f, 0.125f, 0.025f},
         borov_engine::math::Quaternion::Identity,
     };
-    box.Transform(box, WorldTransform().ToMatrix());
+    box.Transform(box, WorldMatrix());
 
     return borov_engine::BoxCollision{box};
 }
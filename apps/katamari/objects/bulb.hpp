@@ -19,6 +19,9 @@ class Bulb final : public borov_engine::SceneComponent, public borov_engine::Col
 
     [[nodiscard]] bool Intersects(const Collision& other) const override;
     [[nodiscard]] bool Intersects(const borov_engine::math::Ray& ray, float& dist) const override;
+    [[nodiscard]] float Distance(const Collision& other) const override;
+    [[nodiscard]] borov_engine::math::Vector3 ClosestPoint(const borov_engine::math::Vector3& point) const override;
+    [[nodiscard]] borov_engine::math::AxisAlignedBox Bounds() const override;
 
   private:
     [[nodiscard]] borov_engine::BoxCollision CollisionPrimitive() const;
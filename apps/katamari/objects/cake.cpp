@@ -35,13 +35,25 @@ bool Cake::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Cake::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Cake::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Cake::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::BoxCollision Cake::CollisionPrimitive() const {
     borov_engine::math::Box box{
         borov_engine::math::Vector3{0.0f, 0.1f, 0.0f},
         borov_engine::math::Vector3{0.35f, 0.1f, 0.35f},
         borov_engine::math::Quaternion::Identity,
     };
-    box.Transform(box, WorldTransform().ToMatrix());
+    box.Transform(box, WorldMatrix());
 
     return borov_engine::BoxCollision{box};
 }
@@ -35,13 +35,25 @@ bool ConcreteBarricade::Intersects(const borov_engine::math::Ray& ray, float& di
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float ConcreteBarricade::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 ConcreteBarricade::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox ConcreteBarricade::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::BoxCollision ConcreteBarricade::CollisionPrimitive() const {
     borov_engine::math::Box box{
         borov_engine::math::Vector3{0.0f, 0.5f, -0.34f},
         borov_engine::math::Vector3{0.1f, 0.5f, 0.85f},
         borov_engine::math::Quaternion::Identity,
     };
-    box.Transform(box, WorldTransform().ToMatrix());
+    box.Transform(box, WorldMatrix());
 
     return borov_engine::BoxCollision{box};
 }
@@ -35,12 +35,24 @@ bool Strawberry::Intersects(const borov_engine::math::Ray& ray, float& dist) con
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Strawberry::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Strawberry::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Strawberry::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Strawberry::CollisionPrimitive() const {
     borov_engine::math::Sphere sphere{
         borov_engine::math::Vector3{0.0f, 0.175f, 0.0f},
         0.125f,
     };
-    sphere.Transform(sphere, WorldTransform().ToMatrix());
+    sphere.Transform(sphere, WorldMatrix());
 
     return borov_engine::SphereCollision{sphere};
 }
@@ -34,6 +34,18 @@ bool Player::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Player::Distance(const Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Player::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Player::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Player::CollisionPrimitive() const {
     const borov_engine::math::Sphere sphere{WorldTransform().position, 0.5f};
     return borov_engine::SphereCollision{sphere};
@@ -24,12 +24,7 @@ void Ball::Update(const float delta_time) {
         velocity_.y = -velocity_.y;
     }
 
-    for (const Component &component : Game().Components()) {
-        const auto player = dynamic_cast<const Player *>(&component);
-        if (player == nullptr) {
-            continue;
-        }
-
+    for (const Player *player : Game().ComponentsOfType<Player>()) {
         if (player->Intersects(*this)) {
             velocity_.x = -velocity_.x;
         }
@@ -1,6 +1,7 @@
 #include "game.hpp"
 
 #include <iostream>
+#include <utility>
 
 Game::Game(borov_engine::Window &window, borov_engine::Input &input)
     : borov_engine::Game(window, input), ball_{AddComponent<Ball>()}, left_score_{}, right_score_{} {
@@ -9,7 +10,7 @@ Game::Game(borov_engine::Window &window, borov_engine::Input &input)
 void Game::Update(const float delta_time) {
     borov_engine::Game::Update(delta_time);
 
-    const auto &position = ball_.Transform().position;
+    const auto position = std::as_const(ball_).Transform().position;
     if (position.x < -0.975f) {
         std::cout << "One point to the RIGHT!";
         right_score_++;
@@ -38,6 +38,18 @@ bool Jupyter::Intersects(const borov_engine::math::Ray& ray, float& dist) const
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Jupyter::Distance(const borov_engine::Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Jupyter::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Jupyter::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Jupyter::CollisionPrimitive() const {
     auto [position, rotation, scale] = mesh_.get().WorldTransform();
 
@@ -38,6 +38,18 @@ bool Mars::Intersects(const borov_engine::math::Ray& ray, float& dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Mars::Distance(const borov_engine::Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Mars::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Mars::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Mars::CollisionPrimitive() const {
     auto [position, rotation, scale] = mesh_.get().WorldTransform();
 
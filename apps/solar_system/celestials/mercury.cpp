@@ -39,6 +39,18 @@ bool Mercury::Intersects(const borov_engine::math::Ray& ray, float& dist) const
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Mercury::Distance(const borov_engine::Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Mercury::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Mercury::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Mercury::CollisionPrimitive() const {
     auto [position, rotation, scale] = mesh_.get().WorldTransform();
 
@@ -38,6 +38,18 @@ bool Neptune::Intersects(const borov_engine::math::Ray& ray, float& dist) const
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float Neptune::Distance(const borov_engine::Collision& other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+borov_engine::math::Vector3 Neptune::ClosestPoint(const borov_engine::math::Vector3& point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+borov_engine::math::AxisAlignedBox Neptune::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 borov_engine::SphereCollision Neptune::CollisionPrimitive() const {
     auto [position, rotation, scale] = mesh_.get().WorldTransform();
 
@@ -195,13 +195,13 @@ void Game::OnInputKeyDown(const borov_engine::InputKey input_key) {
             break;
         }
         case borov_engine::InputKey::G: {
-            for (borov_engine::Component &component : Components()) {
-                if (const auto triangle_component = dynamic_cast<borov_engine::TriangleComponent *>(&component)) {
-                    triangle_component->Wireframe() = !triangle_component->Wireframe();
-                }
-                if (const auto primitive = dynamic_cast<borov_engine::GeometricPrimitiveComponent *>(&component)) {
-                    primitive->Wireframe() = !primitive->Wireframe();
-                }
+            for (borov_engine::TriangleComponent *triangle_component :
+                 ComponentsOfType<borov_engine::TriangleComponent>()) {
+                triangle_component->Wireframe() = !triangle_component->Wireframe();
+            }
+            for (borov_engine::GeometricPrimitiveComponent *primitive :
+                 ComponentsOfType<borov_engine::GeometricPrimitiveComponent>()) {
+                primitive->Wireframe() = !primitive->Wireframe();
             }
             break;
         }
@@ -224,17 +224,11 @@ void Game::OnInputKeyDown(const borov_engine::InputKey input_key) {
             const math::Vector3 ray_direction = math::Normalize(world_cursor_position - ray_position);
             const math::Ray ray{ray_position, ray_direction};
 
-            // ReSharper disable once CppTooWideScopeInitStatement
-            auto is_scene_and_collision = [](const borov_engine::Component &component) {
-                return dynamic_cast<const borov_engine::SceneComponent *>(&component) != nullptr &&
-                       dynamic_cast<const borov_engine::Collision *>(&component) != nullptr;
-            };
-            for (const borov_engine::Component &component : Components() | std::views::filter(is_scene_and_collision)) {
-                const auto &scene_component = dynamic_cast<const borov_engine::SceneComponent &>(component);
-                const auto &collision_primitive = dynamic_cast<const borov_engine::Collision &>(component);
-                if (float distance = 1000.0f; collision_primitive.Intersects(ray, distance)) {
+            for (auto [scene_component, collision_primitive] :
+                 ComponentsOfType<borov_engine::SceneComponent, borov_engine::Collision>()) {
+                if (float distance = 1000.0f; collision_primitive->Intersects(ray, distance)) {
                     if (target == nullptr || distance < nearest_distance) {
-                        target = &scene_component;
+                        target = scene_component;
                         nearest_distance = distance;
                     }
                 }
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ALLOC_SLAB_POOL_HPP_INCLUDED
+#define BOROV_ENGINE_ALLOC_SLAB_POOL_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+namespace borov_engine::alloc {
+
+struct PoolStats {
+    std::size_t allocation_count = 0;
+    std::size_t deallocation_count = 0;
+    // Number of allocations which actually went to the heap
+    std::size_t slab_count = 0;
+    std::size_t reserved_bytes = 0;
+
+    PoolStats &operator+=(const PoolStats &other);
+};
+
+// Pool of fixed size objects carved out of large slabs, so objects allocated one after another are placed
+// next to each other. Slabs grow geometrically and are released only when the pool itself is destroyed
+class SlabPool {
+  public:
+    explicit SlabPool(std::size_t object_size, std::size_t object_alignment);
+    ~SlabPool() noexcept;
+
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    [[nodiscard]] void *Allocate();
+    void Deallocate(void *object) noexcept;
+
+    [[nodiscard]] const PoolStats &Stats() const;
+
+  private:
+    static constexpr std::size_t min_slab_object_count = 16;
+    static constexpr std::size_t max_slab_object_count = 1024;
+
+    struct FreeObject {
+        FreeObject *next;
+    };
+
+    void AllocateSlab();
+
+    std::size_t object_size_;
+    std::size_t object_alignment_;
+    std::size_t next_slab_object_count_;
+
+    std::vector<std::byte *> slabs_;
+    std::byte *slab_current_;
+    std::byte *slab_end_;
+    FreeObject *free_list_;
+
+    PoolStats stats_;
+};
+
+}  // namespace borov_engine::alloc
+
+#endif  // BOROV_ENGINE_ALLOC_SLAB_POOL_HPP_INCLUDED
@@ -25,6 +25,9 @@ class BoxComponent : public TriangleComponent, public Collision {
 
     [[nodiscard]] bool Intersects(const Collision& other) const override;
     [[nodiscard]] bool Intersects(const math::Ray& ray, float& dist) const override;
+    [[nodiscard]] float Distance(const Collision& other) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3& point) const override;
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     [[nodiscard]] BoxCollision CollisionPrimitive() const;
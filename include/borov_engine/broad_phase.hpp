@@ -0,0 +1,69 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_BROAD_PHASE_HPP_INCLUDED
+#define BOROV_ENGINE_BROAD_PHASE_HPP_INCLUDED
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "math.hpp"
+#include "ray_packet.hpp"
+
+namespace borov_engine {
+
+// Finds pairs of proxies whose bounds overlap. Overlapping pairs are kept between updates,
+// so the pairs which began or ended to overlap are known without comparing anything by the caller
+class BroadPhase {
+  public:
+    using ProxyId = std::uint32_t;
+    static constexpr ProxyId invalid_proxy = (std::numeric_limits<ProxyId>::max)();
+
+    // Smaller proxy always comes first
+    using ProxyPair = std::pair<ProxyId, ProxyId>;
+    using QueryFunction = std::function<void(ProxyId)>;
+    using PacketQueryFunction = std::function<void(ProxyId, RayPacket::Mask)>;
+
+    virtual ~BroadPhase();
+
+    [[nodiscard]] virtual ProxyId Add(const math::AxisAlignedBox &bounds) = 0;
+    // Pairs of the removed proxy are forgotten without being reported as ended, so the proxy could be reused
+    void Remove(ProxyId proxy);
+    virtual void Move(ProxyId proxy, const math::AxisAlignedBox &bounds) = 0;
+
+    [[nodiscard]] virtual std::size_t Size() const = 0;
+
+    // Calls the function for every proxy whose bounds overlap the region
+    virtual void Query(const math::AxisAlignedBox &region, const QueryFunction &function) const = 0;
+    // Calls the function for every proxy whose bounds are hit by the ray closer than the distance
+    virtual void Query(const math::Ray &ray, float max_distance, const QueryFunction &function) const = 0;
+    // Calls the function with the lanes of the packet which hit bounds of the proxy. Unless overridden,
+    // every ray is queried alone, so the same proxy could be reported once per lane
+    virtual void Query(const RayPacket &rays, float max_distance, const PacketQueryFunction &function) const;
+
+    // Finds the pairs which overlap now and compares them with the ones found by the previous update
+    void UpdatePairs();
+
+    // Every span is sorted and stays valid until the next update
+    [[nodiscard]] std::span<const ProxyPair> Pairs() const;
+    [[nodiscard]] std::span<const ProxyPair> BegunPairs() const;
+    [[nodiscard]] std::span<const ProxyPair> EndedPairs() const;
+
+  protected:
+    virtual void RemoveProxy(ProxyId proxy) = 0;
+    // Appends every overlapping pair once, in any order
+    virtual void FindPairs(std::vector<ProxyPair> &pairs) = 0;
+
+  private:
+    std::vector<ProxyPair> pairs_;
+    std::vector<ProxyPair> found_pairs_;
+    std::vector<ProxyPair> begun_pairs_;
+    std::vector<ProxyPair> ended_pairs_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_BROAD_PHASE_HPP_INCLUDED
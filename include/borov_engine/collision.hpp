@@ -3,20 +3,79 @@
 #ifndef BOROV_ENGINE_COLLISION_PRIMITIVE_HPP_INCLUDED
 #define BOROV_ENGINE_COLLISION_PRIMITIVE_HPP_INCLUDED
 
+#include <cstdint>
+#include <memory>
+
 #include "math.hpp"
+#include "quickhull.hpp"
+#include "transform.hpp"
+#include "triangle_bvh.hpp"
 
 namespace borov_engine {
 
+// Compact tag of the concrete collision type, which allows to find the intersection function without any casts
+using CollisionShape = std::uint8_t;
+// Index of the layer, and the set of layers as one bit per index
+using CollisionLayer = std::uint8_t;
+using CollisionLayerMask = std::uint32_t;
+
 class Collision {
   public:
+    // Collisions without the shape, like scene components which forward to some primitive, are asked themselves
+    static constexpr CollisionShape unknown_shape = 0;
+    static constexpr std::size_t max_shape_count = 32;
+    static constexpr CollisionLayer default_layer = 0;
+    static constexpr std::size_t max_layer_count = 32;
+
+    // Both arguments are guaranteed to have the shapes the function was registered for
+    using IntersectionFunction = bool (*)(const Collision &lhs, const Collision &rhs);
+    using DistanceFunction = float (*)(const Collision &lhs, const Collision &rhs);
+
     virtual ~Collision();
 
+    [[nodiscard]] CollisionShape Shape() const;
+
+    // Collision world skips pairs whose layers do not collide before any intersection test.
+    // Layer must be less than `max_layer_count`
+    [[nodiscard]] CollisionLayer Layer() const;
+    void Layer(CollisionLayer layer);
+
     [[nodiscard]] virtual bool Intersects(const Collision &other) const = 0;
     [[nodiscard]] virtual bool Intersects(const math::Ray &ray, float &dist) const = 0;
+
+    // Distance between the nearest points of both collisions, zero if they intersect. Pairs of shapes without
+    // the registered function, and collisions without the shape which do not override it, are measured by their
+    // bounds instead, which never overestimates the distance
+    [[nodiscard]] virtual float Distance(const Collision &other) const;
+    // Point of the collision nearest to the given one, which is the point itself if it is inside.
+    // Nearest point of the bounds unless overridden
+    [[nodiscard]] virtual math::Vector3 ClosestPoint(const math::Vector3 &point) const;
+
+    // Conservative world space bounds used by the broad phase, unbounded unless overridden
+    [[nodiscard]] virtual math::AxisAlignedBox Bounds() const;
+
+    // Shapes and their functions are meant to be registered once at startup, before any intersection test
+    [[nodiscard]] static CollisionShape RegisterShape();
+    // Function is used for both orders of the shapes, arguments are swapped when needed
+    static void RegisterIntersection(CollisionShape lhs, CollisionShape rhs, IntersectionFunction function);
+    static void RegisterDistance(CollisionShape lhs, CollisionShape rhs, DistanceFunction function);
+
+  protected:
+    explicit Collision(CollisionShape shape = unknown_shape);
+
+    // Calls the function registered for shapes of both collisions,
+    // or asks the other collision if its shape is unknown
+    [[nodiscard]] bool IntersectsByShape(const Collision &other) const;
+
+  private:
+    CollisionShape shape_;
+    CollisionLayer layer_;
 };
 
 class SphereCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 1;
+
     using PrimitiveType = math::Sphere;
 
     explicit SphereCollision(const PrimitiveType &primitive);
@@ -26,6 +85,9 @@ class SphereCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType sphere_;
@@ -33,6 +95,8 @@ class SphereCollision : public Collision {
 
 class AxisAlignedBoxCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 2;
+
     using PrimitiveType = math::AxisAlignedBox;
 
     explicit AxisAlignedBoxCollision(const PrimitiveType &primitive);
@@ -42,6 +106,9 @@ class AxisAlignedBoxCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType box_;
@@ -49,6 +116,8 @@ class AxisAlignedBoxCollision : public Collision {
 
 class BoxCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 3;
+
     using PrimitiveType = math::Box;
 
     explicit BoxCollision(const PrimitiveType &primitive);
@@ -58,6 +127,9 @@ class BoxCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType box_;
@@ -65,6 +137,8 @@ class BoxCollision : public Collision {
 
 class FrustumCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 4;
+
     using PrimitiveType = math::Frustum;
 
     explicit FrustumCollision(const PrimitiveType &primitive);
@@ -74,6 +148,9 @@ class FrustumCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType frustum_;
@@ -81,6 +158,8 @@ class FrustumCollision : public Collision {
 
 class PlaneCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 5;
+
     using PrimitiveType = math::Plane;
 
     explicit PlaneCollision(const PrimitiveType &primitive);
@@ -90,6 +169,10 @@ class PlaneCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    // Plane bounds the half space behind it, same as for the intersections
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType plane_;
@@ -97,6 +180,8 @@ class PlaneCollision : public Collision {
 
 class TriangleCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 6;
+
     using PrimitiveType = math::Triangle;
 
     explicit TriangleCollision(const PrimitiveType &primitive);
@@ -106,6 +191,9 @@ class TriangleCollision : public Collision {
 
     [[nodiscard]] bool Intersects(const Collision &other) const override;
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     PrimitiveType triangle_;
@@ -116,15 +204,23 @@ concept TrianglesRange = std::ranges::range<View> && std::same_as<std::ranges::r
 
 class MeshCollision : public Collision {
   public:
+    static constexpr CollisionShape shape = 7;
+
     using Vertex = math::Vector3;
     using VertexCollection = std::vector<Vertex>;
 
     using Index = std::uint32_t;
     using IndexCollection = std::vector<Index>;
 
+    using RayHit = TriangleBvh::RayHit;
+    using PointHit = TriangleBvh::PointHit;
+
     explicit MeshCollision(const VertexCollection &vertices, const IndexCollection &indices);
     explicit MeshCollision(VertexCollection &&vertices, IndexCollection &&indices);
 
+    // Mutable access marks the hierarchy as outdated, it is updated by the next query.
+    // Moved vertices only refit bounds of the hierarchy, which is fast but degrades the tree after large
+    // deformations, while changed indices rebuild it from scratch
     [[nodiscard]] const VertexCollection &Vertices() const;
     [[nodiscard]] VertexCollection &Vertices();
 
@@ -133,12 +229,114 @@ class MeshCollision : public Collision {
 
     [[nodiscard]] TrianglesRange auto Triangles() const;
 
+    // Built on construction, leaves of the hierarchy are tested as packets of triangles. Rebuild after mutation
+    // is lazy and not synchronized, so the collision world calls it before splitting queries between threads
+    [[nodiscard]] const TriangleBvh &Hierarchy() const;
+
     [[nodiscard]] bool Intersects(const Collision &other) const override;
+    // Distance to the nearest hit
     [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    // Nearest point of the surface, the point itself if the mesh is empty
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] bool ClosestHit(const math::Ray &ray, RayHit &hit,
+                                  float max_distance = std::numeric_limits<float>::infinity()) const;
+    [[nodiscard]] bool AnyHit(const math::Ray &ray, float max_distance = std::numeric_limits<float>::infinity()) const;
+    // Distances of the given hits are the max distances of the rays, returns the bits of the lanes hit
+    [[nodiscard]] std::uint32_t ClosestHits(const RayPacket &rays, std::span<RayHit> hits) const;
+    // Nearest point of the surface and its triangle, if it is nearer than the max distance
+    [[nodiscard]] bool ClosestPoint(const math::Vector3 &point, PointHit &hit,
+                                    float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
 
   private:
     VertexCollection vertices_;
     IndexCollection indices_;
+    mutable TriangleBvh hierarchy_;
+    mutable bool is_hierarchy_dirty_;
+    mutable bool are_vertices_moved_;
+};
+
+// Mesh placed into the world by the transform. Every query is moved into the space of the mesh instead,
+// so any number of instances share the same hierarchy, and moving the instance costs nothing.
+// Shapes which can not be transformed exactly, like boxes under non-uniform scale, are tested approximately
+class MeshInstanceCollision : public Collision {
+  public:
+    static constexpr CollisionShape shape = 8;
+
+    using RayHit = MeshCollision::RayHit;
+    using PointHit = MeshCollision::PointHit;
+
+    explicit MeshInstanceCollision(std::shared_ptr<const MeshCollision> mesh, const Transform &transform = {});
+
+    [[nodiscard]] const std::shared_ptr<const MeshCollision> &Mesh() const;
+    [[nodiscard]] std::shared_ptr<const MeshCollision> &Mesh();
+
+    [[nodiscard]] const borov_engine::Transform &Transform() const;
+    [[nodiscard]] borov_engine::Transform &Transform();
+
+    // From the space of the mesh to the world and back
+    [[nodiscard]] math::Matrix4x4 WorldMatrix() const;
+    [[nodiscard]] math::Matrix4x4 LocalMatrix() const;
+
+    [[nodiscard]] bool Intersects(const Collision &other) const override;
+    // Distance to the nearest hit
+    [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    // Nearest point is found in the space of the mesh, which is exact for the uniform scale only
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    // Distances are measured along the given ray in the world, same as for the mesh itself
+    [[nodiscard]] bool ClosestHit(const math::Ray &ray, RayHit &hit,
+                                  float max_distance = std::numeric_limits<float>::infinity()) const;
+    [[nodiscard]] bool AnyHit(const math::Ray &ray, float max_distance = std::numeric_limits<float>::infinity()) const;
+    // Point and distance of the hit are in the world
+    [[nodiscard]] bool ClosestPoint(const math::Vector3 &point, PointHit &hit,
+                                    float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
+
+  private:
+    struct LocalRay {
+        math::Ray ray;
+        // Length of the unit world direction in the space of the mesh
+        float scale;
+    };
+
+    [[nodiscard]] LocalRay ToLocal(const math::Ray &ray) const;
+
+    std::shared_ptr<const MeshCollision> mesh_;
+    borov_engine::Transform transform_;
+};
+
+// Convex hull placed into the world by the transform, like the hull of the collision proxy of the mesh.
+// Tested by GJK against the other convex shapes, so its cost depends only on the number of hull vertices,
+// and any number of instances share the same hull
+class ConvexHullCollision : public Collision {
+  public:
+    static constexpr CollisionShape shape = 9;
+
+    explicit ConvexHullCollision(std::shared_ptr<const Quickhull> hull, const Transform &transform = {});
+
+    [[nodiscard]] const std::shared_ptr<const Quickhull> &Hull() const;
+    [[nodiscard]] std::shared_ptr<const Quickhull> &Hull();
+
+    [[nodiscard]] const borov_engine::Transform &Transform() const;
+    [[nodiscard]] borov_engine::Transform &Transform();
+
+    // From the space of the hull to the world and back
+    [[nodiscard]] math::Matrix4x4 WorldMatrix() const;
+    [[nodiscard]] math::Matrix4x4 LocalMatrix() const;
+
+    [[nodiscard]] bool Intersects(const Collision &other) const override;
+    [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const override;
+    [[nodiscard]] math::Vector3 ClosestPoint(const math::Vector3 &point) const override;
+
+    [[nodiscard]] math::AxisAlignedBox Bounds() const override;
+
+  private:
+    std::shared_ptr<const Quickhull> hull_;
+    borov_engine::Transform transform_;
 };
 
 }  // namespace borov_engine
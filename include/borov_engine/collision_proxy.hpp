@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_COLLISION_PROXY_HPP_INCLUDED
+#define BOROV_ENGINE_COLLISION_PROXY_HPP_INCLUDED
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+#include "quickhull.hpp"
+
+namespace borov_engine {
+
+struct CollisionProxyOptions {
+    // Zero keeps the whole mesh as one part, otherwise it is split into at most this many convex parts
+    std::size_t max_part_count = 0;
+    // Part is split only while the hulls of its halves take less than this fraction of its own hull
+    float split_volume_ratio = 0.8f;
+};
+
+// Simplified shapes of the mesh computed once at import, which are orders of magnitude cheaper
+// to test than its triangles: the tight oriented box, the bounding sphere and the convex hull,
+// optionally decomposed into several convex parts for concave meshes
+class CollisionProxy {
+  public:
+    using Index = Quickhull::Index;
+    using HullPointer = std::shared_ptr<const Quickhull>;
+    using PartCollection = std::vector<HullPointer>;
+
+    explicit CollisionProxy();
+    // Incomplete triangle at the end of indices is ignored
+    explicit CollisionProxy(std::span<const math::Vector3> vertices, std::span<const Index> indices,
+                            const CollisionProxyOptions &options = {});
+
+    // Reads the proxy cached next to the mesh if the cache is newer than the mesh and was built with the same
+    // options, otherwise builds it from the vertices and rewrites the cache. Cache which could not be written,
+    // like the one in the read only directory, is silently skipped
+    [[nodiscard]] static CollisionProxy Import(const std::filesystem::path &mesh_path,
+                                               std::span<const math::Vector3> vertices, std::span<const Index> indices,
+                                               const CollisionProxyOptions &options = {});
+    [[nodiscard]] static std::filesystem::path CachePath(const std::filesystem::path &mesh_path);
+
+    [[nodiscard]] const math::Box &Box() const;
+    [[nodiscard]] const math::Sphere &Sphere() const;
+    // Never null, shared so that any number of collisions use it without a copy
+    [[nodiscard]] const HullPointer &Hull() const;
+    // Convex parts which cover the mesh together, the whole hull only if it was not decomposed
+    [[nodiscard]] const PartCollection &Parts() const;
+
+  private:
+    explicit CollisionProxy(const math::Box &box, const math::Sphere &sphere, HullPointer hull, PartCollection &&parts);
+
+    math::Box box_;
+    math::Sphere sphere_;
+    HullPointer hull_;
+    PartCollection parts_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_COLLISION_PROXY_HPP_INCLUDED
@@ -0,0 +1,198 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_COLLISION_WORLD_HPP_INCLUDED
+#define BOROV_ENGINE_COLLISION_WORLD_HPP_INCLUDED
+
+#include <array>
+#include <concepts>
+#include <limits>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "broad_phase.hpp"
+#include "collision.hpp"
+#include "delegate/multicast_delegate.hpp"
+
+namespace borov_engine {
+
+class ThreadPool;
+
+struct CollisionPair {
+    Collision *first;
+    Collision *second;
+};
+
+struct RaycastHit {
+    // Null if nothing was hit
+    Collision *collision;
+    float distance;
+};
+
+// Sphere moved along the direction, which must be normalized, and stopped at the first contact
+struct SphereSweep {
+    math::Sphere sphere;
+    math::Vector3 direction;
+    float max_distance;
+};
+
+struct SweepHit {
+    // Null if nothing was hit
+    Collision *collision;
+    // Distance the sphere moved before the contact
+    float distance;
+    // Point of the collision nearest to the center of the sphere at the contact
+    math::Vector3 point;
+    // Unit normal of the contact pointing from the collision to the sphere, which is the reverse
+    // of the direction if the sphere starts inside the collision
+    math::Vector3 normal;
+};
+
+struct OverlapHits {
+    // Part of the overlap buffer of the batch reserved for the query
+    std::span<Collision *> collisions;
+    // More collisions overlap than the query has room for, the rest of them are dropped
+    bool is_truncated;
+};
+
+// Queries of the batch and the buffers for their results, which are given by the caller,
+// so the batch allocates nothing for its results. Every span of results is as long as its queries
+struct SceneQueryBatch {
+    std::span<const math::Ray> rays;
+    std::span<RaycastHit> ray_hits;
+    float max_ray_distance = std::numeric_limits<float>::infinity();
+
+    std::span<const math::Sphere> spheres;
+    std::span<OverlapHits> sphere_hits;
+    std::span<const math::Box> boxes;
+    std::span<OverlapHits> box_hits;
+    // Every overlap query owns `max_overlaps` consecutive slots, the ones of spheres go first and then of boxes
+    std::span<Collision *> overlaps;
+    std::size_t max_overlaps = 0;
+
+    std::span<const SphereSweep> sweeps;
+    std::span<SweepHit> sweep_hits;
+
+    // Only collisions on these layers are reported
+    CollisionLayerMask layer_mask = ~CollisionLayerMask{};
+};
+
+DECLARE_EVENT(OnCollisionOverlap, CollisionWorld, const CollisionPair &);
+
+// Broad phase over every registered collision, which finds pairs whose bounds overlap
+// without testing every collision against every other one. Pairs whose layers do not collide are dropped
+// right away, the rest of the candidates are then tested exactly,
+// and the pairs which began or ended to intersect are reported by the events
+class CollisionWorld {
+  public:
+    // Uses the tree broad phase until some other one is chosen
+    CollisionWorld();
+
+    // Collision must outlive the world or be removed from it before destruction
+    void Add(Collision &collision);
+    void Remove(const Collision &collision);
+
+    [[nodiscard]] bool Contains(const Collision &collision) const;
+    [[nodiscard]] std::size_t Size() const;
+
+    [[nodiscard]] const BroadPhase &BroadPhase() const;
+    [[nodiscard]] class BroadPhase &BroadPhase();
+
+    // Replaces the broad phase, every collision is moved to the new one
+    template <std::derived_from<class BroadPhase> T, typename... Args>
+    T &BroadPhase(Args &&...args);
+
+    // Every layer collides with every other one until the matrix is changed, which is always kept symmetric.
+    // Layers must be less than `Collision::max_layer_count`
+    [[nodiscard]] CollisionLayerMask LayerMask(CollisionLayer layer) const;
+    void LayerMask(CollisionLayer layer, CollisionLayerMask mask);
+    void LayerCollision(CollisionLayer lhs, CollisionLayer rhs, bool is_enabled);
+    [[nodiscard]] bool CanCollide(const Collision &lhs, const Collision &rhs) const;
+
+    // Refreshes bounds of every collision, tests the candidate pairs and broadcasts the events
+    void Update();
+    // Found by the last update, so they are only candidates for the exact intersection test.
+    // Layers of both collisions are already checked
+    [[nodiscard]] std::span<const CollisionPair> CandidatePairs() const;
+    // Pairs which intersected during the last update
+    [[nodiscard]] std::span<const CollisionPair> Contacts() const;
+
+    // Broadcast by the update once every pair is tested, so handlers never run in the middle of the test.
+    // Ended overlaps go first. Removing the collision ends its overlaps right away, while it is still alive,
+    // and its overlaps which have not been broadcast to begin yet never begin
+    [[nodiscard]] const OnCollisionOverlap &OnBeginOverlap() const;
+    [[nodiscard]] OnCollisionOverlap &OnBeginOverlap();
+
+    [[nodiscard]] const OnCollisionOverlap &OnEndOverlap() const;
+    [[nodiscard]] OnCollisionOverlap &OnEndOverlap();
+
+    // Calls `function(collision)` for every collision whose bounds overlap the region
+    template <std::invocable<Collision &> F>
+    void Query(const math::AxisAlignedBox &region, F &&function) const;
+    // Calls `function(collision)` for every collision whose bounds are hit by the ray closer than the distance
+    template <std::invocable<Collision &> F>
+    void Query(const math::Ray &ray, float max_distance, F &&function) const;
+
+    // Nearest hit of every ray, hits must be as many as rays. Rays are traced through the broad phase in packets,
+    // and meshes test the whole packet at once, so neighbouring rays should go in similar directions
+    void Raycast(std::span<const math::Ray> rays, std::span<RaycastHit> hits,
+                 float max_distance = std::numeric_limits<float>::infinity(),
+                 CollisionLayerMask layer_mask = ~CollisionLayerMask{}) const;
+
+    // Runs every query of the batch, split between the workers of the pool if it is given. Collisions are only
+    // read, so it must not run together with anything that changes them or the world, and it should run
+    // after the update, which refreshes lazily built state like world transforms. Hierarchies of meshes
+    // are brought up to date before the queries are split between the workers.
+    // Sweeps advance by the distance to every collision, so they never pass through thin collisions, and stop
+    // closer than a small part of the radius or the distance to the contact. Sweeps which slide along the surface
+    // approach it ever slower, so after some steps they stop short of the contact and report it there
+    void Query(const SceneQueryBatch &batch, ThreadPool *thread_pool = nullptr) const;
+
+  private:
+    struct Entry {
+        Collision *collision;
+        BroadPhase::ProxyId proxy;
+    };
+
+    void Overlap(const Collision &shape, CollisionLayerMask layer_mask, OverlapHits &hits) const;
+    [[nodiscard]] SweepHit Sweep(const SphereSweep &sweep, CollisionLayerMask layer_mask) const;
+
+    void ResetBroadPhase(std::unique_ptr<class BroadPhase> broad_phase);
+    void SetProxy(BroadPhase::ProxyId proxy, Collision &collision);
+    void FilterPairs();
+    void FindContacts();
+    void BroadcastOverlaps();
+
+    std::unique_ptr<class BroadPhase> broad_phase_;
+    std::array<CollisionLayerMask, Collision::max_layer_count> layer_matrix_;
+    std::vector<Entry> entries_;
+    std::unordered_map<const Collision *, std::size_t> entry_indices_;
+    // Indexed by proxies of the broad phase, holes are left by removed collisions.
+    // Layers are copied by the update, so the filter does not touch the collisions themselves
+    std::vector<Collision *> proxy_collisions_;
+    std::vector<CollisionLayer> proxy_layers_;
+    std::vector<BroadPhase::ProxyPair> candidate_proxies_;
+    std::vector<CollisionPair> pairs_;
+
+    // Sorted the same way as the pairs of the broad phase
+    std::vector<BroadPhase::ProxyPair> contact_proxies_;
+    std::vector<BroadPhase::ProxyPair> found_contact_proxies_;
+    std::vector<BroadPhase::ProxyPair> changed_contact_proxies_;
+    std::vector<CollisionPair> contacts_;
+    // Pairs waiting for the broadcast, removed collisions are replaced by nulls.
+    // Pairs before the next ones are already broadcast
+    std::vector<CollisionPair> begun_overlaps_;
+    std::vector<CollisionPair> ended_overlaps_;
+    std::size_t next_begun_overlap_ = 0;
+    std::size_t next_ended_overlap_ = 0;
+
+    OnCollisionOverlap on_begin_overlap_;
+    OnCollisionOverlap on_end_overlap_;
+};
+
+}  // namespace borov_engine
+
+#include "collision_world.inl"
+
+#endif  // BOROV_ENGINE_COLLISION_WORLD_HPP_INCLUDED
@@ -0,0 +1,29 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_COLLISION_WORLD_INL_INCLUDED
+#define BOROV_ENGINE_COLLISION_WORLD_INL_INCLUDED
+
+namespace borov_engine {
+
+template <std::derived_from<class BroadPhase> T, typename... Args>
+T &CollisionWorld::BroadPhase(Args &&...args) {
+    auto broad_phase = std::make_unique<T>(std::forward<Args>(args)...);
+    T &result = *broad_phase;
+    ResetBroadPhase(std::move(broad_phase));
+    return result;
+}
+
+template <std::invocable<Collision &> F>
+void CollisionWorld::Query(const math::AxisAlignedBox &region, F &&function) const {
+    broad_phase_->Query(region, [&](const BroadPhase::ProxyId proxy) { function(*proxy_collisions_[proxy]); });
+}
+
+template <std::invocable<Collision &> F>
+void CollisionWorld::Query(const math::Ray &ray, const float max_distance, F &&function) const {
+    broad_phase_->Query(ray, max_distance,
+                        [&](const BroadPhase::ProxyId proxy) { function(*proxy_collisions_[proxy]); });
+}
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_COLLISION_WORLD_INL_INCLUDED
@@ -5,8 +5,11 @@
 
 #include <d3d11.h>
 
+#include <cstdint>
 #include <functional>
 
+#include "component_handle.hpp"
+
 namespace borov_engine {
 
 class Game;
@@ -23,6 +26,20 @@ class Component {
     virtual void Draw(const Camera *camera);
     virtual void OnTargetResize();
 
+    // Components are updated phase by phase in ascending order, so later phases see results of the earlier ones.
+    // Parallel safe components of the same phase are updated on the thread pool before the rest of the phase,
+    // so their update must touch nothing but the component itself and must not throw.
+    // World transforms are recomputed right before the parallel part, so reading them through the const interface,
+    // e.g. `std::as_const(component).WorldTransform()`, writes nothing. Changing the transform of the component
+    // marks its children dirty too, so only components without children may do it in parallel.
+    // Lists of `Game::ComponentsOfType` must already exist, i.e. be queried once before, since they are not
+    // created during the parallel part. Both must not change after the component was added into the game
+    [[nodiscard]] virtual std::int32_t UpdatePhase() const;
+    [[nodiscard]] virtual bool IsUpdateParallelSafe() const;
+
+    // Invalid for components which were not added into the game by `Game::AddComponent`
+    [[nodiscard]] ComponentHandle Handle() const;
+
   protected:
     [[nodiscard]] const Game &Game() const;
     [[nodiscard]] class Game &Game();
@@ -34,7 +51,10 @@ class Component {
     [[nodiscard]] const ID3D11Device &Device() const;
 
   private:
+    friend class Game;
+
     std::reference_wrapper<class Game> game_;
+    ComponentHandle handle_;
 };
 
 }  // namespace borov_engine
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_COMPONENT_HANDLE_HPP_INCLUDED
+#define BOROV_ENGINE_COMPONENT_HANDLE_HPP_INCLUDED
+
+#include <cstdint>
+#include <limits>
+
+namespace borov_engine {
+
+// Stable reference to the component added into the game.
+// Slot of the destroyed component could be reused, but with another generation, so stale handles are detected
+struct ComponentHandle {
+    static constexpr std::uint32_t invalid_index = (std::numeric_limits<std::uint32_t>::max)();
+
+    std::uint32_t index = invalid_index;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool operator==(const ComponentHandle &other) const = default;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_COMPONENT_HANDLE_HPP_INCLUDED
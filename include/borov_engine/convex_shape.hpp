@@ -0,0 +1,68 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_CONVEX_SHAPE_HPP_INCLUDED
+#define BOROV_ENGINE_CONVEX_SHAPE_HPP_INCLUDED
+
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+
+namespace borov_engine {
+
+// Support functions return the farthest point of the shape along the direction, which need not be normalized.
+// This is all that GJK and EPA need to know about the convex shape.
+// Planes are unbounded and have no support point, so they are tested only by their own intersection functions
+// Point is the degenerate shape, which is its own support along any direction
+[[nodiscard]] math::Vector3 Support(const math::Vector3 &point, const math::Vector3 &direction);
+[[nodiscard]] math::Vector3 Support(const math::Sphere &sphere, const math::Vector3 &direction);
+[[nodiscard]] math::Vector3 Support(const math::AxisAlignedBox &box, const math::Vector3 &direction);
+[[nodiscard]] math::Vector3 Support(const math::Box &box, const math::Vector3 &direction);
+[[nodiscard]] math::Vector3 Support(const math::Frustum &frustum, const math::Vector3 &direction);
+[[nodiscard]] math::Vector3 Support(const math::Triangle &triangle, const math::Vector3 &direction);
+
+template <typename T>
+concept ConvexSupport = requires(const T &shape, const math::Vector3 &direction) {
+    { Support(shape, direction) } -> std::convertible_to<math::Vector3>;
+};
+
+// Convex hull of the points. Any point cloud has the same support as its hull,
+// so points inside the hull are allowed and only make the support slower
+class ConvexHull {
+  public:
+    using PointCollection = std::vector<math::Vector3>;
+
+    explicit ConvexHull() = default;
+    explicit ConvexHull(std::span<const math::Vector3> points);
+    explicit ConvexHull(PointCollection &&points);
+
+    [[nodiscard]] const PointCollection &Points() const;
+    [[nodiscard]] PointCollection &Points();
+
+  private:
+    PointCollection points_;
+};
+
+[[nodiscard]] math::Vector3 Support(const ConvexHull &hull, const math::Vector3 &direction);
+
+// Non-owning view of any shape with the support function, the shape must outlive the view
+class ConvexShape {
+  public:
+    template <ConvexSupport T>
+    explicit ConvexShape(const T &shape);
+
+    [[nodiscard]] math::Vector3 Support(const math::Vector3 &direction) const;
+
+  private:
+    using SupportFunction = math::Vector3 (*)(const void *shape, const math::Vector3 &direction);
+
+    const void *shape_;
+    SupportFunction support_;
+};
+
+}  // namespace borov_engine
+
+#include "convex_shape.inl"
+
+#endif  // BOROV_ENGINE_CONVEX_SHAPE_HPP_INCLUDED
@@ -0,0 +1,27 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_CONVEX_SHAPE_INL_INCLUDED
+#define BOROV_ENGINE_CONVEX_SHAPE_INL_INCLUDED
+
+namespace borov_engine {
+
+namespace detail {
+
+// Outside of the class, so the member function does not hide support functions of the shapes
+template <ConvexSupport T>
+math::Vector3 SupportOf(const void *shape, const math::Vector3 &direction) {
+    return Support(*static_cast<const T *>(shape), direction);
+}
+
+}  // namespace detail
+
+template <ConvexSupport T>
+ConvexShape::ConvexShape(const T &shape) : shape_{&shape}, support_{detail::SupportOf<T>} {}
+
+inline math::Vector3 ConvexShape::Support(const math::Vector3 &direction) const {
+    return support_(shape_, direction);
+}
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_CONVEX_SHAPE_INL_INCLUDED
@@ -15,9 +15,9 @@
     class name : public ::borov_engine::delegate::MulticastDelegate<__VA_ARGS__> { \
       private:                                                                     \
         friend class owner_type;                                                   \
-        using ::borov_engine::delegate::MulticastDelegate::Broadcast;              \
-        using ::borov_engine::delegate::MulticastDelegate::RemoveAll;              \
-        using ::borov_engine::delegate::MulticastDelegate::Remove;                 \
+        using ::borov_engine::delegate::MulticastDelegate<__VA_ARGS__>::Broadcast; \
+        using ::borov_engine::delegate::MulticastDelegate<__VA_ARGS__>::RemoveAll; \
+        using ::borov_engine::delegate::MulticastDelegate<__VA_ARGS__>::Remove;    \
     };
 
 namespace borov_engine::delegate {
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_COMPONENT_LIST_HPP_INCLUDED
+#define BOROV_ENGINE_COMPONENT_LIST_HPP_INCLUDED
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "../component.hpp"
+
+namespace borov_engine::detail {
+
+template <typename... Ts>
+concept ComponentQuery = sizeof...(Ts) > 0 && (std::is_polymorphic_v<Ts> && ...);
+
+// Distinct type for every query, used as a key of the list
+template <typename... Ts>
+struct ComponentQueryTag {};
+
+// Pointer to the single requested type, or a tuple of pointers to every requested type of the same component
+template <typename... Ts>
+using ComponentListElement =
+    std::conditional_t<sizeof...(Ts) == 1, std::tuple_element_t<0, std::tuple<Ts *...>>, std::tuple<Ts *...>>;
+
+class ComponentList {
+  public:
+    virtual ~ComponentList() = default;
+
+    virtual void TryAdd(Component &component) = 0;
+    // Components must be sorted by their addresses
+    virtual void Remove(std::span<const Component *const> components) = 0;
+};
+
+template <typename... Ts>
+    requires ComponentQuery<Ts...>
+class TypedComponentList final : public ComponentList {
+  public:
+    using Element = ComponentListElement<Ts...>;
+
+    void TryAdd(Component &component) override {
+        // Cross casts allow to request interfaces which are not components themselves, like collision
+        const std::tuple<Ts *...> casted{dynamic_cast<Ts *>(&component)...};
+        const bool is_every_type = std::apply([](auto *...pointers) { return ((pointers != nullptr) && ...); }, casted);
+        if (!is_every_type) {
+            return;
+        }
+
+        if constexpr (sizeof...(Ts) == 1) {
+            elements_.push_back(std::get<0>(casted));
+        } else {
+            elements_.push_back(casted);
+        }
+        components_.push_back(&component);
+    }
+
+    void Remove(const std::span<const Component *const> components) override {
+        // Swap with the last element instead of shifting the rest, order of the list is not preserved anyway
+        for (std::size_t i = 0; i < elements_.size();) {
+            if (!std::ranges::binary_search(components, components_[i])) {
+                i += 1;
+                continue;
+            }
+            elements_[i] = elements_.back();
+            elements_.pop_back();
+            components_[i] = components_.back();
+            components_.pop_back();
+        }
+    }
+
+    [[nodiscard]] std::span<const Element> Elements() const {
+        return elements_;
+    }
+
+  private:
+    std::vector<Element> elements_;
+    std::vector<const Component *> components_;
+};
+
+}  // namespace borov_engine::detail
+
+#endif  // BOROV_ENGINE_COMPONENT_LIST_HPP_INCLUDED
@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_DYNAMIC_AABB_TREE_HPP_INCLUDED
+#define BOROV_ENGINE_DYNAMIC_AABB_TREE_HPP_INCLUDED
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "math.hpp"
+#include "ray_packet.hpp"
+
+namespace borov_engine {
+
+// Balanced binary tree of axis aligned boxes which could be added, moved and removed one at a time.
+// Every proxy is stored with fat bounds, so small movements do not change the tree at all
+class DynamicAabbTree {
+  public:
+    using ProxyId = std::uint32_t;
+    static constexpr ProxyId invalid_proxy = (std::numeric_limits<ProxyId>::max)();
+
+    using ProxyPair = std::pair<ProxyId, ProxyId>;
+
+    // Margin is added to every side of the bounds of the proxy
+    explicit DynamicAabbTree(float margin = 0.1f);
+
+    [[nodiscard]] ProxyId Add(const math::AxisAlignedBox &bounds);
+    void Remove(ProxyId proxy);
+    // Reinserts the proxy only if the bounds left its fat bounds, returns whether it was reinserted
+    bool Move(ProxyId proxy, const math::AxisAlignedBox &bounds);
+
+    [[nodiscard]] math::AxisAlignedBox FatBounds(ProxyId proxy) const;
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] std::size_t Height() const;
+
+    // Calls `function(proxy)` for every proxy whose fat bounds overlap the region
+    template <std::invocable<ProxyId> F>
+    void Query(const math::AxisAlignedBox &region, F &&function) const;
+    // Calls `function(proxy)` for every proxy whose fat bounds are hit by the ray closer than the distance
+    template <std::invocable<ProxyId> F>
+    void Query(const math::Ray &ray, float max_distance, F &&function) const;
+    // Calls `function(proxy, lanes)` for every proxy whose fat bounds are hit by some lanes of the packet
+    template <std::invocable<ProxyId, RayPacket::Mask> F>
+    void Query(const RayPacket &rays, float max_distance, F &&function) const;
+
+    // Every pair of proxies whose fat bounds overlap, once and with the smaller proxy first
+    void Pairs(std::vector<ProxyPair> &pairs) const;
+
+  private:
+    using Index = ProxyId;
+    static constexpr Index null_index = invalid_proxy;
+    // Rotations keep the tree balanced like an AVL tree, so its height stays well below this for any proxy count
+    static constexpr std::size_t max_height = 64;
+
+    struct Node {
+        math::Vector3 min;
+        math::Vector3 max;
+        // Next free node if the node is free
+        Index parent;
+        Index child1;
+        Index child2;
+        // Negative for free nodes, zero for leaves
+        std::int32_t height;
+
+        [[nodiscard]] bool IsLeaf() const;
+    };
+
+    [[nodiscard]] static bool Overlaps(const Node &lhs, const Node &rhs);
+    [[nodiscard]] static bool Overlaps(const Node &node, const math::Vector3 &min, const math::Vector3 &max);
+    [[nodiscard]] static bool Intersects(const Node &node, const math::Ray &ray, const math::Vector3 &inverse_direction,
+                                         float max_distance);
+
+    Index AllocateNode();
+    void FreeNode(Index index);
+    void InsertLeaf(Index leaf);
+    void RemoveLeaf(Index leaf);
+    void Refit(Index index);
+    Index Balance(Index index);
+
+    std::vector<Node> nodes_;
+    Index root_;
+    Index free_list_;
+    std::size_t proxy_count_;
+    float margin_;
+};
+
+}  // namespace borov_engine
+
+#include "dynamic_aabb_tree.inl"
+
+#endif  // BOROV_ENGINE_DYNAMIC_AABB_TREE_HPP_INCLUDED
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_DYNAMIC_AABB_TREE_INL_INCLUDED
+#define BOROV_ENGINE_DYNAMIC_AABB_TREE_INL_INCLUDED
+
+namespace borov_engine {
+
+template <std::invocable<DynamicAabbTree::ProxyId> F>
+void DynamicAabbTree::Query(const math::AxisAlignedBox &region, F &&function) const {
+    if (root_ == null_index) {
+        return;
+    }
+
+    const math::Vector3 center{region.Center};
+    const math::Vector3 extents{region.Extents};
+    const math::Vector3 min = center - extents;
+    const math::Vector3 max = center + extents;
+
+    std::array<Index, max_height + 1> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = root_;
+    while (stack_size > 0) {
+        const Index index = stack[--stack_size];
+
+        const Node &node = nodes_[index];
+        if (!Overlaps(node, min, max)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            function(ProxyId{index});
+        } else {
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+template <std::invocable<DynamicAabbTree::ProxyId> F>
+void DynamicAabbTree::Query(const math::Ray &ray, const float max_distance, F &&function) const {
+    if (root_ == null_index) {
+        return;
+    }
+
+    const math::Vector3 inverse_direction{1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+    std::array<Index, max_height + 1> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = root_;
+    while (stack_size > 0) {
+        const Index index = stack[--stack_size];
+
+        const Node &node = nodes_[index];
+        if (!Intersects(node, ray, inverse_direction, max_distance)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            function(ProxyId{index});
+        } else {
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+template <std::invocable<DynamicAabbTree::ProxyId, RayPacket::Mask> F>
+void DynamicAabbTree::Query(const RayPacket &rays, const float max_distance, F &&function) const {
+    if (root_ == null_index) {
+        return;
+    }
+
+    // Node is visited while any lane hits it, so the packet costs about as much as the most divergent of its rays
+    RayPacket::Lanes max_distances;
+    max_distances.fill(max_distance);
+    RayPacket::Lanes entries;
+    std::array<Index, max_height + 1> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = root_;
+    while (stack_size > 0) {
+        const Index index = stack[--stack_size];
+
+        const Node &node = nodes_[index];
+        const RayPacket::Mask lanes = rays.Intersects(node.min, node.max, max_distances, entries);
+        if (lanes == 0) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            function(ProxyId{index}, lanes);
+        } else {
+            stack[stack_size++] = node.child1;
+            stack[stack_size++] = node.child2;
+        }
+    }
+}
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_DYNAMIC_AABB_TREE_INL_INCLUDED
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_ARCHETYPE_HPP_INCLUDED
+#define BOROV_ENGINE_ECS_ARCHETYPE_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "component_type.hpp"
+#include "entity.hpp"
+
+namespace borov_engine::ecs {
+
+// Storage of every entity which has exactly the same set of component types.
+// Entities are split into fixed size chunks, and each chunk keeps every component type in its own column,
+// so iteration over some of the components touches only the memory of those components.
+class Archetype {
+  public:
+    static constexpr std::size_t chunk_bytes = 16 * 1024;
+    static constexpr std::size_t invalid_column = static_cast<std::size_t>(-1);
+
+    // Types must be sorted by their ids and must not repeat
+    explicit Archetype(std::vector<const ComponentTypeInfo *> types);
+    ~Archetype();
+
+    Archetype(const Archetype &) = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    [[nodiscard]] std::span<const ComponentTypeInfo *const> Types() const;
+    [[nodiscard]] std::size_t Column(ComponentTypeId type_id) const;
+    [[nodiscard]] bool HasAll(std::span<const ComponentTypeId> type_ids) const;
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] std::size_t ChunkCapacity() const;
+    [[nodiscard]] std::size_t ChunkCount() const;
+    [[nodiscard]] std::size_t ChunkSize(std::size_t chunk) const;
+
+    // First value of the column in the chunk, values of the same column are stored contiguously
+    [[nodiscard]] void *ColumnData(std::size_t chunk, std::size_t column) const;
+    [[nodiscard]] void *Value(std::size_t row, std::size_t column) const;
+    [[nodiscard]] Entity EntityAt(std::size_t row) const;
+
+    // Values of the new row are not constructed, the caller must construct every one of them
+    [[nodiscard]] std::size_t AllocateRow(Entity entity);
+    // Destroys values of the row and moves the last row in its place.
+    // Returns the entity which was moved, or the invalid entity if the removed row was the last one
+    Entity RemoveRow(std::size_t row);
+    // Relocates values of the row which exist in the other archetype and destroys the rest,
+    // values of the types which exist only in the other archetype are left for the caller to construct
+    Entity MoveRow(std::size_t row, Archetype &other, std::size_t &other_row);
+
+  private:
+    struct ChunkDeleter {
+        void operator()(std::byte *chunk) const;
+    };
+    using ChunkPtr = std::unique_ptr<std::byte[], ChunkDeleter>;
+
+    // Moves values of the last row into the hole at `row` without destroying anything
+    Entity FillHole(std::size_t row);
+
+    std::vector<const ComponentTypeInfo *> types_;
+    std::vector<std::size_t> column_offsets_;
+    std::size_t chunk_capacity_;
+
+    std::vector<ChunkPtr> chunks_;
+    std::vector<Entity> entities_;
+};
+
+}  // namespace borov_engine::ecs
+
+#endif  // BOROV_ENGINE_ECS_ARCHETYPE_HPP_INCLUDED
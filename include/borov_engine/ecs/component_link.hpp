@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_COMPONENT_LINK_HPP_INCLUDED
+#define BOROV_ENGINE_ECS_COMPONENT_LINK_HPP_INCLUDED
+
+#include <concepts>
+
+#include "../game.hpp"
+
+namespace borov_engine::ecs {
+
+// Entity component which refers to the game component, for example to copy simulated positions into the scene.
+// Handle is resolved on every access, so the link stays safe after the game component was removed
+template <std::derived_from<Component> T>
+class ComponentLink {
+  public:
+    explicit ComponentLink(const T &component) : handle_{component.Handle()} {}
+
+    [[nodiscard]] ComponentHandle Handle() const {
+        return handle_;
+    }
+
+    // Null if the component was already destroyed
+    [[nodiscard]] const T *Resolve(const Game &game) const {
+        return static_cast<const T *>(game.FindComponent(handle_));
+    }
+
+    [[nodiscard]] T *Resolve(Game &game) const {
+        return static_cast<T *>(game.FindComponent(handle_));
+    }
+
+  private:
+    ComponentHandle handle_;
+};
+
+}  // namespace borov_engine::ecs
+
+#endif  // BOROV_ENGINE_ECS_COMPONENT_LINK_HPP_INCLUDED
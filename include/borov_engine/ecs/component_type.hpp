@@ -0,0 +1,61 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_COMPONENT_TYPE_HPP_INCLUDED
+#define BOROV_ENGINE_ECS_COMPONENT_TYPE_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace borov_engine::ecs {
+
+// Any plain object could be stored in the column, there is no base class to inherit from.
+// Values are relocated between chunks when the entity changes its components, so moving must not throw
+template <typename T>
+concept ComponentData = std::is_object_v<T> && !std::is_const_v<T> && std::is_nothrow_move_constructible_v<T> &&
+                        std::is_nothrow_destructible_v<T>;
+
+using ComponentTypeId = std::uint32_t;
+
+struct ComponentTypeInfo {
+    ComponentTypeId id;
+    std::size_t size;
+    std::size_t alignment;
+    // Move constructs the value at `destination` and destroys the one at `source`
+    void (*relocate)(void *destination, void *source);
+    void (*destroy)(void *value);
+};
+
+namespace detail {
+
+ComponentTypeId NextComponentTypeId();
+
+}  // namespace detail
+
+template <ComponentData T>
+const ComponentTypeInfo &ComponentType() {
+    static const ComponentTypeInfo info{
+        .id = detail::NextComponentTypeId(),
+        .size = sizeof(T),
+        .alignment = alignof(T),
+        .relocate =
+            [](void *destination, void *source) {
+                T &value = *std::launder(static_cast<T *>(source));
+                ::new (destination) T(std::move(value));
+                value.~T();
+            },
+        .destroy = [](void *value) { std::launder(static_cast<T *>(value))->~T(); },
+    };
+    return info;
+}
+
+template <typename T>
+ComponentTypeId ComponentTypeIdOf() {
+    return ComponentType<std::remove_const_t<T>>().id;
+}
+
+}  // namespace borov_engine::ecs
+
+#endif  // BOROV_ENGINE_ECS_COMPONENT_TYPE_HPP_INCLUDED
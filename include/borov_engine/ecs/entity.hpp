@@ -0,0 +1,23 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_ENTITY_HPP_INCLUDED
+#define BOROV_ENGINE_ECS_ENTITY_HPP_INCLUDED
+
+#include <cstdint>
+#include <limits>
+
+namespace borov_engine::ecs {
+
+// Index of the entity record in the world, generation tells apart entities which reused the same record
+struct Entity {
+    static constexpr std::uint32_t invalid_index = (std::numeric_limits<std::uint32_t>::max)();
+
+    std::uint32_t index = invalid_index;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool operator==(const Entity &other) const = default;
+};
+
+}  // namespace borov_engine::ecs
+
+#endif  // BOROV_ENGINE_ECS_ENTITY_HPP_INCLUDED
@@ -0,0 +1,126 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_WORLD_HPP_INCLUDED
+#define BOROV_ENGINE_ECS_WORLD_HPP_INCLUDED
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "archetype.hpp"
+
+namespace borov_engine {
+
+class ThreadPool;
+
+}  // namespace borov_engine
+
+namespace borov_engine::ecs {
+
+class World;
+
+// Component types which are read and written by the system, used to find systems which could run together
+struct SystemAccess {
+    std::vector<ComponentTypeId> reads;
+    std::vector<ComponentTypeId> writes;
+
+    // Const types are read, the rest are written
+    template <typename... Cs>
+    [[nodiscard]] static SystemAccess Of();
+
+    [[nodiscard]] bool ConflictsWith(const SystemAccess &other) const;
+};
+
+using System = std::function<void(World &world, float delta_time)>;
+
+// Entities with plain data components stored by archetypes, independent of the game components.
+// Intended for large amounts of simple objects, which are too expensive to be updated one virtual call at a time
+class World {
+  public:
+    explicit World();
+    ~World();
+
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    template <ComponentData... Cs>
+    Entity CreateEntity(Cs... components);
+    void DestroyEntity(Entity entity);
+
+    [[nodiscard]] bool IsAlive(Entity entity) const;
+    [[nodiscard]] std::size_t Size() const;
+
+    template <ComponentData C>
+    [[nodiscard]] bool Has(Entity entity) const;
+
+    // Null if the entity does not have the component. Pointers are invalidated by any structural change
+    template <ComponentData C>
+    [[nodiscard]] const C *Find(Entity entity) const;
+    template <ComponentData C>
+    [[nodiscard]] C *Find(Entity entity);
+
+    // Replaces the value if the entity already has the component
+    template <ComponentData C>
+    C &Add(Entity entity, C component);
+    template <ComponentData C>
+    void Remove(Entity entity);
+
+    // Calls `function(std::span<Cs>...)` for every chunk of entities which have all the components
+    template <typename... Cs, std::invocable<std::span<Cs>...> F>
+        requires(ComponentData<std::remove_const_t<Cs>> && ...)
+    void EachChunk(F &&function);
+    template <typename... Cs, std::invocable<Cs &...> F>
+        requires(ComponentData<std::remove_const_t<Cs>> && ...)
+    void Each(F &&function);
+    // Same as `Each`, but chunks are split between threads of the pool
+    template <typename... Cs, std::invocable<Cs &...> F>
+        requires(ComponentData<std::remove_const_t<Cs>> && ...)
+    void ParallelEach(ThreadPool &thread_pool, F &&function);
+
+    // Systems run in the order they were added, except that systems which do not conflict with each other
+    // could run at the same time. Systems must not create or destroy entities, nor add or remove components
+    void AddSystem(SystemAccess access, System system);
+    void RunSystems(float delta_time, ThreadPool *thread_pool = nullptr);
+
+  private:
+    struct EntityRecord {
+        Archetype *archetype;
+        std::uint32_t row;
+        std::uint32_t generation;
+    };
+
+    struct SystemEntry {
+        SystemAccess access;
+        System system;
+    };
+
+    [[nodiscard]] const EntityRecord &Record(Entity entity) const;
+    [[nodiscard]] Entity AllocateEntity();
+    [[nodiscard]] Archetype &ArchetypeOf(std::vector<const ComponentTypeInfo *> types);
+    [[nodiscard]] std::vector<Archetype *> ArchetypesWith(std::span<const ComponentTypeId> type_ids) const;
+    void UpdateRecord(Entity entity, Archetype &archetype, std::size_t row);
+    // Moves the entity into the archetype with the component added or removed, returns its new row
+    std::size_t ChangeArchetype(Entity entity, const ComponentTypeInfo &type, bool is_added);
+    void BuildSystemPhases();
+
+    std::map<std::vector<ComponentTypeId>, std::unique_ptr<Archetype>> archetypes_by_types_;
+    std::vector<Archetype *> archetypes_;
+
+    std::vector<EntityRecord> records_;
+    std::vector<std::uint32_t> free_records_;
+    std::size_t size_;
+
+    std::vector<SystemEntry> systems_;
+    // Indices of systems which could run at the same time, phases themselves run one after another
+    std::vector<std::vector<std::size_t>> system_phases_;
+    bool is_running_systems_;
+};
+
+}  // namespace borov_engine::ecs
+
+#include "world.inl"
+
+#endif  // BOROV_ENGINE_ECS_WORLD_HPP_INCLUDED
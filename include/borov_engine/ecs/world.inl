@@ -0,0 +1,146 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_ECS_WORLD_INL_INCLUDED
+#define BOROV_ENGINE_ECS_WORLD_INL_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../thread_pool.hpp"
+
+namespace borov_engine::ecs {
+
+template <typename... Cs>
+SystemAccess SystemAccess::Of() {
+    SystemAccess access;
+    auto add = [&access]<typename C>(std::type_identity<C>) {
+        auto &type_ids = std::is_const_v<C> ? access.reads : access.writes;
+        type_ids.push_back(ComponentTypeIdOf<C>());
+    };
+    (add(std::type_identity<Cs>{}), ...);
+    std::ranges::sort(access.reads);
+    std::ranges::sort(access.writes);
+    return access;
+}
+
+template <ComponentData... Cs>
+Entity World::CreateEntity(Cs... components) {
+    assert(!is_running_systems_ && "Entities must not be created while systems are running");
+
+    std::vector<const ComponentTypeInfo *> types{&ComponentType<Cs>()...};
+    std::ranges::sort(types, std::ranges::less{}, &ComponentTypeInfo::id);
+    assert(std::ranges::adjacent_find(types) == types.end() && "Entity must not have the same component twice");
+
+    Archetype &archetype = ArchetypeOf(std::move(types));
+    const Entity entity = AllocateEntity();
+    const std::size_t row = archetype.AllocateRow(entity);
+    (::new (archetype.Value(row, archetype.Column(ComponentTypeIdOf<Cs>()))) Cs(std::move(components)), ...);
+    UpdateRecord(entity, archetype, row);
+    return entity;
+}
+
+template <ComponentData C>
+bool World::Has(const Entity entity) const {
+    return Find<C>(entity) != nullptr;
+}
+
+template <ComponentData C>
+const C *World::Find(const Entity entity) const {
+    const EntityRecord &record = Record(entity);
+    const std::size_t column = record.archetype->Column(ComponentTypeIdOf<C>());
+    if (column == Archetype::invalid_column) {
+        return nullptr;
+    }
+    return std::launder(static_cast<const C *>(record.archetype->Value(record.row, column)));
+}
+
+template <ComponentData C>
+C *World::Find(const Entity entity) {
+    return const_cast<C *>(std::as_const(*this).Find<C>(entity));
+}
+
+template <ComponentData C>
+C &World::Add(const Entity entity, C component) {
+    if (C *existing = Find<C>(entity); existing != nullptr) {
+        *existing = std::move(component);
+        return *existing;
+    }
+
+    assert(!is_running_systems_ && "Components must not be added while systems are running");
+    const std::size_t row = ChangeArchetype(entity, ComponentType<C>(), true);
+    const EntityRecord &record = Record(entity);
+    void *value = record.archetype->Value(row, record.archetype->Column(ComponentTypeIdOf<C>()));
+    return *::new (value) C(std::move(component));
+}
+
+template <ComponentData C>
+void World::Remove(const Entity entity) {
+    if (!Has<C>(entity)) {
+        return;
+    }
+
+    assert(!is_running_systems_ && "Components must not be removed while systems are running");
+    ChangeArchetype(entity, ComponentType<C>(), false);
+}
+
+template <typename... Cs, std::invocable<std::span<Cs>...> F>
+    requires(ComponentData<std::remove_const_t<Cs>> && ...)
+void World::EachChunk(F &&function) {
+    const std::array<ComponentTypeId, sizeof...(Cs)> type_ids{ComponentTypeIdOf<Cs>()...};
+    for (Archetype *archetype : ArchetypesWith(type_ids)) {
+        const std::array<std::size_t, sizeof...(Cs)> columns{archetype->Column(ComponentTypeIdOf<Cs>())...};
+        for (std::size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk) {
+            const std::size_t size = archetype->ChunkSize(chunk);
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                function(std::span<Cs>{std::launder(static_cast<Cs *>(archetype->ColumnData(chunk, columns[Is]))),
+                                       size}...);
+            }(std::index_sequence_for<Cs...>{});
+        }
+    }
+}
+
+template <typename... Cs, std::invocable<Cs &...> F>
+    requires(ComponentData<std::remove_const_t<Cs>> && ...)
+void World::Each(F &&function) {
+    EachChunk<Cs...>([&function](std::span<Cs>... columns) {
+        const std::size_t size = (columns.size(), ...);
+        for (std::size_t i = 0; i < size; ++i) {
+            function(columns[i]...);
+        }
+    });
+}
+
+template <typename... Cs, std::invocable<Cs &...> F>
+    requires(ComponentData<std::remove_const_t<Cs>> && ...)
+void World::ParallelEach(ThreadPool &thread_pool, F &&function) {
+    const std::array<ComponentTypeId, sizeof...(Cs)> type_ids{ComponentTypeIdOf<Cs>()...};
+    std::vector<std::pair<Archetype *, std::size_t>> chunks;
+    for (Archetype *archetype : ArchetypesWith(type_ids)) {
+        for (std::size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk) {
+            chunks.emplace_back(archetype, chunk);
+        }
+    }
+
+    thread_pool.ParallelFor(chunks.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+        for (const auto &[archetype, chunk] : std::span{chunks}.subspan(begin, end - begin)) {
+            const std::size_t size = archetype->ChunkSize(chunk);
+            auto column = [&]<typename C>(std::type_identity<C>) {
+                void *data = archetype->ColumnData(chunk, archetype->Column(ComponentTypeIdOf<C>()));
+                return std::launder(static_cast<C *>(data));
+            };
+            const std::tuple<Cs *...> columns{column(std::type_identity<Cs>{})...};
+            for (std::size_t i = 0; i < size; ++i) {
+                std::apply([&](Cs *...values) { function(values[i]...); }, columns);
+            }
+        }
+    });
+}
+
+}  // namespace borov_engine::ecs
+
+#endif  // BOROV_ENGINE_ECS_WORLD_INL_INCLUDED
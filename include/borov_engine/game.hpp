@@ -4,16 +4,25 @@
 #define BOROV_ENGINE_GAME_HPP_INCLUDED
 
 #include <array>
+#include <cassert>
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
+#include "alloc/slab_pool.hpp"
 #include "camera_manager.hpp"
+#include "collision_world.hpp"
 #include "concepts.hpp"
 #include "debug_draw.hpp"
+#include "detail/component_list.hpp"
 #include "detail/d3d_ptr.hpp"
+#include "ecs/world.hpp"
 #include "input.hpp"
 #include "texture_draw.hpp"
+#include "thread_pool.hpp"
 #include "timer.hpp"
+#include "transform_system.hpp"
 #include "viewport_manager.hpp"
 
 namespace borov_engine {
@@ -70,6 +79,20 @@ class Game {
     template <std::derived_from<class TextureDraw> T, typename... Args>
     T &TextureDraw(Args &&...args);
 
+    [[nodiscard]] const ThreadPool &ThreadPool() const;
+    [[nodiscard]] class ThreadPool &ThreadPool();
+
+    [[nodiscard]] const TransformSystem &TransformSystem() const;
+    [[nodiscard]] class TransformSystem &TransformSystem();
+
+    // Every component which is a collision is added on creation, overlaps are found and broadcast after every update
+    [[nodiscard]] const CollisionWorld &CollisionWorld() const;
+    [[nodiscard]] class CollisionWorld &CollisionWorld();
+
+    // Systems of the world run on the thread pool every update, right after the components were updated
+    [[nodiscard]] const ecs::World &World() const;
+    [[nodiscard]] ecs::World &World();
+
     [[nodiscard]] const DirectionalLightComponent &DirectionalLight() const;
     [[nodiscard]] DirectionalLightComponent &DirectionalLight();
 
@@ -101,9 +124,30 @@ class Game {
     template <std::derived_from<Component> T, typename... Args>
     T &AddComponent(Args &&...args);
 
+    // Destroys the component at the end of the frame, so it could be removed even from its own update.
+    // Last component takes the place of the removed one, so the order of components is not preserved
+    void RemoveComponent(const Component &component);
+    void RemoveComponent(ComponentHandle handle);
+
+    // Summed over the pools of every component type created by `AddComponent`
+    [[nodiscard]] alloc::PoolStats ComponentAllocationStats() const;
+
+    // Null if the component was already destroyed
+    [[nodiscard]] const Component *FindComponent(ComponentHandle handle) const;
+    [[nodiscard]] Component *FindComponent(ComponentHandle handle);
+
     [[nodiscard]] ConstComponentRange auto Components() const;
     [[nodiscard]] ComponentRange auto Components();
 
+    // Components which could be cast to every one of the requested types, as pointers or tuples of pointers.
+    // The list is built on the first query and kept up to date by `AddComponent`, so no casts happen after that
+    template <typename... Ts>
+        requires detail::ComponentQuery<Ts...>
+    [[nodiscard]] std::span<const detail::ComponentListElement<const Ts...>> ComponentsOfType() const;
+    template <typename... Ts>
+        requires detail::ComponentQuery<Ts...>
+    [[nodiscard]] std::span<const detail::ComponentListElement<Ts...>> ComponentsOfType();
+
     void Run();
     void Exit();
 
@@ -136,6 +180,35 @@ class Game {
 
     void UpdateShadowMapConstantBuffer(const ShadowMapConstantBuffer &data);
 
+    struct ComponentDeleter {
+        alloc::SlabPool *pool;
+        void *memory;
+
+        void operator()(Component *component) const;
+    };
+    using ComponentPtr = std::unique_ptr<Component, ComponentDeleter>;
+
+    struct UpdatePhase {
+        std::int32_t phase;
+        std::vector<Component *> parallel_components;
+        std::vector<Component *> sequential_components;
+    };
+
+    struct ComponentSlot {
+        Component *component;
+        std::uint32_t index;
+        std::uint32_t generation;
+        bool is_removed;
+    };
+
+    alloc::SlabPool &ComponentPool(std::type_index type, std::size_t size, std::size_t alignment);
+    void RegisterComponent(Component &component);
+    void DestroyRemovedComponents();
+    void BuildUpdatePhases();
+
+    template <typename... Ts>
+    detail::TypedComponentList<Ts...> &ComponentListOf() const;
+
     void UpdateInternal(float delta_time);
     void DrawInternal();
     void OnWindowResize(WindowResizeData data);
@@ -143,6 +216,12 @@ class Game {
     class Window &window_;
     class Input &input_;
 
+    class ThreadPool thread_pool_;
+    // Must outlive every scene component, including the lights below
+    class TransformSystem transform_system_;
+    ecs::World world_;
+    class CollisionWorld collision_world_;
+
     std::unique_ptr<class ViewportManager> viewport_manager_;
     std::unique_ptr<class CameraManager> camera_manager_;
     std::unique_ptr<class DebugDraw> debug_draw_;
@@ -151,7 +230,17 @@ class Game {
     std::unique_ptr<DirectionalLightComponent> directional_light_;
     std::unique_ptr<PointLightComponent> point_light_;
     std::unique_ptr<SpotLightComponent> spot_light_;
-    std::vector<std::unique_ptr<Component>> components_;
+    // Components of the same type are allocated next to each other, pools must outlive the components
+    std::unordered_map<std::type_index, alloc::SlabPool> component_pools_;
+    std::vector<ComponentPtr> components_;
+    std::vector<ComponentSlot> component_slots_;
+    std::vector<std::uint32_t> free_component_slots_;
+    std::vector<ComponentHandle> removed_components_;
+    std::vector<UpdatePhase> update_phases_;
+    bool is_update_order_dirty_;
+    // Set while parallel safe components are updated on the thread pool, when nothing shared may be modified
+    bool is_parallel_update_;
+    mutable std::unordered_map<std::type_index, std::unique_ptr<detail::ComponentList>> component_lists_;
 
     detail::D3DPtr<ID3D11Buffer> shadow_map_constant_buffer_;
     detail::D3DPtr<ID3D11GeometryShader> shadow_map_geometry_shader_;
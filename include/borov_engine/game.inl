@@ -35,20 +35,64 @@ T &Game::TextureDraw(Args &&...args) {
 
 template <std::derived_from<Component> T, typename... Args>
 T &Game::AddComponent(Args &&...args) {
-    auto &component = components_.emplace_back(std::make_unique<T>(*this, std::forward<Args>(args)...));
-    return dynamic_cast<T &>(*component);
+    alloc::SlabPool &pool = ComponentPool(typeid(T), sizeof(T), alignof(T));
+    void *memory = pool.Allocate();
+
+    T *component;
+    try {
+        component = ::new (memory) T(*this, std::forward<Args>(args)...);
+    } catch (...) {
+        pool.Deallocate(memory);
+        throw;
+    }
+
+    components_.push_back(ComponentPtr{component, ComponentDeleter{.pool = &pool, .memory = memory}});
+    RegisterComponent(*component);
+    return *component;
 }
 
 inline ConstComponentRange auto Game::Components() const {
-    auto unique_ptr_to_ref = [](const std::unique_ptr<Component> &component) { return std::cref(*component); };
+    auto unique_ptr_to_ref = [](const ComponentPtr &component) { return std::cref(*component); };
     return components_ | std::ranges::views::transform(unique_ptr_to_ref);
 }
 
 inline ComponentRange auto Game::Components() {
-    auto unique_ptr_to_ref = [](const std::unique_ptr<Component> &component) { return std::ref(*component); };
+    auto unique_ptr_to_ref = [](const ComponentPtr &component) { return std::ref(*component); };
     return components_ | std::ranges::views::transform(unique_ptr_to_ref);
 }
 
+template <typename... Ts>
+    requires detail::ComponentQuery<Ts...>
+std::span<const detail::ComponentListElement<const Ts...>> Game::ComponentsOfType() const {
+    return ComponentListOf<const Ts...>().Elements();
+}
+
+template <typename... Ts>
+    requires detail::ComponentQuery<Ts...>
+std::span<const detail::ComponentListElement<Ts...>> Game::ComponentsOfType() {
+    return ComponentListOf<Ts...>().Elements();
+}
+
+template <typename... Ts>
+detail::TypedComponentList<Ts...> &Game::ComponentListOf() const {
+    // Lookup is safe on every thread, but the map is shared, so no list is created during the parallel update
+    if (is_parallel_update_) {
+        const auto iterator = component_lists_.find(typeid(detail::ComponentQueryTag<Ts...>));
+        assert(iterator != component_lists_.end() && "Component list must be queried before the parallel update");
+        return static_cast<detail::TypedComponentList<Ts...> &>(*iterator->second);
+    }
+
+    auto [iterator, is_inserted] = component_lists_.try_emplace(typeid(detail::ComponentQueryTag<Ts...>));
+    auto &component_list = iterator->second;
+    if (is_inserted) {
+        component_list = std::make_unique<detail::TypedComponentList<Ts...>>();
+        for (const ComponentPtr &component : components_) {
+            component_list->TryAdd(*component);
+        }
+    }
+    return static_cast<detail::TypedComponentList<Ts...> &>(*component_list);
+}
+
 }  // namespace borov_engine
 
 #endif  // BOROV_ENGINE_GAME_INL_INCLUDED
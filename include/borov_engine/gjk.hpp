@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_GJK_HPP_INCLUDED
+#define BOROV_ENGINE_GJK_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+
+#include "convex_shape.hpp"
+#include "math.hpp"
+
+namespace borov_engine {
+
+// Simplex of the Minkowski difference `lhs - rhs` where the last query stopped. Kept by the caller between frames
+// for the same pair of shapes, so the next query starts from it: only the search directions are reused,
+// which makes it valid for any motion, and for persistent contacts GJK finishes in one or two iterations.
+// Empty simplex starts the query from scratch
+struct GjkSimplex {
+    static constexpr std::size_t max_size = 4;
+
+    struct Vertex {
+        math::Vector3 direction;
+        math::Vector3 point;
+        math::Vector3 lhs_point;
+        math::Vector3 rhs_point;
+    };
+
+    std::array<Vertex, max_size> vertices;
+    std::size_t size = 0;
+};
+
+struct ConvexDistance {
+    float distance;
+    math::Vector3 lhs_point;
+    math::Vector3 rhs_point;
+};
+
+struct ContactPoint {
+    // On the surface of the second shape
+    math::Vector3 position;
+    float depth;
+};
+
+struct ContactManifold {
+    static constexpr std::size_t max_point_count = 4;
+
+    // From the first shape to the second one: moving the second shape along it by the depth separates them
+    math::Vector3 normal;
+    // Penetration of the deepest point
+    float depth;
+    std::array<ContactPoint, max_point_count> points;
+    std::size_t point_count = 0;
+};
+
+// GJK test of the overlap, touching shapes overlap
+[[nodiscard]] bool Intersects(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex);
+
+// GJK distance between the shapes and their closest points. Returns false if the shapes overlap,
+// the result is not written then
+[[nodiscard]] bool ClosestPoints(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex,
+                                 ConvexDistance &result);
+
+// EPA penetration of the overlapping shapes. The deepest point is found first, the rest of the manifold is
+// collected by tilting the second shape slightly around it, so faces and edges resting on each other produce
+// several points. Returns false if the shapes are separated, the manifold is not written then
+[[nodiscard]] bool Contact(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex,
+                           ContactManifold &manifold);
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_GJK_HPP_INCLUDED
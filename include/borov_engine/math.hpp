@@ -57,6 +57,11 @@ std::array<Vector3, Frustum::CORNER_COUNT> Corners(const Frustum &frustum);
 
 Vector3 FrustumCenter(const Frustum &frustum);
 
+// Point of the box nearest to the given one, which is the point itself if it is inside
+Vector3 ClosestPoint(const AxisAlignedBox &box, const Vector3 &point);
+// Distance between the nearest points of the boxes, zero if they intersect
+float Distance(const AxisAlignedBox &lhs, const AxisAlignedBox &rhs);
+
 struct Triangle {
     Vector3 point0;
     Vector3 point1;
@@ -68,6 +73,9 @@ struct Triangle {
 
     [[nodiscard]] Plane Plane() const;
 
+    // Point of the triangle nearest to the given one, found by the region of the triangle the point projects onto
+    [[nodiscard]] Vector3 ClosestPoint(const Vector3 &point) const;
+
     [[nodiscard]] bool Intersects(const AxisAlignedBox &axis_aligned_box) const;
     [[nodiscard]] bool Intersects(const Box &box) const;
     [[nodiscard]] bool Intersects(Sphere sphere) const;
@@ -3,6 +3,9 @@
 #ifndef BOROV_ENGINE_MESH_COMPONENT_HPP_INCLUDED
 #define BOROV_ENGINE_MESH_COMPONENT_HPP_INCLUDED
 
+#include <optional>
+
+#include "collision_proxy.hpp"
 #include "triangle_component.hpp"
 
 namespace borov_engine {
@@ -15,11 +18,21 @@ class MeshComponent : public SceneComponent {
 
     struct Initializer : SceneComponent::Initializer {
         std::filesystem::path mesh_path;
+        // Collision proxy is imported together with the mesh only if the options are given
+        std::optional<CollisionProxyOptions> proxy_options;
     };
 
     explicit MeshComponent(class Game &game, const Initializer &initializer);
 
     void LoadMesh(const std::filesystem::path &mesh_path);
+
+    // Shapes fitted to all the vertices of the mesh in the space of this component,
+    // so they are placed into the world by its world matrix. Empty unless requested by the initializer
+    [[nodiscard]] const CollisionProxy &Proxy() const;
+
+  private:
+    std::optional<CollisionProxyOptions> proxy_options_;
+    CollisionProxy proxy_;
 };
 
 }  // namespace borov_engine
@@ -119,11 +119,43 @@ void TraverseNode(Game &game, const SceneComponent &parent, const aiScene &scene
     }
 }
 
+// Vertices of every mesh moved by the transformations of the nodes, the same way as the child components are
+inline void CollectGeometry(const aiScene &scene, const aiNode &node, const aiMatrix4x4 &parent_transformation,
+                            std::vector<math::Vector3> &vertices, std::vector<CollisionProxy::Index> &indices) {
+    const aiMatrix4x4 transformation = parent_transformation * node.mTransformation;
+
+    for (const std::size_t mesh_index : std::span{node.mMeshes, node.mNumMeshes}) {
+        const aiMesh *mesh = scene.mMeshes[mesh_index];
+        if (mesh == nullptr) {
+            continue;
+        }
+
+        const auto first_vertex = static_cast<CollisionProxy::Index>(vertices.size());
+        for (const aiVector3D &ai_position : std::span{mesh->mVertices, mesh->mNumVertices}) {
+            const auto [x, y, z] = transformation * ai_position;
+            vertices.emplace_back(x, y, z);
+        }
+        for (const std::span faces{mesh->mFaces, mesh->mNumFaces}; const aiFace &face : faces) {
+            if (face.mNumIndices < 3) {
+                continue;
+            }
+            for (const std::uint32_t index : std::span{face.mIndices, 3}) {
+                indices.emplace_back(first_vertex + index);
+            }
+        }
+    }
+
+    for (const aiNode *child_node : std::span{node.mChildren, node.mNumChildren}) {
+        CollectGeometry(scene, *child_node, transformation, vertices, indices);
+    }
+}
+
 }  // namespace detail
 
 template <std::derived_from<TriangleComponent> ChildMesh>
 MeshComponent<ChildMesh>::MeshComponent(class Game &game, const Initializer &initializer)
-    : SceneComponent(game, initializer) {
+    : SceneComponent(game, initializer),
+      proxy_options_{initializer.proxy_options} {
     LoadMesh(initializer.mesh_path);
 }
 
@@ -143,9 +175,21 @@ void MeshComponent<ChildMesh>::LoadMesh(const std::filesystem::path &mesh_path)
 
     if (const aiNode *node = scene->mRootNode) {
         detail::TraverseNode<ChildMesh>(Game(), *this, *scene, *node, mesh_path);
+
+        if (proxy_options_) {
+            std::vector<math::Vector3> vertices;
+            std::vector<CollisionProxy::Index> indices;
+            detail::CollectGeometry(*scene, *node, aiMatrix4x4{}, vertices, indices);
+            proxy_ = CollisionProxy::Import(mesh_path, vertices, indices, *proxy_options_);
+        }
     }
 }
 
+template <std::derived_from<TriangleComponent> ChildMesh>
+const CollisionProxy &MeshComponent<ChildMesh>::Proxy() const {
+    return proxy_;
+}
+
 }  // namespace borov_engine
 
 #endif  // BOROV_ENGINE_MESH_COMPONENT_INL_INCLUDED
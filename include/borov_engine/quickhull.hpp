@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_QUICKHULL_HPP_INCLUDED
+#define BOROV_ENGINE_QUICKHULL_HPP_INCLUDED
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+
+namespace borov_engine {
+
+// Convex hull of the points built with quickhull: the hull grows from the largest tetrahedron
+// by the farthest point outside of some face, until no point is outside of any face
+class Quickhull {
+  public:
+    using Index = std::uint32_t;
+    using VertexCollection = std::vector<math::Vector3>;
+    using IndexCollection = std::vector<Index>;
+
+    explicit Quickhull() = default;
+    // Flat or smaller inputs have no volume, then all the points are kept as vertices without any triangles
+    explicit Quickhull(std::span<const math::Vector3> points);
+    // Adopts the hull built before, like the one loaded from the cache, without checking its convexity
+    explicit Quickhull(VertexCollection &&vertices, IndexCollection &&indices);
+
+    // Only the points on the hull
+    [[nodiscard]] std::span<const math::Vector3> Vertices() const;
+    // Triangles of the hull wound counter-clockwise when seen from outside
+    [[nodiscard]] std::span<const Index> Indices() const;
+    [[nodiscard]] float Volume() const;
+
+  private:
+    VertexCollection vertices_;
+    IndexCollection indices_;
+    float volume_ = 0.0f;
+};
+
+// Makes the hull usable by GJK and EPA as is, the hull must have at least one vertex
+[[nodiscard]] math::Vector3 Support(const Quickhull &hull, const math::Vector3 &direction);
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_QUICKHULL_HPP_INCLUDED
@@ -0,0 +1,50 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_RAY_PACKET_HPP_INCLUDED
+#define BOROV_ENGINE_RAY_PACKET_HPP_INCLUDED
+
+#include <cstdint>
+#include <span>
+
+#include "math.hpp"
+#include "triangle_packets.hpp"
+
+namespace borov_engine {
+
+// Several rays traced together, one per SIMD lane: every test of the packet costs about as much as the test
+// of a single ray. Works best for coherent rays, like the ones cast from the same point in similar directions
+class RayPacket {
+  public:
+    static constexpr std::size_t width = TrianglePackets::width;
+
+    using Lanes = TrianglePackets::Lanes;
+    // Bit of every lane which passed the test
+    using Mask = std::uint32_t;
+
+    // At most the width of rays, the rest of the lanes are inactive and never hit anything
+    explicit RayPacket(std::span<const math::Ray> rays);
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] Mask ActiveMask() const;
+    [[nodiscard]] math::Ray Ray(std::size_t lane) const;
+
+    // Slab test, entries of the lanes which hit the box not farther than their max distances are written
+    [[nodiscard]] Mask Intersects(const math::AxisAlignedBox &box, const Lanes &max_distances, Lanes &entries) const;
+    [[nodiscard]] Mask Intersects(const math::Vector3 &min, const math::Vector3 &max, const Lanes &max_distances,
+                                  Lanes &entries) const;
+    // Slab test in the space of the box
+    [[nodiscard]] Mask Intersects(const math::Box &box, const Lanes &max_distances, Lanes &entries) const;
+    // Möller–Trumbore test of both sides of the triangle, which also yields barycentric coordinates of the hits
+    [[nodiscard]] Mask Intersects(const math::Triangle &triangle, const Lanes &max_distances, Lanes &distances,
+                                  Lanes &us, Lanes &vs) const;
+
+  private:
+    std::array<Lanes, 3> origin_;
+    std::array<Lanes, 3> direction_;
+    std::array<Lanes, 3> inverse_direction_;
+    std::size_t size_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_RAY_PACKET_HPP_INCLUDED
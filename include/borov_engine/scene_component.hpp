@@ -6,6 +6,7 @@
 #include "component.hpp"
 #include "concepts.hpp"
 #include "transform.hpp"
+#include "transform_system.hpp"
 
 namespace borov_engine {
 
@@ -14,6 +15,38 @@ class SceneComponent;
 template <typename Range>
 concept SceneComponentRange = RefWrapperRange<Range, const SceneComponent>;
 
+namespace detail {
+
+enum class SceneTraversal : std::uint8_t {
+    Parents,
+    DirectChildren,
+    Children,
+};
+
+template <SceneTraversal Traversal>
+class SceneComponentIterator {
+  public:
+    using value_type = std::reference_wrapper<const SceneComponent>;
+    using difference_type = std::ptrdiff_t;
+
+    SceneComponentIterator() = default;
+    explicit SceneComponentIterator(const SceneComponent *current, const SceneComponent *root);
+
+    value_type operator*() const;
+
+    SceneComponentIterator &operator++();
+    SceneComponentIterator operator++(int);
+
+    bool operator==(const SceneComponentIterator &other) const;
+    bool operator==(std::default_sentinel_t) const;
+
+  private:
+    const SceneComponent *current_ = nullptr;
+    const SceneComponent *root_ = nullptr;
+};
+
+}  // namespace detail
+
 class SceneComponent : public Component {
   public:
     struct Initializer : Component::Initializer {
@@ -22,13 +55,20 @@ class SceneComponent : public Component {
     };
 
     explicit SceneComponent(class Game &game, const Initializer &initializer = {});
+    ~SceneComponent() override;
 
-    [[nodiscard]] const Transform &Transform() const;
-    [[nodiscard]] class Transform &Transform();
+    [[nodiscard]] class Transform Transform() const;
+    // Marks world transform of this component and all of its children as dirty, so read-only code
+    // should call the const overload instead, e.g. through `std::as_const`.
+    // The reference points into the transform system of the game, so it must not be kept
+    // after world transform of this component was queried or any other scene component was added
+    [[nodiscard]] TransformReference Transform();
 
     [[nodiscard]] class Transform WorldTransform() const;
     void WorldTransform(const class Transform &world_transform);
 
+    [[nodiscard]] math::Matrix4x4 WorldMatrix() const;
+
     [[nodiscard]] const SceneComponent *Parent() const;
     bool Parent(const SceneComponent *parent);
 
@@ -37,12 +77,32 @@ class SceneComponent : public Component {
     [[nodiscard]] bool IsChildOf(const SceneComponent &scene_component,
                                  std::size_t max_depth = (std::numeric_limits<decltype(max_depth)>::max)()) const;
 
+    // All the parents of this component, from the nearest one up to the root
     [[nodiscard]] SceneComponentRange auto Parents() const;
+    // All the children of this component in depth-first order, i.e. the whole subtree except the component itself.
+    // Siblings are visited in the order they were attached to their parent
     [[nodiscard]] SceneComponentRange auto Children() const;
+    // Only the children which have this component as their parent, in the order they were attached to it
+    [[nodiscard]] SceneComponentRange auto DirectChildren() const;
 
   private:
-    class Transform transform_;
+    template <detail::SceneTraversal Traversal>
+    friend class detail::SceneComponentIterator;
+
+    void LinkToParent() const;
+    void UnlinkFromParent() const;
+
+    void MarkWorldTransformDirty();
+
+    TransformSystem::Handle transform_handle_;
     const SceneComponent *parent_;
+
+    // Intrusive list of direct children, which could be modified through pointer to const parent.
+    // New children are appended to the tail, so the list keeps the order of attachment
+    mutable const SceneComponent *first_child_;
+    mutable const SceneComponent *last_child_;
+    mutable const SceneComponent *prev_sibling_;
+    mutable const SceneComponent *next_sibling_;
 };
 
 }  // namespace borov_engine
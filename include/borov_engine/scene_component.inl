@@ -9,28 +9,66 @@ namespace borov_engine {
 
 namespace detail {
 
-inline SceneComponentRange auto SceneComponents(const Game &game) {
-    auto is_scene = [](const Component &component) {
-        const auto as_scene_component = dynamic_cast<const SceneComponent *>(&component);
-        return as_scene_component != nullptr;
-    };
-    auto to_scene = [](const Component &component) {
-        const auto &scene_component = dynamic_cast<const SceneComponent &>(component);
-        return std::cref(scene_component);
-    };
-    return game.Components() | std::views::filter(is_scene) | std::views::transform(to_scene);
+template <SceneTraversal Traversal>
+SceneComponentIterator<Traversal>::SceneComponentIterator(const SceneComponent *current, const SceneComponent *root)
+    : current_{current}, root_{root} {}
+
+template <SceneTraversal Traversal>
+auto SceneComponentIterator<Traversal>::operator*() const -> value_type {
+    return std::cref(*current_);
+}
+
+template <SceneTraversal Traversal>
+auto SceneComponentIterator<Traversal>::operator++() -> SceneComponentIterator & {
+    if constexpr (Traversal == SceneTraversal::Parents) {
+        current_ = current_->parent_;
+    } else if constexpr (Traversal == SceneTraversal::DirectChildren) {
+        current_ = current_->next_sibling_;
+    } else {
+        if (current_->first_child_ != nullptr) {
+            current_ = current_->first_child_;
+            return *this;
+        }
+        while (current_ != root_ && current_->next_sibling_ == nullptr) {
+            current_ = current_->parent_;
+        }
+        current_ = (current_ != root_) ? current_->next_sibling_ : nullptr;
+    }
+    return *this;
+}
+
+template <SceneTraversal Traversal>
+auto SceneComponentIterator<Traversal>::operator++(int) -> SceneComponentIterator {
+    SceneComponentIterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template <SceneTraversal Traversal>
+bool SceneComponentIterator<Traversal>::operator==(const SceneComponentIterator &other) const {
+    return current_ == other.current_;
+}
+
+template <SceneTraversal Traversal>
+bool SceneComponentIterator<Traversal>::operator==(std::default_sentinel_t) const {
+    return current_ == nullptr;
 }
 
 }  // namespace detail
 
 inline SceneComponentRange auto SceneComponent::Parents() const {
-    auto is_child_of = [this](const SceneComponent &scene_component) { return IsChildOf(scene_component); };
-    return detail::SceneComponents(Game()) | std::views::filter(is_child_of);
+    using Iterator = detail::SceneComponentIterator<detail::SceneTraversal::Parents>;
+    return std::ranges::subrange{Iterator{parent_, this}, std::default_sentinel};
 }
 
 inline SceneComponentRange auto SceneComponent::Children() const {
-    auto is_parent_of = [this](const SceneComponent &scene_component) { return IsParentOf(scene_component); };
-    return detail::SceneComponents(Game()) | std::views::filter(is_parent_of);
+    using Iterator = detail::SceneComponentIterator<detail::SceneTraversal::Children>;
+    return std::ranges::subrange{Iterator{first_child_, this}, std::default_sentinel};
+}
+
+inline SceneComponentRange auto SceneComponent::DirectChildren() const {
+    using Iterator = detail::SceneComponentIterator<detail::SceneTraversal::DirectChildren>;
+    return std::ranges::subrange{Iterator{first_child_, this}, std::default_sentinel};
 }
 
 }  // namespace borov_engine
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_SWEEP_AND_PRUNE_BROAD_PHASE_HPP_INCLUDED
+#define BOROV_ENGINE_SWEEP_AND_PRUNE_BROAD_PHASE_HPP_INCLUDED
+
+#include <array>
+#include <unordered_set>
+
+#include "broad_phase.hpp"
+
+namespace borov_engine {
+
+// Keeps endpoints of the bounds sorted along the chosen axes. Bodies move only a little between updates,
+// so the insertion sort is nearly linear. Suits scenes spread over a plane, queries are linear in the proxy count
+class SweepAndPruneBroadPhase final : public BroadPhase {
+  public:
+    enum class Axes : std::uint8_t {
+        // Endpoints are sorted along the axis and swept by every update,
+        // which is cheap while only a few intervals along the axis overlap at once
+        X,
+        Y,
+        Z,
+        // Every swap of endpoints along any axis tells exactly which pair began or ended to overlap,
+        // so the cost depends on how much the bodies move instead of how many of them there are
+        All,
+    };
+
+    explicit SweepAndPruneBroadPhase(Axes axes = Axes::All);
+
+    [[nodiscard]] ProxyId Add(const math::AxisAlignedBox &bounds) override;
+    void Move(ProxyId proxy, const math::AxisAlignedBox &bounds) override;
+
+    [[nodiscard]] std::size_t Size() const override;
+
+    using BroadPhase::Query;
+    void Query(const math::AxisAlignedBox &region, const QueryFunction &function) const override;
+    void Query(const math::Ray &ray, float max_distance, const QueryFunction &function) const override;
+
+  protected:
+    void RemoveProxy(ProxyId proxy) override;
+    void FindPairs(std::vector<ProxyPair> &pairs) override;
+
+  private:
+    using Index = std::uint32_t;
+    static constexpr std::size_t max_axis_count = 3;
+
+    // Left in place of the endpoints of proxies removed before the sort
+    static constexpr std::uint32_t removed_endpoint = (std::numeric_limits<std::uint32_t>::max)();
+
+    struct Endpoint {
+        float value;
+        // Proxy in the upper bits, whether it is the maximum in the lowest one
+        std::uint32_t data;
+
+        [[nodiscard]] ProxyId Proxy() const;
+        [[nodiscard]] bool IsMax() const;
+        // Minimum goes first on ties, so touching bounds overlap like in the rest of the collision code
+        [[nodiscard]] bool operator<(const Endpoint &other) const;
+    };
+
+    struct Proxy {
+        std::array<float, max_axis_count> min;
+        std::array<float, max_axis_count> max;
+        // Positions of the minimum and maximum endpoints in the arrays of the tracked axes
+        std::array<std::array<Index, 2>, max_axis_count> endpoints;
+        bool is_free;
+    };
+
+    [[nodiscard]] static std::uint64_t Key(ProxyId lhs, ProxyId rhs);
+    [[nodiscard]] static bool Overlaps(const Proxy &lhs, const Proxy &rhs);
+
+    // Also updates values of the endpoints, but does not move them
+    void SetBounds(ProxyId proxy, const math::AxisAlignedBox &bounds);
+    // Sorts the endpoints from scratch, pairs along every axis are found again by the sweep
+    void Sort();
+    void Sweep(std::vector<ProxyPair> &pairs);
+    // Moves the endpoint to its sorted place, adding or removing the pairs whose order changed
+    void SortDown(std::size_t axis, Index index);
+    void SortUp(std::size_t axis, Index index);
+    void OnSwap(const Endpoint &moved, const Endpoint &passed, bool is_moving_down);
+
+    std::array<std::size_t, max_axis_count> axes_;
+    std::size_t axis_count_;
+    std::array<std::vector<Endpoint>, max_axis_count> endpoints_;
+    std::vector<Proxy> proxies_;
+    std::vector<ProxyId> free_proxies_;
+    // Pairs overlapping along every axis, only updated when every axis is sorted
+    std::unordered_set<std::uint64_t> tracked_pairs_;
+    std::vector<ProxyPair> swept_pairs_;
+    std::vector<ProxyId> open_proxies_;
+    bool is_sorted_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_SWEEP_AND_PRUNE_BROAD_PHASE_HPP_INCLUDED
@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_THREAD_POOL_HPP_INCLUDED
+#define BOROV_ENGINE_THREAD_POOL_HPP_INCLUDED
+
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace borov_engine {
+
+class ThreadPool {
+  public:
+    // Creates one worker less than there are hardware threads, because the calling thread participates too
+    explicit ThreadPool();
+    explicit ThreadPool(std::size_t worker_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    [[nodiscard]] std::size_t WorkerCount() const;
+
+    // Calls `function(begin, end)` for disjoint chunks of [0, count) on the workers and the calling thread.
+    // Returns only after the whole range was processed, so the function could capture anything by reference.
+    // If the function throws, chunks not started yet are skipped, and the first exception is rethrown here
+    // once the running chunks finish
+    template <std::invocable<std::size_t, std::size_t> F>
+    void ParallelFor(std::size_t count, std::size_t min_chunk_size, F &&function);
+
+  private:
+    void Submit(std::function<void()> task);
+    void WorkerLoop(const std::stop_token &stop_token);
+
+    std::mutex mutex_;
+    std::condition_variable_any condition_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::jthread> workers_;
+};
+
+}  // namespace borov_engine
+
+#include "thread_pool.inl"
+
+#endif  // BOROV_ENGINE_THREAD_POOL_HPP_INCLUDED
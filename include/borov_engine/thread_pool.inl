@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_THREAD_POOL_INL_INCLUDED
+#define BOROV_ENGINE_THREAD_POOL_INL_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace borov_engine {
+
+template <std::invocable<std::size_t, std::size_t> F>
+void ThreadPool::ParallelFor(const std::size_t count, const std::size_t min_chunk_size, F &&function) {
+    if (count == 0) {
+        return;
+    }
+
+    // Several chunks per thread, so threads which finished early could help the slower ones
+    const std::size_t thread_count = workers_.size() + 1;
+    const std::size_t chunk_size = std::max({min_chunk_size, count / (thread_count * 4), std::size_t{1}});
+    const std::size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    if (chunk_count == 1 || workers_.empty()) {
+        function(std::size_t{0}, count);
+        return;
+    }
+
+    struct Job {
+        std::atomic_size_t next_chunk;
+        std::atomic_size_t finished_chunks;
+        std::atomic_bool is_finished;
+        std::atomic_flag has_exception;
+        std::exception_ptr exception;
+    };
+    const auto job = std::make_shared<Job>();
+
+    // Helper could start after the job was finished, so it must not touch the function unless it got a chunk
+    auto run = [job, &function, count, chunk_size, chunk_count] {
+        for (std::size_t chunk = job->next_chunk++; chunk < chunk_count; chunk = job->next_chunk++) {
+            const std::size_t begin = chunk * chunk_size;
+            std::size_t finished_chunks = 1;
+            try {
+                function(begin, std::min(begin + chunk_size, count));
+            } catch (...) {
+                // First exception is kept for the calling thread, and the chunks nobody claimed yet are skipped
+                if (!job->has_exception.test_and_set()) {
+                    job->exception = std::current_exception();
+                }
+                const std::size_t next_chunk = job->next_chunk.exchange(chunk_count);
+                finished_chunks += chunk_count - std::min(next_chunk, chunk_count);
+            }
+            if (job->finished_chunks.fetch_add(finished_chunks) + finished_chunks == chunk_count) {
+                job->is_finished = true;
+                job->is_finished.notify_one();
+            }
+        }
+    };
+
+    const std::size_t helper_count = std::min(workers_.size(), chunk_count - 1);
+    for (std::size_t helper = 0; helper < helper_count; ++helper) {
+        Submit(run);
+    }
+    run();
+    job->is_finished.wait(false);
+    if (job->exception != nullptr) {
+        std::rethrow_exception(job->exception);
+    }
+}
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_THREAD_POOL_INL_INCLUDED
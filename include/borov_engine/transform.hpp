@@ -3,10 +3,15 @@
 #ifndef BOROV_ENGINE_TRANSFORM_HPP_INCLUDED
 #define BOROV_ENGINE_TRANSFORM_HPP_INCLUDED
 
+#include <span>
+
 #include "math.hpp"
 
 namespace borov_engine {
 
+struct TransformSpan;
+struct ConstTransformSpan;
+
 struct Transform {
     alignas(16) math::Vector3 position;
     alignas(16) math::Quaternion rotation;
@@ -21,6 +26,18 @@ struct Transform {
     static void Inverse(const Transform &transform, Transform &result);
     static Transform Inverse(const Transform &transform);
 
+    // Batch versions process four transforms at once with SSE where it is available.
+    // All the spans must have the same size, results may alias the inputs only element-wise
+    static void ConcatenateBatch(std::span<const Transform> parents, std::span<const Transform> children,
+                                 std::span<Transform> results);
+    static void InverseBatch(std::span<const Transform> transforms, std::span<Transform> results);
+    static void ToMatrixBatch(std::span<const Transform> transforms, std::span<math::Matrix4x4> matrices);
+
+    // Same as above for transforms stored as separate arrays of positions, rotations and scales
+    static void ConcatenateBatch(const ConstTransformSpan &parents, const ConstTransformSpan &children,
+                                 const TransformSpan &results);
+    static void ToMatrixBatch(const ConstTransformSpan &transforms, std::span<math::Matrix4x4> matrices);
+
     [[nodiscard]] math::Vector3 Right() const;
     [[nodiscard]] math::Vector3 Up() const;
     [[nodiscard]] math::Vector3 Forward() const;
@@ -28,6 +45,47 @@ struct Transform {
     void RotateAround(const math::Vector3 &point, const math::Quaternion &rotate_by);
 };
 
+// Transform whose position, rotation and scale are stored apart, e.g. in the arrays of the transform system.
+// Could be used mostly as `Transform &`: members refer to the stored values and assignment writes through them
+struct TransformReference {
+    math::Vector3 &position;
+    math::Quaternion &rotation;
+    math::Vector3 &scale;
+
+    TransformReference &operator=(const Transform &transform);
+    TransformReference &operator=(const TransformReference &other);
+
+    [[nodiscard]] operator Transform() const;
+
+    [[nodiscard]] math::Matrix4x4 ToMatrix() const;
+    [[nodiscard]] math::Matrix4x4 ViewMatrix() const;
+
+    [[nodiscard]] math::Vector3 Right() const;
+    [[nodiscard]] math::Vector3 Up() const;
+    [[nodiscard]] math::Vector3 Forward() const;
+
+    void RotateAround(const math::Vector3 &point, const math::Quaternion &rotate_by);
+};
+
+// Structure of arrays of transforms, every span has the same size
+struct TransformSpan {
+    std::span<math::Vector3> positions;
+    std::span<math::Quaternion> rotations;
+    std::span<math::Vector3> scales;
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] TransformSpan Subspan(std::size_t offset, std::size_t count) const;
+};
+
+struct ConstTransformSpan {
+    std::span<const math::Vector3> positions;
+    std::span<const math::Quaternion> rotations;
+    std::span<const math::Vector3> scales;
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] ConstTransformSpan Subspan(std::size_t offset, std::size_t count) const;
+};
+
 }  // namespace borov_engine
 
 #endif  // BOROV_ENGINE_TRANSFORM_HPP_INCLUDED
@@ -0,0 +1,104 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_TRANSFORM_SYSTEM_HPP_INCLUDED
+#define BOROV_ENGINE_TRANSFORM_SYSTEM_HPP_INCLUDED
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "transform.hpp"
+
+namespace borov_engine {
+
+class ThreadPool;
+
+// Contiguous storage of local and world transforms of the whole scene hierarchy.
+// Positions, rotations and scales are kept in separate arrays. Every array is indexed the same way and sorted
+// so that parents always come before their children, which allows to compute all the world transforms
+// and matrices in one linear pass.
+// Independent subtrees are also stored contiguously, so the pass could be split between several threads.
+class TransformSystem {
+  public:
+    using Handle = std::uint32_t;
+    static constexpr Handle invalid_handle = (std::numeric_limits<Handle>::max)();
+
+    enum class UpdateMode : std::uint8_t {
+        Sequential,
+        // Requires a thread pool, falls back to sequential update otherwise. Results are exactly the same
+        Parallel,
+    };
+
+    explicit TransformSystem(ThreadPool *thread_pool = nullptr);
+
+    [[nodiscard]] Handle Add(const Transform &transform, Handle parent = invalid_handle);
+    void Remove(Handle handle);
+
+    [[nodiscard]] std::size_t Size() const;
+
+    [[nodiscard]] const UpdateMode &Mode() const;
+    [[nodiscard]] UpdateMode &Mode();
+
+    [[nodiscard]] Transform LocalTransform(Handle handle) const;
+    // References are invalidated by `Add` and `Update`, so they must not be stored
+    [[nodiscard]] TransformReference LocalTransform(Handle handle);
+
+    [[nodiscard]] Handle Parent(Handle handle) const;
+    // Does not mark anything as dirty, the caller is expected to update the local transform right after
+    void Parent(Handle handle, Handle parent);
+
+    [[nodiscard]] Transform WorldTransform(Handle handle) const;
+    [[nodiscard]] const math::Matrix4x4 &WorldMatrix(Handle handle) const;
+
+    // Children are not tracked here, so the caller is responsible for marking the whole subtree as dirty
+    [[nodiscard]] bool IsWorldTransformDirty(Handle handle) const;
+    void MarkWorldTransformDirty(Handle handle);
+
+    // Recomputes world transforms and matrices of all the dirty entries in one pass
+    void Update();
+
+  private:
+    using Index = std::uint32_t;
+    static constexpr Index invalid_index = (std::numeric_limits<Index>::max)();
+
+    enum Flags : std::uint8_t {
+        world_transform_dirty = 1 << 0,
+        world_matrix_dirty = 1 << 1,
+        removed = 1 << 2,
+    };
+
+    [[nodiscard]] ConstTransformSpan LocalTransforms() const;
+    [[nodiscard]] TransformSpan WorldTransforms() const;
+
+    void UpdateWorldTransform(Index index) const;
+    void UpdateRange(Index begin, Index end);
+    void SortHierarchy();
+
+    std::vector<math::Vector3> local_positions_;
+    std::vector<math::Quaternion> local_rotations_;
+    std::vector<math::Vector3> local_scales_;
+    mutable std::vector<math::Vector3> world_positions_;
+    mutable std::vector<math::Quaternion> world_rotations_;
+    mutable std::vector<math::Vector3> world_scales_;
+    mutable std::vector<math::Matrix4x4> world_matrices_;
+    mutable std::vector<std::uint8_t> flags_;
+    std::vector<Index> parents_;
+
+    std::vector<Handle> handles_;
+    std::vector<Index> indices_;
+    std::vector<Handle> free_handles_;
+
+    // Entries before `shared_size_` are updated first, then the rest is split into subtrees
+    // which do not depend on each other, `subtree_offsets_` holds their beginnings and the total size at the end
+    Index shared_size_;
+    std::vector<Index> subtree_offsets_;
+
+    ThreadPool *thread_pool_;
+    UpdateMode mode_;
+    std::size_t removed_count_;
+    bool is_order_dirty_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_TRANSFORM_SYSTEM_HPP_INCLUDED
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_TREE_BROAD_PHASE_HPP_INCLUDED
+#define BOROV_ENGINE_TREE_BROAD_PHASE_HPP_INCLUDED
+
+#include "broad_phase.hpp"
+#include "dynamic_aabb_tree.hpp"
+
+namespace borov_engine {
+
+// Suits scenes spread in every direction and frequent region or ray queries.
+// Pairs are found for the fat bounds of the tree, so they could be slightly apart
+class TreeBroadPhase final : public BroadPhase {
+  public:
+    explicit TreeBroadPhase(float margin = 0.1f);
+
+    [[nodiscard]] ProxyId Add(const math::AxisAlignedBox &bounds) override;
+    void Move(ProxyId proxy, const math::AxisAlignedBox &bounds) override;
+
+    [[nodiscard]] std::size_t Size() const override;
+
+    void Query(const math::AxisAlignedBox &region, const QueryFunction &function) const override;
+    void Query(const math::Ray &ray, float max_distance, const QueryFunction &function) const override;
+    // Packet is traced through the tree as a whole, every proxy is reported once
+    void Query(const RayPacket &rays, float max_distance, const PacketQueryFunction &function) const override;
+
+    [[nodiscard]] const DynamicAabbTree &Tree() const;
+
+  protected:
+    void RemoveProxy(ProxyId proxy) override;
+    void FindPairs(std::vector<ProxyPair> &pairs) override;
+
+  private:
+    DynamicAabbTree tree_;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_TREE_BROAD_PHASE_HPP_INCLUDED
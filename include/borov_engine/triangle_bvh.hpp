@@ -0,0 +1,131 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_TRIANGLE_BVH_HPP_INCLUDED
+#define BOROV_ENGINE_TRIANGLE_BVH_HPP_INCLUDED
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+#include "triangle_packets.hpp"
+
+namespace borov_engine {
+
+class RayPacket;
+
+// Bounding volume hierarchy over the triangles of the mesh, built with binned surface area heuristic.
+// Nodes are stored in one array in depth first order, so the first child always follows its parent.
+// Triangles are copied in the order of the leaves, so the leaf is tested without gathering its vertices.
+// Every leaf starts a new packet of triangles and fills the packets to the end, so its triangles are tested
+// a whole packet at a time
+class TriangleBvh {
+  public:
+    using Index = std::uint32_t;
+
+    struct Node {
+        math::AxisAlignedBox bounds;
+        // First triangle of the leaf, which is the first lane of its packet, or the second child of the inner node
+        Index offset;
+        // Zero for inner nodes
+        Index count;
+    };
+
+    struct RayHit {
+        // In lengths of the ray direction
+        float distance;
+        // Index of the triangle in the mesh
+        Index triangle;
+        // Weights of the second and the third points of the triangle, the first one is `1 - u - v`
+        float u;
+        float v;
+    };
+
+    struct PointHit {
+        // Point of the triangle nearest to the given one
+        math::Vector3 point;
+        float distance;
+        // Index of the triangle in the mesh
+        Index triangle;
+    };
+
+    // Leaves deeper than this are not split anymore, which bounds the traversal stack
+    static constexpr std::size_t max_depth = 64;
+    // Whole leaf fits into one packet, which is tested about as fast as a single triangle
+    static constexpr std::size_t max_leaf_size = TrianglePackets::width;
+    // Index of the empty lanes which pad the last packet of every leaf
+    static constexpr Index empty_triangle = std::numeric_limits<Index>::max();
+
+    explicit TriangleBvh() = default;
+    // Incomplete triangle at the end of indices is ignored
+    explicit TriangleBvh(std::span<const math::Vector3> vertices, std::span<const Index> indices);
+
+    // Moves the triangles to the new positions of the vertices and fits bounds of every node in linear time.
+    // Structure of the tree is kept, so the indices must be the ones the hierarchy was built for
+    void Refit(std::span<const math::Vector3> vertices, std::span<const Index> indices);
+
+    [[nodiscard]] std::span<const Node> Nodes() const;
+    // Triangles in the order of the leaves, the empty lanes after every leaf are degenerate triangles
+    [[nodiscard]] std::span<const math::Triangle> Triangles() const;
+    // Index of the triangle in the mesh for every triangle of the hierarchy, or the empty triangle
+    [[nodiscard]] std::span<const Index> TriangleIndices() const;
+    // Same triangles as structure of arrays
+    [[nodiscard]] const TrianglePackets &Packets() const;
+
+    // Calls `intersects(triangle)` for triangles of every leaf whose bounds and bounds of all its parents
+    // satisfy `overlaps(bounds)`. Stops and returns true as soon as `intersects` returns true
+    template <std::predicate<const math::AxisAlignedBox &> O, std::predicate<const math::Triangle &> F>
+    [[nodiscard]] bool AnyOf(O &&overlaps, F &&intersects) const;
+    // Same as `AnyOf`, but calls `intersects(packet, triangles)` for every packet of the leaf, where the triangles
+    // are the ones of the lanes. Stops and returns true as soon as it returns the mask with any lane of the leaf
+    template <std::predicate<const math::AxisAlignedBox &> O,
+              std::invocable<const TrianglePackets::Packet &, std::span<const math::Triangle>> F>
+    [[nodiscard]] bool AnyPacketOf(O &&overlaps, F &&intersects) const;
+
+    // Smallest of `distance(triangle)` over the triangles, or the max distance if none is nearer. Nodes are visited
+    // nearest first by `bound(bounds)`, which must never exceed the distance to any triangle inside the bounds,
+    // and are skipped as soon as it is not less than the nearest distance found so far. Stops at zero distance
+    template <std::invocable<const math::AxisAlignedBox &> B, std::invocable<const math::Triangle &> D>
+    [[nodiscard]] float MinOf(B &&bound, D &&distance,
+                              float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // Nearest point of triangles to the given one, the search is pruned by the distances to the bounds of nodes
+    [[nodiscard]] bool ClosestPoint(const math::Vector3 &point, PointHit &hit,
+                                    float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    // Nearest hit of both sides of triangles. Nodes are visited front to back and skipped
+    // as soon as they are farther than the nearest hit found so far
+    [[nodiscard]] bool ClosestHit(const math::Ray &ray, RayHit &hit,
+                                  float max_distance = std::numeric_limits<float>::infinity()) const;
+    // Nearest hits of the lanes of the packet, traced through the hierarchy together. Distances of the given hits
+    // are the max distances of their lanes, only closer hits replace them. Returns the bits of the lanes hit
+    [[nodiscard]] std::uint32_t ClosestHits(const RayPacket &rays, std::span<RayHit> hits) const;
+    // Stops at the first hit found, which is enough for occlusion queries
+    [[nodiscard]] bool AnyHit(const math::Ray &ray, float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    [[nodiscard]] bool Intersects(const math::Ray &ray, float &dist) const;
+    // Both hierarchies must be in the same space
+    [[nodiscard]] bool Intersects(const TriangleBvh &other) const;
+
+  private:
+    struct Primitive;
+
+    Index Build(std::span<Primitive> primitives, std::size_t depth);
+
+    // Calls `leaf(node)` for every leaf reached, stops as soon as it returns true
+    template <typename O, typename L>
+    bool AnyLeafOf(O &&overlaps, L &&leaf) const;
+
+    std::vector<Node> nodes_;
+    std::vector<math::Triangle> triangles_;
+    std::vector<Index> triangle_indices_;
+    TrianglePackets packets_;
+};
+
+}  // namespace borov_engine
+
+#include "triangle_bvh.inl"
+
+#endif  // BOROV_ENGINE_TRIANGLE_BVH_HPP_INCLUDED
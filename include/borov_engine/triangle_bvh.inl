@@ -0,0 +1,119 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_TRIANGLE_BVH_INL_INCLUDED
+#define BOROV_ENGINE_TRIANGLE_BVH_INL_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace borov_engine {
+
+template <std::predicate<const math::AxisAlignedBox &> O, std::predicate<const math::Triangle &> F>
+bool TriangleBvh::AnyOf(O &&overlaps, F &&intersects) const {
+    return AnyLeafOf(overlaps, [&](const Node &node) {
+        for (const math::Triangle &triangle : std::span{triangles_}.subspan(node.offset, node.count)) {
+            if (intersects(triangle)) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+template <std::predicate<const math::AxisAlignedBox &> O,
+          std::invocable<const TrianglePackets::Packet &, std::span<const math::Triangle>> F>
+bool TriangleBvh::AnyPacketOf(O &&overlaps, F &&intersects) const {
+    constexpr std::size_t width = TrianglePackets::width;
+    const std::span packets = packets_.Packets();
+    return AnyLeafOf(overlaps, [&](const Node &node) {
+        // Leaf starts at the first lane, so only its last packet has empty lanes
+        for (std::size_t first = node.offset; first < node.offset + node.count; first += width) {
+            const std::size_t lane_count = (std::min)(width, node.offset + node.count - first);
+            const auto lanes = static_cast<TrianglePackets::Mask>((std::uint64_t{1} << lane_count) - 1);
+            const std::span triangles = std::span{triangles_}.subspan(first, width);
+            if ((static_cast<TrianglePackets::Mask>(intersects(packets[first / width], triangles)) & lanes) != 0) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+template <std::invocable<const math::AxisAlignedBox &> B, std::invocable<const math::Triangle &> D>
+float TriangleBvh::MinOf(B &&bound, D &&distance, const float max_distance) const {
+    if (nodes_.empty()) {
+        return max_distance;
+    }
+
+    // Nodes are stored with their bounds, so the ones farther than the nearest triangle are skipped without a test
+    float nearest_distance = max_distance;
+    std::array<std::pair<Index, float>, max_depth + 2> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = {0, static_cast<float>(bound(nodes_[0].bounds))};
+    while (stack_size > 0) {
+        const auto [node_index, node_bound] = stack[--stack_size];
+        if (node_bound >= nearest_distance) {
+            continue;
+        }
+
+        const Node &node = nodes_[node_index];
+        if (node.count > 0) {
+            for (const math::Triangle &triangle : std::span{triangles_}.subspan(node.offset, node.count)) {
+                nearest_distance = (std::min)(nearest_distance, static_cast<float>(distance(triangle)));
+                if (nearest_distance <= 0.0f) {
+                    return 0.0f;
+                }
+            }
+            continue;
+        }
+
+        // Nearer child is pushed last, so it is visited first
+        const Index first = node_index + 1;
+        const Index second = node.offset;
+        const float first_bound = bound(nodes_[first].bounds);
+        const float second_bound = bound(nodes_[second].bounds);
+        if (first_bound <= second_bound) {
+            stack[stack_size++] = {second, second_bound};
+            stack[stack_size++] = {first, first_bound};
+        } else {
+            stack[stack_size++] = {first, first_bound};
+            stack[stack_size++] = {second, second_bound};
+        }
+    }
+    return nearest_distance;
+}
+
+template <typename O, typename L>
+bool TriangleBvh::AnyLeafOf(O &&overlaps, L &&leaf) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    // Every level pushes at most two nodes and pops one, so the depth limit bounds the stack
+    std::array<Index, max_depth + 2> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const Index node_index = stack[--stack_size];
+        const Node &node = nodes_[node_index];
+        if (!overlaps(node.bounds)) {
+            continue;
+        }
+
+        if (node.count == 0) {
+            stack[stack_size++] = node.offset;
+            stack[stack_size++] = node_index + 1;
+            continue;
+        }
+        if (leaf(node)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_TRIANGLE_BVH_INL_INCLUDED
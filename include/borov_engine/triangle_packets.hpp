@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef BOROV_ENGINE_TRIANGLE_PACKETS_HPP_INCLUDED
+#define BOROV_ENGINE_TRIANGLE_PACKETS_HPP_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math.hpp"
+
+namespace borov_engine {
+
+// Triangles stored as structure of arrays, grouped into packets of several triangles.
+// Every test is written lane by lane over the whole packet without branches, so the compiler turns it
+// into SIMD instructions instead of testing triangles one by one. Leaves of the triangle hierarchy are stored this way
+class TrianglePackets {
+  public:
+    using Index = std::uint32_t;
+    // Bit of every lane which passed the test
+    using Mask = std::uint32_t;
+
+#if defined(__AVX__)
+    static constexpr std::size_t width = 8;
+#else
+    static constexpr std::size_t width = 4;
+#endif
+
+    using Lanes = std::array<float, width>;
+
+    // Lanes which hold no triangle are degenerate and have infinite plane distance, so no test ever passes them
+    struct alignas(sizeof(Lanes)) Packet {
+        std::array<Lanes, 3> point0;
+        std::array<Lanes, 3> edge1;
+        std::array<Lanes, 3> edge2;
+        // Unit normal and the distance of the plane, so `dot(normal, point) + plane_distance` is the signed distance
+        std::array<Lanes, 3> normal;
+        Lanes plane_distance;
+    };
+
+    explicit TrianglePackets() = default;
+    // Lanes of all the triangles are empty until they are set
+    explicit TrianglePackets(std::size_t size);
+
+    // Triangle `i` is the lane `i % width` of the packet `i / width`
+    [[nodiscard]] std::span<const Packet> Packets() const;
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] math::Triangle Triangle(Index triangle) const;
+    void Triangle(Index triangle, const math::Triangle &value);
+
+    // Möller–Trumbore test of both sides of every lane, which also yields barycentric coordinates of the hits.
+    // Lanes which are missed get infinite distance
+    [[nodiscard]] static Mask Intersects(const Packet &packet, const math::Ray &ray, float max_distance,
+                                         Lanes &distances, Lanes &us, Lanes &vs);
+    // Exact test by the distance from the center of the sphere to the nearest point of every lane
+    [[nodiscard]] static Mask Intersects(const Packet &packet, const math::Sphere &sphere);
+    // Lanes which cross the plane or lie behind it, same as `math::Triangle::Intersects(plane)` is not in front
+    [[nodiscard]] static Mask Intersects(const Packet &packet, const math::Plane &plane);
+
+    // Lanes whose planes have the corners of the convex shape on both sides or pass through one of them.
+    // Planes of the rest separate them from the shape, so only these lanes need the exact test
+    [[nodiscard]] static Mask NearPlanes(const Packet &packet, std::span<const math::Vector3> corners);
+
+  private:
+    std::vector<Packet> packets_;
+    std::size_t size_ = 0;
+};
+
+}  // namespace borov_engine
+
+#endif  // BOROV_ENGINE_TRIANGLE_PACKETS_HPP_INCLUDED
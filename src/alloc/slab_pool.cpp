@@ -0,0 +1,78 @@
+#include "borov_engine/alloc/slab_pool.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace borov_engine::alloc {
+
+PoolStats &PoolStats::operator+=(const PoolStats &other) {
+    allocation_count += other.allocation_count;
+    deallocation_count += other.deallocation_count;
+    slab_count += other.slab_count;
+    reserved_bytes += other.reserved_bytes;
+    return *this;
+}
+
+SlabPool::SlabPool(const std::size_t object_size, const std::size_t object_alignment)
+    : object_alignment_{(std::max)(object_alignment, alignof(FreeObject))},
+      next_slab_object_count_{min_slab_object_count},
+      slab_current_{},
+      slab_end_{},
+      free_list_{} {
+    // Freed objects store the free list inside, and every object in the slab must stay aligned
+    const std::size_t size = (std::max)(object_size, sizeof(FreeObject));
+    object_size_ = (size + object_alignment_ - 1) / object_alignment_ * object_alignment_;
+}
+
+SlabPool::~SlabPool() noexcept {
+    for (std::byte *slab : slabs_) {
+        ::operator delete(slab, std::align_val_t{object_alignment_});
+    }
+}
+
+void *SlabPool::Allocate() {
+    stats_.allocation_count += 1;
+
+    // Recently freed objects are reused first, as they are most likely still in the cache
+    if (free_list_ != nullptr) {
+        FreeObject *object = free_list_;
+        free_list_ = object->next;
+        return object;
+    }
+
+    if (slab_current_ == slab_end_) {
+        AllocateSlab();
+    }
+    std::byte *object = slab_current_;
+    slab_current_ += object_size_;
+    return object;
+}
+
+void SlabPool::Deallocate(void *object) noexcept {
+    if (object == nullptr) {
+        return;
+    }
+
+    stats_.deallocation_count += 1;
+    free_list_ = ::new (object) FreeObject{.next = free_list_};
+}
+
+const PoolStats &SlabPool::Stats() const {
+    return stats_;
+}
+
+void SlabPool::AllocateSlab() {
+    const std::size_t slab_size = object_size_ * next_slab_object_count_;
+    slabs_.reserve(slabs_.size() + 1);
+    auto *slab = static_cast<std::byte *>(::operator new(slab_size, std::align_val_t{object_alignment_}));
+    slabs_.push_back(slab);
+
+    slab_current_ = slab;
+    slab_end_ = slab + slab_size;
+    next_slab_object_count_ = (std::min)(next_slab_object_count_ * 2, max_slab_object_count);
+
+    stats_.slab_count += 1;
+    stats_.reserved_bytes += slab_size;
+}
+
+}  // namespace borov_engine::alloc
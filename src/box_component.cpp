@@ -232,6 +232,18 @@ bool BoxComponent::Intersects(const math::Ray &ray, float &dist) const {
     return CollisionPrimitive().Intersects(ray, dist);
 }
 
+float BoxComponent::Distance(const Collision &other) const {
+    return CollisionPrimitive().Distance(other);
+}
+
+math::Vector3 BoxComponent::ClosestPoint(const math::Vector3 &point) const {
+    return CollisionPrimitive().ClosestPoint(point);
+}
+
+math::AxisAlignedBox BoxComponent::Bounds() const {
+    return CollisionPrimitive().Bounds();
+}
+
 BoxCollision BoxComponent::CollisionPrimitive() const {
     const auto [center, orientation, scale] = WorldTransform();
     const math::Vector3 extents = math::Vector3{Length() / 2, Height() / 2, Width() / 2} * scale;
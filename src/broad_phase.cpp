@@ -0,0 +1,49 @@
+#include "borov_engine/broad_phase.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace borov_engine {
+
+BroadPhase::~BroadPhase() = default;
+
+void BroadPhase::Remove(const ProxyId proxy) {
+    const auto has_proxy = [proxy](const ProxyPair &pair) { return pair.first == proxy || pair.second == proxy; };
+    std::erase_if(pairs_, has_proxy);
+    std::erase_if(begun_pairs_, has_proxy);
+    std::erase_if(ended_pairs_, has_proxy);
+    RemoveProxy(proxy);
+}
+
+void BroadPhase::Query(const RayPacket &rays, const float max_distance, const PacketQueryFunction &function) const {
+    for (std::size_t lane = 0; lane < rays.Size(); ++lane) {
+        const RayPacket::Mask lanes = RayPacket::Mask{1} << lane;
+        Query(rays.Ray(lane), max_distance, [&](const ProxyId proxy) { function(proxy, lanes); });
+    }
+}
+
+void BroadPhase::UpdatePairs() {
+    found_pairs_.clear();
+    FindPairs(found_pairs_);
+    std::ranges::sort(found_pairs_);
+
+    begun_pairs_.clear();
+    std::ranges::set_difference(found_pairs_, pairs_, std::back_inserter(begun_pairs_));
+    ended_pairs_.clear();
+    std::ranges::set_difference(pairs_, found_pairs_, std::back_inserter(ended_pairs_));
+    std::swap(pairs_, found_pairs_);
+}
+
+auto BroadPhase::Pairs() const -> std::span<const ProxyPair> {
+    return pairs_;
+}
+
+auto BroadPhase::BegunPairs() const -> std::span<const ProxyPair> {
+    return begun_pairs_;
+}
+
+auto BroadPhase::EndedPairs() const -> std::span<const ProxyPair> {
+    return ended_pairs_;
+}
+
+}  // namespace borov_engine
@@ -1,52 +1,760 @@
 #include "borov_engine/collision.hpp"
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include "borov_engine/gjk.hpp"
 
 namespace borov_engine {
 
-Collision::~Collision() = default;
+namespace {
 
-SphereCollision::SphereCollision(const PrimitiveType& primitive) : sphere_{primitive} {}
+template <typename Function>
+struct ShapeEntry {
+    Function function;
+    bool is_swapped;
+};
 
-auto SphereCollision::Primitive() const -> const PrimitiveType& {
-    return sphere_;
+template <typename Function>
+using ShapeTable =
+    std::array<std::array<ShapeEntry<Function>, Collision::max_shape_count>, Collision::max_shape_count>;
+
+using IntersectionTable = ShapeTable<Collision::IntersectionFunction>;
+using DistanceTable = ShapeTable<Collision::DistanceFunction>;
+
+template <std::derived_from<Collision> T>
+const typename T::PrimitiveType& PrimitiveOf(const Collision& collision) {
+    return static_cast<const T&>(collision).Primitive();
 }
 
-auto SphereCollision::Primitive() -> PrimitiveType& {
-    return sphere_;
+const TriangleBvh& HierarchyOf(const Collision& mesh) {
+    return static_cast<const MeshCollision&>(mesh).Hierarchy();
 }
 
-bool SphereCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return sphere->Primitive().Intersects(sphere_);
+const MeshInstanceCollision& InstanceOf(const Collision& instance) {
+    return static_cast<const MeshInstanceCollision&>(instance);
+}
+
+const TriangleBvh& InstanceHierarchyOf(const Collision& instance) {
+    return InstanceOf(instance).Mesh()->Hierarchy();
+}
+
+// Only triangles of the leaves whose bounds overlap the shape are tested. Planes of the triangles reject the lanes
+// of the packet which are separated from the corners of the convex shape, only the rest are tested exactly
+template <typename O, typename F>
+bool AnyTriangleNear(const TriangleBvh& hierarchy, const std::span<const math::Vector3> corners, O&& overlaps,
+                     F&& intersects) {
+    return hierarchy.AnyPacketOf(overlaps, [&](const TrianglePackets::Packet& packet,
+                                               const std::span<const math::Triangle> triangles) {
+        for (TrianglePackets::Mask lanes = TrianglePackets::NearPlanes(packet, corners); lanes != 0;
+             lanes &= lanes - 1) {
+            const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+            if (intersects(triangles[lane])) {
+                return TrianglePackets::Mask{1} << lane;
+            }
+        }
+        return TrianglePackets::Mask{0};
+    });
+}
+
+template <typename T>
+bool AnyTriangle(const TriangleBvh& hierarchy, const T& primitive) {
+    std::array<math::Vector3, T::CORNER_COUNT> corners;
+    primitive.GetCorners(corners.data());
+    return AnyTriangleNear(
+        hierarchy, corners, [&](const math::AxisAlignedBox& bounds) { return bounds.Intersects(primitive); },
+        [&](const math::Triangle& triangle) { return triangle.Intersects(primitive); });
+}
+
+// Spheres and planes are tested exactly by the lanes of the packet
+bool AnyTriangle(const TriangleBvh& hierarchy, const math::Sphere& sphere) {
+    return hierarchy.AnyPacketOf(
+        [&](const math::AxisAlignedBox& bounds) { return bounds.Intersects(sphere); },
+        [&](const TrianglePackets::Packet& packet, std::span<const math::Triangle>) {
+            return TrianglePackets::Intersects(packet, sphere);
+        });
+}
+
+bool AnyTriangle(const TriangleBvh& hierarchy, const math::Plane& plane) {
+    return hierarchy.AnyPacketOf(
+        [&](const math::AxisAlignedBox& bounds) { return bounds.Intersects(plane) != math::PlaneIntersectionType{}; },
+        [&](const TrianglePackets::Packet& packet, std::span<const math::Triangle>) {
+            return TrianglePackets::Intersects(packet, plane);
+        });
+}
+
+bool AnyTriangle(const TriangleBvh& hierarchy, const math::Triangle& other_triangle) {
+    const std::array corners{other_triangle.point0, other_triangle.point1, other_triangle.point2};
+    return AnyTriangleNear(
+        hierarchy, corners, [&](const math::AxisAlignedBox& bounds) { return other_triangle.Intersects(bounds); },
+        [&](const math::Triangle& triangle) { return triangle.Intersects(other_triangle); });
+}
+
+// Primitives given in the world, moved into the space of the mesh instance
+
+template <typename T>
+T Transformed(const T& primitive, const math::Matrix4x4& matrix) {
+    T result;
+    primitive.Transform(result, matrix);
+    return result;
+}
+
+math::Box Transformed(const math::AxisAlignedBox& box, const math::Matrix4x4& matrix) {
+    math::Box result;
+    math::Box::CreateFromBoundingBox(result, box);
+    return Transformed(result, matrix);
+}
+
+math::Triangle Transformed(const math::Triangle& triangle, const math::Matrix4x4& matrix) {
+    return math::Triangle{
+        .point0 = math::Vector3::Transform(triangle.point0, matrix),
+        .point1 = math::Vector3::Transform(triangle.point1, matrix),
+        .point2 = math::Vector3::Transform(triangle.point2, matrix),
+    };
+}
+
+// Planes are transformed by the inverse transpose, which is the transpose of the world matrix
+math::Plane LocalPlane(const math::Plane& plane, const MeshInstanceCollision& instance) {
+    math::Plane result = math::Plane::Transform(plane, instance.WorldMatrix().Transpose());
+    result.Normalize();
+    return result;
+}
+
+// Triangles of the other hierarchy are moved into the space of the first one by the matrix
+bool AnyTriangle(const TriangleBvh& hierarchy, const TriangleBvh& other, const math::Matrix4x4& other_to_hierarchy) {
+    const std::span nodes = hierarchy.Nodes();
+    if (nodes.empty()) {
+        return false;
+    }
+
+    const math::AxisAlignedBox& root_bounds = nodes.front().bounds;
+    return other.AnyOf(
+        [&](const math::AxisAlignedBox& bounds) {
+            return root_bounds.Intersects(Transformed(bounds, other_to_hierarchy));
+        },
+        [&](const math::Triangle& triangle) {
+            return AnyTriangle(hierarchy, Transformed(triangle, other_to_hierarchy));
+        });
+}
+
+// Hull moved into some space by the matrix. Its support is found in the space of the hull
+// along the direction moved by the transpose, so none of the vertices are transformed but one
+struct PlacedHull {
+    const Quickhull* hull;
+    math::Matrix4x4 matrix;
+    math::Matrix4x4 transposed_matrix;
+};
+
+math::Vector3 Support(const PlacedHull& hull, const math::Vector3& direction) {
+    const math::Vector3 local_direction = math::Vector3::TransformNormal(direction, hull.transposed_matrix);
+    return math::Vector3::Transform(Support(*hull.hull, local_direction), hull.matrix);
+}
+
+const ConvexHullCollision& HullCollisionOf(const Collision& hull) {
+    return static_cast<const ConvexHullCollision&>(hull);
+}
+
+PlacedHull Placed(const ConvexHullCollision& hull, const math::Matrix4x4& matrix) {
+    return PlacedHull{.hull = hull.Hull().get(), .matrix = matrix, .transposed_matrix = matrix.Transpose()};
+}
+
+PlacedHull Placed(const Collision& hull) {
+    return Placed(HullCollisionOf(hull), HullCollisionOf(hull).WorldMatrix());
+}
+
+// Exact bounds of any convex shape from its supports along the axes
+template <ConvexSupport T>
+math::AxisAlignedBox BoundsOf(const T& primitive) {
+    const ConvexShape shape{primitive};
+    const math::Vector3 min{
+        shape.Support(-math::Vector3::UnitX).x,
+        shape.Support(-math::Vector3::UnitY).y,
+        shape.Support(-math::Vector3::UnitZ).z,
+    };
+    const math::Vector3 max{
+        shape.Support(math::Vector3::UnitX).x,
+        shape.Support(math::Vector3::UnitY).y,
+        shape.Support(math::Vector3::UnitZ).z,
+    };
+    return math::AxisAlignedBox{(min + max) * 0.5f, (max - min) * 0.5f};
+}
+
+template <ConvexSupport T>
+bool HullIntersects(const PlacedHull& hull, const T& primitive) {
+    GjkSimplex simplex;
+    return Intersects(ConvexShape{hull}, ConvexShape{primitive}, simplex);
+}
+
+// Same as for the other shapes, the hull intersects the plane unless it is entirely in front of it
+bool HullIntersects(const PlacedHull& hull, const math::Plane& plane) {
+    return plane.DotCoordinate(Support(hull, -plane.Normal())) <= 0.0f;
+}
+
+// Only triangles near the bounds of the hull are tested by GJK
+bool AnyTriangle(const TriangleBvh& hierarchy, const PlacedHull& hull) {
+    const math::AxisAlignedBox hull_bounds = BoundsOf(hull);
+    std::array<math::Vector3, math::AxisAlignedBox::CORNER_COUNT> corners;
+    hull_bounds.GetCorners(corners.data());
+    return AnyTriangleNear(
+        hierarchy, corners, [&](const math::AxisAlignedBox& bounds) { return bounds.Intersects(hull_bounds); },
+        [&](const math::Triangle& triangle) { return HullIntersects(hull, triangle); });
+}
+
+// Distances of convex shapes are found by GJK, which stops at zero as soon as the shapes overlap
+template <ConvexSupport L, ConvexSupport R>
+float ConvexDistanceOf(const L& lhs, const R& rhs) {
+    GjkSimplex simplex;
+    ConvexDistance result;
+    return ClosestPoints(ConvexShape{lhs}, ConvexShape{rhs}, simplex, result) ? result.distance : 0.0f;
+}
+
+// Spheres are measured from their centers and shrunk by the radius, which is exact unlike their round supports
+template <ConvexSupport R>
+float ConvexDistanceOf(const math::Sphere& lhs, const R& rhs) {
+    return (std::max)(ConvexDistanceOf(math::Vector3{lhs.Center}, rhs) - lhs.Radius, 0.0f);
+}
+
+template <ConvexSupport L>
+float ConvexDistanceOf(const L& lhs, const math::Sphere& rhs) {
+    return ConvexDistanceOf(rhs, lhs);
+}
+
+float ConvexDistanceOf(const math::Sphere& lhs, const math::Sphere& rhs) {
+    const float distance = math::Vector3::Distance(math::Vector3{lhs.Center}, math::Vector3{rhs.Center});
+    return (std::max)(distance - lhs.Radius - rhs.Radius, 0.0f);
+}
+
+// Same as for the intersections, the plane bounds the half space behind it,
+// so the distance is the height of the lowest point of the shape above the plane
+template <ConvexSupport T>
+float PlaneDistanceOf(const math::Plane& plane, const T& primitive) {
+    const math::Vector3 normal = plane.Normal();
+    const float height = plane.DotCoordinate(ConvexShape{primitive}.Support(-normal));
+    return (std::max)(height / normal.Length(), 0.0f);
+}
+
+// Half spaces are apart only if they face away from each other, then the gap is the height of the second plane
+float PlaneDistanceOf(const math::Plane& lhs, const math::Plane& rhs) {
+    if (math::Intersects(lhs, rhs) || lhs.Normal().Dot(rhs.Normal()) > 0.0f) {
+        return 0.0f;
+    }
+    const math::Vector3 normal = rhs.Normal();
+    const math::Vector3 point = normal * (-rhs.D() / normal.LengthSquared());
+    return (std::max)(lhs.DotCoordinate(point) / lhs.Normal().Length(), 0.0f);
+}
+
+// Nodes are skipped by the distance between their bounds and the bounds of the primitive,
+// which never exceeds the distance to the primitive itself
+template <ConvexSupport T>
+float MinTriangleDistance(const TriangleBvh& hierarchy, const T& primitive,
+                          const float max_distance = std::numeric_limits<float>::infinity()) {
+    const math::AxisAlignedBox primitive_bounds = BoundsOf(primitive);
+    return hierarchy.MinOf(
+        [&](const math::AxisAlignedBox& bounds) { return math::Distance(bounds, primitive_bounds); },
+        [&](const math::Triangle& triangle) { return ConvexDistanceOf(triangle, primitive); }, max_distance);
+}
+
+float MinTriangleDistance(const TriangleBvh& hierarchy, const math::Plane& plane) {
+    return hierarchy.MinOf([&](const math::AxisAlignedBox& bounds) { return PlaneDistanceOf(plane, bounds); },
+                           [&](const math::Triangle& triangle) { return PlaneDistanceOf(plane, triangle); });
+}
+
+// Triangles of the other hierarchy are moved into the space of the first one by the matrix.
+// The nearest distance found so far also prunes the search in the first hierarchy
+float MinTriangleDistance(const TriangleBvh& hierarchy, const TriangleBvh& other,
+                          const math::Matrix4x4& other_to_hierarchy) {
+    const std::span nodes = hierarchy.Nodes();
+    if (nodes.empty()) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    const math::AxisAlignedBox& root_bounds = nodes.front().bounds;
+    float nearest_distance = std::numeric_limits<float>::infinity();
+    return other.MinOf(
+        [&](const math::AxisAlignedBox& bounds) {
+            return math::Distance(root_bounds, BoundsOf(Transformed(bounds, other_to_hierarchy)));
+        },
+        [&](const math::Triangle& triangle) {
+            const math::Triangle moved_triangle = Transformed(triangle, other_to_hierarchy);
+            nearest_distance = MinTriangleDistance(hierarchy, moved_triangle, nearest_distance);
+            return nearest_distance;
+        });
+}
+
+float MinScaleOf(const Transform& transform) {
+    const math::Vector3& scale = transform.scale;
+    return (std::min)({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+}
+
+// Distances in the space of the instance are moved back into the world by the smallest scale,
+// which is exact for the uniform scale and never overestimates the distance otherwise
+float WorldDistance(const MeshInstanceCollision& instance, const float local_distance) {
+    return local_distance * MinScaleOf(instance.Transform());
+}
+
+// Shape of the collision in the world, hulls are placed by their transforms
+template <std::derived_from<Collision> T>
+decltype(auto) WorldShapeOf(const Collision& collision) {
+    if constexpr (std::same_as<T, ConvexHullCollision>) {
+        return Placed(collision);
+    } else {
+        return PrimitiveOf<T>(collision);
     }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return axis_aligned_box->Primitive().Intersects(sphere_);
+}
+
+// Shape of the collision moved into the space of the mesh instance, same as for the intersections
+template <std::derived_from<Collision> T>
+auto LocalShapeOf(const Collision& collision, const MeshInstanceCollision& instance) {
+    if constexpr (std::same_as<T, ConvexHullCollision>) {
+        return Placed(HullCollisionOf(collision), HullCollisionOf(collision).WorldMatrix() * instance.LocalMatrix());
+    } else if constexpr (std::same_as<T, PlaneCollision>) {
+        return LocalPlane(PrimitiveOf<T>(collision), instance);
+    } else {
+        return Transformed(PrimitiveOf<T>(collision), instance.LocalMatrix());
     }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return box->Primitive().Intersects(sphere_);
+}
+
+// Distance functions of the shape kinds, the mesh, the instance or the plane is always on the left
+
+template <std::derived_from<Collision> L, std::derived_from<Collision> R>
+float ConvexPairDistance(const Collision& lhs, const Collision& rhs) {
+    return ConvexDistanceOf(WorldShapeOf<L>(lhs), WorldShapeOf<R>(rhs));
+}
+
+template <std::derived_from<Collision> T>
+float PlaneDistance(const Collision& plane, const Collision& other) {
+    return PlaneDistanceOf(PrimitiveOf<PlaneCollision>(plane), WorldShapeOf<T>(other));
+}
+
+template <std::derived_from<Collision> T>
+float MeshDistance(const Collision& mesh, const Collision& other) {
+    return MinTriangleDistance(HierarchyOf(mesh), WorldShapeOf<T>(other));
+}
+
+template <std::derived_from<Collision> T>
+float InstanceDistance(const Collision& instance, const Collision& other) {
+    const float local_distance =
+        MinTriangleDistance(InstanceHierarchyOf(instance), LocalShapeOf<T>(other, InstanceOf(instance)));
+    return WorldDistance(InstanceOf(instance), local_distance);
+}
+
+// Point of the convex shape nearest to the given one, found by GJK against the point
+template <ConvexSupport T>
+math::Vector3 ClosestPointOf(const T& primitive, const math::Vector3& point) {
+    GjkSimplex simplex;
+    ConvexDistance result;
+    return ClosestPoints(ConvexShape{primitive}, ConvexShape{point}, simplex, result) ? result.lhs_point : point;
+}
+
+template <typename Function>
+constexpr void SetEntry(ShapeTable<Function>& table, const CollisionShape lhs, const CollisionShape rhs,
+                        const Function function) {
+    table[lhs][rhs] = ShapeEntry<Function>{.function = function, .is_swapped = false};
+    if (lhs != rhs) {
+        table[rhs][lhs] = ShapeEntry<Function>{.function = function, .is_swapped = true};
     }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return frustum->Primitive().Intersects(sphere_);
+}
+
+constexpr void SetIntersection(IntersectionTable& table, const CollisionShape lhs, const CollisionShape rhs,
+                               const Collision::IntersectionFunction function) {
+    SetEntry(table, lhs, rhs, function);
+}
+
+constexpr void SetDistance(DistanceTable& table, const CollisionShape lhs, const CollisionShape rhs,
+                           const Collision::DistanceFunction function) {
+    SetEntry(table, lhs, rhs, function);
+}
+
+constexpr IntersectionTable BuiltinIntersections() {
+    IntersectionTable table{};
+
+    using Sphere = SphereCollision;
+    using AxisAlignedBox = AxisAlignedBoxCollision;
+    using Box = BoxCollision;
+    using Frustum = FrustumCollision;
+    using Plane = PlaneCollision;
+    using Triangle = TriangleCollision;
+    using Mesh = MeshCollision;
+    using MeshInstance = MeshInstanceCollision;
+    using ConvexHull = ConvexHullCollision;
+
+    SetIntersection(table, Sphere::shape, Sphere::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Sphere>(rhs).Intersects(PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, Sphere::shape, AxisAlignedBox::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<AxisAlignedBox>(rhs).Intersects(PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, Sphere::shape, Box::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Box>(rhs).Intersects(PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, Sphere::shape, Frustum::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Frustum>(rhs).Intersects(PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, Sphere::shape, Plane::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Sphere>(lhs).Intersects(PrimitiveOf<Plane>(rhs)) != math::PlaneIntersectionType{};
+    });
+    SetIntersection(table, Sphere::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(rhs).Intersects(PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, Sphere::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<Sphere>(lhs));
+    });
+
+    SetIntersection(table, AxisAlignedBox::shape, AxisAlignedBox::shape,
+                    [](const Collision& lhs, const Collision& rhs) {
+                        return PrimitiveOf<AxisAlignedBox>(rhs).Intersects(PrimitiveOf<AxisAlignedBox>(lhs));
+                    });
+    SetIntersection(table, AxisAlignedBox::shape, Box::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Box>(rhs).Intersects(PrimitiveOf<AxisAlignedBox>(lhs));
+    });
+    SetIntersection(table, AxisAlignedBox::shape, Frustum::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Frustum>(rhs).Intersects(PrimitiveOf<AxisAlignedBox>(lhs));
+    });
+    SetIntersection(table, AxisAlignedBox::shape, Plane::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<AxisAlignedBox>(lhs).Intersects(PrimitiveOf<Plane>(rhs)) != math::PlaneIntersectionType{};
+    });
+    SetIntersection(table, AxisAlignedBox::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(rhs).Intersects(PrimitiveOf<AxisAlignedBox>(lhs));
+    });
+    SetIntersection(table, AxisAlignedBox::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<AxisAlignedBox>(lhs));
+    });
+
+    SetIntersection(table, Box::shape, Box::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Box>(rhs).Intersects(PrimitiveOf<Box>(lhs));
+    });
+    SetIntersection(table, Box::shape, Frustum::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Frustum>(rhs).Intersects(PrimitiveOf<Box>(lhs));
+    });
+    SetIntersection(table, Box::shape, Plane::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Box>(lhs).Intersects(PrimitiveOf<Plane>(rhs)) != math::PlaneIntersectionType{};
+    });
+    SetIntersection(table, Box::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(rhs).Intersects(PrimitiveOf<Box>(lhs));
+    });
+    SetIntersection(table, Box::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<Box>(lhs));
+    });
+
+    SetIntersection(table, Frustum::shape, Frustum::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Frustum>(rhs).Intersects(PrimitiveOf<Frustum>(lhs));
+    });
+    SetIntersection(table, Frustum::shape, Plane::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Frustum>(lhs).Intersects(PrimitiveOf<Plane>(rhs)) != math::PlaneIntersectionType{};
+    });
+    SetIntersection(table, Frustum::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(rhs).Intersects(PrimitiveOf<Frustum>(lhs));
+    });
+    SetIntersection(table, Frustum::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<Frustum>(lhs));
+    });
+
+    SetIntersection(table, Plane::shape, Plane::shape, [](const Collision& lhs, const Collision& rhs) {
+        return math::Intersects(PrimitiveOf<Plane>(rhs), PrimitiveOf<Plane>(lhs));
+    });
+    SetIntersection(table, Plane::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(rhs).Intersects(PrimitiveOf<Plane>(lhs)) != math::PlaneIntersectionType{};
+    });
+    SetIntersection(table, Plane::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<Plane>(lhs));
+    });
+
+    SetIntersection(table, Triangle::shape, Triangle::shape, [](const Collision& lhs, const Collision& rhs) {
+        return PrimitiveOf<Triangle>(lhs).Intersects(PrimitiveOf<Triangle>(rhs));
+    });
+    SetIntersection(table, Triangle::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(rhs), PrimitiveOf<Triangle>(lhs));
+    });
+
+    SetIntersection(table, Mesh::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HierarchyOf(lhs).Intersects(HierarchyOf(rhs));
+    });
+
+    // Instance is always on the right, every query is moved into its space
+    SetIntersection(table, Sphere::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Sphere sphere = Transformed(PrimitiveOf<Sphere>(lhs), InstanceOf(rhs).LocalMatrix());
+        return AnyTriangle(InstanceHierarchyOf(rhs), sphere);
+    });
+    SetIntersection(table, AxisAlignedBox::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Box box = Transformed(PrimitiveOf<AxisAlignedBox>(lhs), InstanceOf(rhs).LocalMatrix());
+        return AnyTriangle(InstanceHierarchyOf(rhs), box);
+    });
+    SetIntersection(table, Box::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Box box = Transformed(PrimitiveOf<Box>(lhs), InstanceOf(rhs).LocalMatrix());
+        return AnyTriangle(InstanceHierarchyOf(rhs), box);
+    });
+    SetIntersection(table, Frustum::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Frustum frustum = Transformed(PrimitiveOf<Frustum>(lhs), InstanceOf(rhs).LocalMatrix());
+        return AnyTriangle(InstanceHierarchyOf(rhs), frustum);
+    });
+    SetIntersection(table, Plane::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(InstanceHierarchyOf(rhs), LocalPlane(PrimitiveOf<Plane>(lhs), InstanceOf(rhs)));
+    });
+    SetIntersection(table, Triangle::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Triangle triangle = Transformed(PrimitiveOf<Triangle>(lhs), InstanceOf(rhs).LocalMatrix());
+        return AnyTriangle(InstanceHierarchyOf(rhs), triangle);
+    });
+    SetIntersection(table, Mesh::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(InstanceHierarchyOf(rhs), HierarchyOf(lhs), InstanceOf(rhs).LocalMatrix());
+    });
+    SetIntersection(table, MeshInstance::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Matrix4x4 lhs_to_rhs = InstanceOf(lhs).WorldMatrix() * InstanceOf(rhs).LocalMatrix();
+        return AnyTriangle(InstanceHierarchyOf(rhs), InstanceHierarchyOf(lhs), lhs_to_rhs);
+    });
+
+    // Hull is always on the right, and is moved into the space of the mesh instance
+    SetIntersection(table, Sphere::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<Sphere>(lhs));
+    });
+    SetIntersection(table, AxisAlignedBox::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<AxisAlignedBox>(lhs));
+    });
+    SetIntersection(table, Box::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<Box>(lhs));
+    });
+    SetIntersection(table, Frustum::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<Frustum>(lhs));
+    });
+    SetIntersection(table, Plane::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<Plane>(lhs));
+    });
+    SetIntersection(table, Triangle::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), PrimitiveOf<Triangle>(lhs));
+    });
+    SetIntersection(table, Mesh::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return AnyTriangle(HierarchyOf(lhs), Placed(rhs));
+    });
+    SetIntersection(table, MeshInstance::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Matrix4x4 rhs_to_lhs = HullCollisionOf(rhs).WorldMatrix() * InstanceOf(lhs).LocalMatrix();
+        return AnyTriangle(InstanceHierarchyOf(lhs), Placed(HullCollisionOf(rhs), rhs_to_lhs));
+    });
+    SetIntersection(table, ConvexHull::shape, ConvexHull::shape, [](const Collision& lhs, const Collision& rhs) {
+        return HullIntersects(Placed(rhs), Placed(lhs));
+    });
+
+    return table;
+}
+
+constexpr DistanceTable BuiltinDistances() {
+    DistanceTable table{};
+
+    using Sphere = SphereCollision;
+    using AxisAlignedBox = AxisAlignedBoxCollision;
+    using Box = BoxCollision;
+    using Frustum = FrustumCollision;
+    using Plane = PlaneCollision;
+    using Triangle = TriangleCollision;
+    using Mesh = MeshCollision;
+    using MeshInstance = MeshInstanceCollision;
+    using ConvexHull = ConvexHullCollision;
+
+    SetDistance(table, Sphere::shape, Sphere::shape, ConvexPairDistance<Sphere, Sphere>);
+    SetDistance(table, Sphere::shape, AxisAlignedBox::shape, ConvexPairDistance<Sphere, AxisAlignedBox>);
+    SetDistance(table, Sphere::shape, Box::shape, ConvexPairDistance<Sphere, Box>);
+    SetDistance(table, Sphere::shape, Frustum::shape, ConvexPairDistance<Sphere, Frustum>);
+    SetDistance(table, Sphere::shape, Triangle::shape, ConvexPairDistance<Sphere, Triangle>);
+    SetDistance(table, Sphere::shape, ConvexHull::shape, ConvexPairDistance<Sphere, ConvexHull>);
+
+    SetDistance(table, AxisAlignedBox::shape, AxisAlignedBox::shape,
+                ConvexPairDistance<AxisAlignedBox, AxisAlignedBox>);
+    SetDistance(table, AxisAlignedBox::shape, Box::shape, ConvexPairDistance<AxisAlignedBox, Box>);
+    SetDistance(table, AxisAlignedBox::shape, Frustum::shape, ConvexPairDistance<AxisAlignedBox, Frustum>);
+    SetDistance(table, AxisAlignedBox::shape, Triangle::shape, ConvexPairDistance<AxisAlignedBox, Triangle>);
+    SetDistance(table, AxisAlignedBox::shape, ConvexHull::shape, ConvexPairDistance<AxisAlignedBox, ConvexHull>);
+
+    SetDistance(table, Box::shape, Box::shape, ConvexPairDistance<Box, Box>);
+    SetDistance(table, Box::shape, Frustum::shape, ConvexPairDistance<Box, Frustum>);
+    SetDistance(table, Box::shape, Triangle::shape, ConvexPairDistance<Box, Triangle>);
+    SetDistance(table, Box::shape, ConvexHull::shape, ConvexPairDistance<Box, ConvexHull>);
+
+    SetDistance(table, Frustum::shape, Frustum::shape, ConvexPairDistance<Frustum, Frustum>);
+    SetDistance(table, Frustum::shape, Triangle::shape, ConvexPairDistance<Frustum, Triangle>);
+    SetDistance(table, Frustum::shape, ConvexHull::shape, ConvexPairDistance<Frustum, ConvexHull>);
+
+    SetDistance(table, Triangle::shape, Triangle::shape, ConvexPairDistance<Triangle, Triangle>);
+    SetDistance(table, Triangle::shape, ConvexHull::shape, ConvexPairDistance<Triangle, ConvexHull>);
+
+    SetDistance(table, ConvexHull::shape, ConvexHull::shape, ConvexPairDistance<ConvexHull, ConvexHull>);
+
+    SetDistance(table, Plane::shape, Sphere::shape, PlaneDistance<Sphere>);
+    SetDistance(table, Plane::shape, AxisAlignedBox::shape, PlaneDistance<AxisAlignedBox>);
+    SetDistance(table, Plane::shape, Box::shape, PlaneDistance<Box>);
+    SetDistance(table, Plane::shape, Frustum::shape, PlaneDistance<Frustum>);
+    SetDistance(table, Plane::shape, Plane::shape, PlaneDistance<Plane>);
+    SetDistance(table, Plane::shape, Triangle::shape, PlaneDistance<Triangle>);
+    SetDistance(table, Plane::shape, ConvexHull::shape, PlaneDistance<ConvexHull>);
+
+    SetDistance(table, Mesh::shape, Sphere::shape, MeshDistance<Sphere>);
+    SetDistance(table, Mesh::shape, AxisAlignedBox::shape, MeshDistance<AxisAlignedBox>);
+    SetDistance(table, Mesh::shape, Box::shape, MeshDistance<Box>);
+    SetDistance(table, Mesh::shape, Frustum::shape, MeshDistance<Frustum>);
+    SetDistance(table, Mesh::shape, Plane::shape, MeshDistance<Plane>);
+    SetDistance(table, Mesh::shape, Triangle::shape, MeshDistance<Triangle>);
+    SetDistance(table, Mesh::shape, ConvexHull::shape, MeshDistance<ConvexHull>);
+    SetDistance(table, Mesh::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        return MinTriangleDistance(HierarchyOf(lhs), HierarchyOf(rhs), math::Matrix4x4::Identity);
+    });
+
+    SetDistance(table, MeshInstance::shape, Sphere::shape, InstanceDistance<Sphere>);
+    SetDistance(table, MeshInstance::shape, AxisAlignedBox::shape, InstanceDistance<AxisAlignedBox>);
+    SetDistance(table, MeshInstance::shape, Box::shape, InstanceDistance<Box>);
+    SetDistance(table, MeshInstance::shape, Frustum::shape, InstanceDistance<Frustum>);
+    SetDistance(table, MeshInstance::shape, Plane::shape, InstanceDistance<Plane>);
+    SetDistance(table, MeshInstance::shape, Triangle::shape, InstanceDistance<Triangle>);
+    SetDistance(table, MeshInstance::shape, ConvexHull::shape, InstanceDistance<ConvexHull>);
+    SetDistance(table, MeshInstance::shape, Mesh::shape, [](const Collision& lhs, const Collision& rhs) {
+        const float local_distance =
+            MinTriangleDistance(InstanceHierarchyOf(lhs), HierarchyOf(rhs), InstanceOf(lhs).LocalMatrix());
+        return WorldDistance(InstanceOf(lhs), local_distance);
+    });
+    SetDistance(table, MeshInstance::shape, MeshInstance::shape, [](const Collision& lhs, const Collision& rhs) {
+        const math::Matrix4x4 rhs_to_lhs = InstanceOf(rhs).WorldMatrix() * InstanceOf(lhs).LocalMatrix();
+        const float local_distance =
+            MinTriangleDistance(InstanceHierarchyOf(lhs), InstanceHierarchyOf(rhs), rhs_to_lhs);
+        return WorldDistance(InstanceOf(lhs), local_distance);
+    });
+
+    return table;
+}
+
+// Large enough to contain any scene, yet small enough for the broad phase to compute its area without overflow
+constexpr float unbounded_extent = 1e16f;
+
+math::AxisAlignedBox BoundsOf(const std::span<const math::Vector3> points) {
+    math::Vector3 min = points.front();
+    math::Vector3 max = points.front();
+    for (const math::Vector3& point : points.subspan(1)) {
+        min = math::Vector3::Min(min, point);
+        max = math::Vector3::Max(max, point);
     }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return sphere_.Intersects(plane->Primitive());
+    return math::AxisAlignedBox{(min + max) * 0.5f, (max - min) * 0.5f};
+}
+
+template <typename T>
+math::AxisAlignedBox CornerBoundsOf(const T& primitive) {
+    std::array<math::Vector3, T::CORNER_COUNT> corners;
+    primitive.GetCorners(corners.data());
+    return BoundsOf(corners);
+}
+
+// Constant initialized, so every lookup is a plain load without any guard
+constinit IntersectionTable intersections = BuiltinIntersections();
+constinit DistanceTable distances = BuiltinDistances();
+constinit CollisionShape next_shape = ConvexHullCollision::shape + 1;
+
+}  // namespace
+
+Collision::Collision(const CollisionShape shape) : shape_{shape}, layer_{default_layer} {}
+
+Collision::~Collision() = default;
+
+CollisionShape Collision::Shape() const {
+    return shape_;
+}
+
+CollisionLayer Collision::Layer() const {
+    return layer_;
+}
+
+void Collision::Layer(const CollisionLayer layer) {
+    assert(layer < max_layer_count && "Collision layer is out of range");
+    layer_ = layer;
+}
+
+float Collision::Distance(const Collision& other) const {
+    if (shape_ == unknown_shape) {
+        return math::Distance(Bounds(), other.Bounds());
     }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle->Primitive().Intersects(sphere_);
+    if (other.shape_ == unknown_shape) {
+        return other.Distance(*this);
+    }
+
+    const auto [function, is_swapped] = distances[shape_][other.shape_];
+    if (function == nullptr) {
+        return math::Distance(Bounds(), other.Bounds());
+    }
+    return is_swapped ? function(other, *this) : function(*this, other);
+}
+
+math::Vector3 Collision::ClosestPoint(const math::Vector3& point) const {
+    return math::ClosestPoint(Bounds(), point);
+}
+
+math::AxisAlignedBox Collision::Bounds() const {
+    return math::AxisAlignedBox{math::Vector3::Zero, math::Vector3{unbounded_extent}};
+}
+
+CollisionShape Collision::RegisterShape() {
+    if (next_shape >= max_shape_count) {
+        throw std::runtime_error{"Too many collision shapes were registered"};
+    }
+    return next_shape++;
+}
+
+void Collision::RegisterIntersection(const CollisionShape lhs, const CollisionShape rhs,
+                                     const IntersectionFunction function) {
+    assert(lhs != unknown_shape && rhs != unknown_shape && "Intersection of the unknown shape could not be registered");
+    SetIntersection(intersections, lhs, rhs, function);
+}
+
+void Collision::RegisterDistance(const CollisionShape lhs, const CollisionShape rhs, const DistanceFunction function) {
+    assert(lhs != unknown_shape && rhs != unknown_shape && "Distance of the unknown shape could not be registered");
+    SetDistance(distances, lhs, rhs, function);
+}
+
+bool Collision::IntersectsByShape(const Collision& other) const {
+    if (other.shape_ == unknown_shape) {
+        return other.Intersects(*this);
     }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(sphere_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
+
+    const auto [function, is_swapped] = intersections[shape_][other.shape_];
+    assert(function != nullptr && "Intersection function was not registered for these shapes");
+    if (function == nullptr) {
+        return false;
     }
-    return other.Intersects(*this);
+    return is_swapped ? function(other, *this) : function(*this, other);
+}
+
+SphereCollision::SphereCollision(const PrimitiveType& primitive) : Collision{shape}, sphere_{primitive} {}
+
+auto SphereCollision::Primitive() const -> const PrimitiveType& {
+    return sphere_;
+}
+
+auto SphereCollision::Primitive() -> PrimitiveType& {
+    return sphere_;
+}
+
+bool SphereCollision::Intersects(const Collision& other) const {
+    return IntersectsByShape(other);
 }
 
 bool SphereCollision::Intersects(const math::Ray& ray, float& dist) const {
     return ray.Intersects(sphere_, dist);
 }
 
-AxisAlignedBoxCollision::AxisAlignedBoxCollision(const PrimitiveType& primitive) : box_{primitive} {}
+math::Vector3 SphereCollision::ClosestPoint(const math::Vector3& point) const {
+    const math::Vector3 center{sphere_.Center};
+    const math::Vector3 offset = point - center;
+    const float distance = offset.Length();
+    return distance > sphere_.Radius ? center + offset * (sphere_.Radius / distance) : point;
+}
+
+math::AxisAlignedBox SphereCollision::Bounds() const {
+    math::AxisAlignedBox bounds;
+    math::AxisAlignedBox::CreateFromSphere(bounds, sphere_);
+    return bounds;
+}
+
+AxisAlignedBoxCollision::AxisAlignedBoxCollision(const PrimitiveType& primitive) : Collision{shape}, box_{primitive} {}
 
 auto AxisAlignedBoxCollision::Primitive() const -> const PrimitiveType& {
     return box_;
@@ -57,36 +765,22 @@ auto AxisAlignedBoxCollision::Primitive() -> PrimitiveType& {
 }
 
 bool AxisAlignedBoxCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return sphere->Primitive().Intersects(box_);
-    }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return axis_aligned_box->Primitive().Intersects(box_);
-    }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return box->Primitive().Intersects(box_);
-    }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return frustum->Primitive().Intersects(box_);
-    }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return box_.Intersects(plane->Primitive());
-    }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle->Primitive().Intersects(box_);
-    }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(box_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
-    }
-    return other.Intersects(*this);
+    return IntersectsByShape(other);
 }
 
 bool AxisAlignedBoxCollision::Intersects(const math::Ray& ray, float& dist) const {
     return ray.Intersects(box_, dist);
 }
 
-BoxCollision::BoxCollision(const PrimitiveType& primitive) : box_{primitive} {
+math::Vector3 AxisAlignedBoxCollision::ClosestPoint(const math::Vector3& point) const {
+    return math::ClosestPoint(box_, point);
+}
+
+math::AxisAlignedBox AxisAlignedBoxCollision::Bounds() const {
+    return box_;
+}
+
+BoxCollision::BoxCollision(const PrimitiveType& primitive) : Collision{shape}, box_{primitive} {
     math::Quaternion orientation{box_.Orientation};
     orientation.Normalize();
     box_.Orientation = orientation;
@@ -101,36 +795,30 @@ auto BoxCollision::Primitive() -> PrimitiveType& {
 }
 
 bool BoxCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return sphere->Primitive().Intersects(box_);
-    }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return axis_aligned_box->Primitive().Intersects(box_);
-    }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return box->Primitive().Intersects(box_);
-    }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return frustum->Primitive().Intersects(box_);
-    }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return box_.Intersects(plane->Primitive());
-    }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle->Primitive().Intersects(box_);
-    }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(box_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
-    }
-    return other.Intersects(*this);
+    return IntersectsByShape(other);
 }
 
 bool BoxCollision::Intersects(const math::Ray& ray, float& dist) const {
     return box_.Intersects(ray.position, ray.direction, dist);
 }
 
-FrustumCollision::FrustumCollision(const PrimitiveType& primitive) : frustum_{primitive} {}
+math::Vector3 BoxCollision::ClosestPoint(const math::Vector3& point) const {
+    // Clamped in the space of the box, where it is axis aligned
+    const math::Vector3 center{box_.Center};
+    const math::Quaternion orientation{box_.Orientation};
+    math::Quaternion inverse_orientation;
+    orientation.Conjugate(inverse_orientation);
+
+    const math::Vector3 local_point = math::Vector3::Transform(point - center, inverse_orientation);
+    const math::AxisAlignedBox local_box{math::Vector3::Zero, box_.Extents};
+    return center + math::Vector3::Transform(math::ClosestPoint(local_box, local_point), orientation);
+}
+
+math::AxisAlignedBox BoxCollision::Bounds() const {
+    return CornerBoundsOf(box_);
+}
+
+FrustumCollision::FrustumCollision(const PrimitiveType& primitive) : Collision{shape}, frustum_{primitive} {}
 
 auto FrustumCollision::Primitive() const -> const PrimitiveType& {
     return frustum_;
@@ -141,36 +829,22 @@ auto FrustumCollision::Primitive() -> PrimitiveType& {
 }
 
 bool FrustumCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return sphere->Primitive().Intersects(frustum_);
-    }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return axis_aligned_box->Primitive().Intersects(frustum_);
-    }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return box->Primitive().Intersects(frustum_);
-    }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return frustum->Primitive().Intersects(frustum_);
-    }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return frustum_.Intersects(plane->Primitive());
-    }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle->Primitive().Intersects(frustum_);
-    }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(frustum_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
-    }
-    return other.Intersects(*this);
+    return IntersectsByShape(other);
 }
 
 bool FrustumCollision::Intersects(const math::Ray& ray, float& dist) const {
     return frustum_.Intersects(ray.position, ray.direction, dist);
 }
 
-PlaneCollision::PlaneCollision(const PrimitiveType& primitive) : plane_{primitive} {}
+math::Vector3 FrustumCollision::ClosestPoint(const math::Vector3& point) const {
+    return ClosestPointOf(frustum_, point);
+}
+
+math::AxisAlignedBox FrustumCollision::Bounds() const {
+    return CornerBoundsOf(frustum_);
+}
+
+PlaneCollision::PlaneCollision(const PrimitiveType& primitive) : Collision{shape}, plane_{primitive} {}
 
 auto PlaneCollision::Primitive() const -> const PrimitiveType& {
     return plane_;
@@ -181,36 +855,24 @@ auto PlaneCollision::Primitive() -> PrimitiveType& {
 }
 
 bool PlaneCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return sphere->Primitive().Intersects(plane_);
-    }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return axis_aligned_box->Primitive().Intersects(plane_);
-    }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return box->Primitive().Intersects(plane_);
-    }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return frustum->Primitive().Intersects(plane_);
-    }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return math::Intersects(plane->Primitive(), plane_);
-    }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle->Primitive().Intersects(plane_);
-    }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(plane_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
-    }
-    return other.Intersects(*this);
+    return IntersectsByShape(other);
 }
 
 bool PlaneCollision::Intersects(const math::Ray& ray, float& dist) const {
     return ray.Intersects(plane_, dist);
 }
 
-TriangleCollision::TriangleCollision(const PrimitiveType& primitive) : triangle_{primitive} {}
+math::Vector3 PlaneCollision::ClosestPoint(const math::Vector3& point) const {
+    const math::Vector3 normal = plane_.Normal();
+    const float height = plane_.DotCoordinate(point);
+    return height > 0.0f ? point - normal * (height / normal.LengthSquared()) : point;
+}
+
+math::AxisAlignedBox PlaneCollision::Bounds() const {
+    return Collision::Bounds();
+}
+
+TriangleCollision::TriangleCollision(const PrimitiveType& primitive) : Collision{shape}, triangle_{primitive} {}
 
 auto TriangleCollision::Primitive() const -> const PrimitiveType& {
     return triangle_;
@@ -221,46 +883,44 @@ auto TriangleCollision::Primitive() -> PrimitiveType& {
 }
 
 bool TriangleCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        return triangle_.Intersects(sphere->Primitive());
-    }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        return triangle_.Intersects(axis_aligned_box->Primitive());
-    }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        return triangle_.Intersects(box->Primitive());
-    }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        return triangle_.Intersects(frustum->Primitive());
-    }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        return triangle_.Intersects(plane->Primitive());
-    }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        return triangle_.Intersects(triangle->Primitive());
-    }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(triangle_); };
-        return std::ranges::any_of(mesh->Triangles(), intersects);
-    }
-    return other.Intersects(*this);
+    return IntersectsByShape(other);
 }
 
 bool TriangleCollision::Intersects(const math::Ray& ray, float& dist) const {
     return triangle_.Intersects(ray, dist);
 }
 
+math::Vector3 TriangleCollision::ClosestPoint(const math::Vector3& point) const {
+    return triangle_.ClosestPoint(point);
+}
+
+math::AxisAlignedBox TriangleCollision::Bounds() const {
+    const std::array points{triangle_.point0, triangle_.point1, triangle_.point2};
+    return BoundsOf(points);
+}
+
 MeshCollision::MeshCollision(const VertexCollection& vertices, const IndexCollection& indices)
-    : vertices_{vertices}, indices_{indices} {}
+    : Collision{shape},
+      vertices_{vertices},
+      indices_{indices},
+      hierarchy_{vertices_, indices_},
+      is_hierarchy_dirty_{},
+      are_vertices_moved_{} {}
 
 MeshCollision::MeshCollision(VertexCollection&& vertices, IndexCollection&& indices)
-    : vertices_{std::move(vertices)}, indices_{std::move(indices)} {}
+    : Collision{shape},
+      vertices_{std::move(vertices)},
+      indices_{std::move(indices)},
+      hierarchy_{vertices_, indices_},
+      is_hierarchy_dirty_{},
+      are_vertices_moved_{} {}
 
 auto MeshCollision::Vertices() const -> const VertexCollection& {
     return vertices_;
 }
 
 auto MeshCollision::Vertices() -> VertexCollection& {
+    are_vertices_moved_ = true;
     return vertices_;
 }
 
@@ -269,54 +929,239 @@ auto MeshCollision::Indices() const -> const IndexCollection& {
 }
 
 auto MeshCollision::Indices() -> IndexCollection& {
+    is_hierarchy_dirty_ = true;
     return indices_;
 }
 
-bool MeshCollision::Intersects(const Collision& other) const {
-    if (const auto sphere = dynamic_cast<const SphereCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(sphere->Primitive()); };
-        return std::ranges::any_of(Triangles(), intersects);
+const TriangleBvh& MeshCollision::Hierarchy() const {
+    if (is_hierarchy_dirty_) {
+        hierarchy_ = TriangleBvh{vertices_, indices_};
+        is_hierarchy_dirty_ = false;
+        are_vertices_moved_ = false;
+    } else if (are_vertices_moved_) {
+        hierarchy_.Refit(vertices_, indices_);
+        are_vertices_moved_ = false;
     }
-    if (const auto axis_aligned_box = dynamic_cast<const AxisAlignedBoxCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) {
-            return triangle.Intersects(axis_aligned_box->Primitive());
-        };
-        return std::ranges::any_of(Triangles(), intersects);
+    return hierarchy_;
+}
+
+bool MeshCollision::Intersects(const Collision& other) const {
+    return IntersectsByShape(other);
+}
+
+bool MeshCollision::Intersects(const math::Ray& ray, float& dist) const {
+    return Hierarchy().Intersects(ray, dist);
+}
+
+math::Vector3 MeshCollision::ClosestPoint(const math::Vector3& point) const {
+    PointHit hit;
+    return ClosestPoint(point, hit) ? hit.point : point;
+}
+
+bool MeshCollision::ClosestHit(const math::Ray& ray, RayHit& hit, const float max_distance) const {
+    return Hierarchy().ClosestHit(ray, hit, max_distance);
+}
+
+bool MeshCollision::AnyHit(const math::Ray& ray, const float max_distance) const {
+    return Hierarchy().AnyHit(ray, max_distance);
+}
+
+std::uint32_t MeshCollision::ClosestHits(const RayPacket& rays, const std::span<RayHit> hits) const {
+    return Hierarchy().ClosestHits(rays, hits);
+}
+
+bool MeshCollision::ClosestPoint(const math::Vector3& point, PointHit& hit, const float max_distance) const {
+    return Hierarchy().ClosestPoint(point, hit, max_distance);
+}
+
+math::AxisAlignedBox MeshCollision::Bounds() const {
+    const std::span nodes = Hierarchy().Nodes();
+    return nodes.empty() ? math::AxisAlignedBox{math::Vector3::Zero, math::Vector3::Zero} : nodes.front().bounds;
+}
+
+MeshInstanceCollision::MeshInstanceCollision(std::shared_ptr<const MeshCollision> mesh,
+                                             const borov_engine::Transform& transform)
+    : Collision{shape},
+      mesh_{std::move(mesh)},
+      transform_{transform} {
+    assert(mesh_ != nullptr && "Instance must refer to some mesh");
+}
+
+auto MeshInstanceCollision::Mesh() const -> const std::shared_ptr<const MeshCollision>& {
+    return mesh_;
+}
+
+auto MeshInstanceCollision::Mesh() -> std::shared_ptr<const MeshCollision>& {
+    return mesh_;
+}
+
+auto MeshInstanceCollision::Transform() const -> const borov_engine::Transform& {
+    return transform_;
+}
+
+auto MeshInstanceCollision::Transform() -> borov_engine::Transform& {
+    return transform_;
+}
+
+math::Matrix4x4 MeshInstanceCollision::WorldMatrix() const {
+    return transform_.ToMatrix();
+}
+
+math::Matrix4x4 MeshInstanceCollision::LocalMatrix() const {
+    // Inverse of the scaled and rotated transform is not the transform itself, so the matrix is inverted instead
+    return transform_.ToMatrix().Invert();
+}
+
+bool MeshInstanceCollision::Intersects(const Collision& other) const {
+    return IntersectsByShape(other);
+}
+
+bool MeshInstanceCollision::Intersects(const math::Ray& ray, float& dist) const {
+    RayHit hit;
+    if (!ClosestHit(ray, hit)) {
+        return false;
     }
-    if (const auto box = dynamic_cast<const BoxCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(box->Primitive()); };
-        return std::ranges::any_of(Triangles(), intersects);
+    dist = hit.distance;
+    return true;
+}
+
+math::Vector3 MeshInstanceCollision::ClosestPoint(const math::Vector3& point) const {
+    PointHit hit;
+    return ClosestPoint(point, hit) ? hit.point : point;
+}
+
+bool MeshInstanceCollision::ClosestHit(const math::Ray& ray, RayHit& hit, const float max_distance) const {
+    const LocalRay local_ray = ToLocal(ray);
+    if (!mesh_->ClosestHit(local_ray.ray, hit, max_distance * local_ray.scale)) {
+        return false;
     }
-    if (const auto frustum = dynamic_cast<const FrustumCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(frustum->Primitive()); };
-        return std::ranges::any_of(Triangles(), intersects);
+    hit.distance /= local_ray.scale;
+    return true;
+}
+
+bool MeshInstanceCollision::AnyHit(const math::Ray& ray, const float max_distance) const {
+    const LocalRay local_ray = ToLocal(ray);
+    return mesh_->AnyHit(local_ray.ray, max_distance * local_ray.scale);
+}
+
+bool MeshInstanceCollision::ClosestPoint(const math::Vector3& point, PointHit& hit, const float max_distance) const {
+    // Points nearer than the max distance in the world are never farther than it divided by the smallest scale
+    // in the space of the mesh, and the distance of the hit is measured again in the world
+    const math::Vector3 local_point = math::Vector3::Transform(point, LocalMatrix());
+    if (!mesh_->ClosestPoint(local_point, hit, max_distance / MinScaleOf(transform_))) {
+        return false;
     }
-    if (const auto plane = dynamic_cast<const PlaneCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& triangle) { return triangle.Intersects(plane->Primitive()); };
-        return std::ranges::any_of(Triangles(), intersects);
+    hit.point = math::Vector3::Transform(hit.point, WorldMatrix());
+    hit.distance = math::Vector3::Distance(point, hit.point);
+    return hit.distance < max_distance;
+}
+
+math::AxisAlignedBox MeshInstanceCollision::Bounds() const {
+    std::array<math::Vector3, math::AxisAlignedBox::CORNER_COUNT> corners;
+    mesh_->Bounds().GetCorners(corners.data());
+
+    const math::Matrix4x4 world_matrix = WorldMatrix();
+    for (math::Vector3& corner : corners) {
+        corner = math::Vector3::Transform(corner, world_matrix);
     }
-    if (const auto triangle = dynamic_cast<const TriangleCollision*>(&other)) {
-        auto intersects = [=](const math::Triangle& other_triangle) {
-            return other_triangle.Intersects(triangle->Primitive());
-        };
-        return std::ranges::any_of(Triangles(), intersects);
+    return BoundsOf(corners);
+}
+
+auto MeshInstanceCollision::ToLocal(const math::Ray& ray) const -> LocalRay {
+    // Direction stays normalized, so distances along it are scaled the same way as the mesh
+    const math::Matrix4x4 local_matrix = LocalMatrix();
+    math::Vector3 direction = math::Vector3::TransformNormal(ray.direction, local_matrix);
+    const float scale = direction.Length();
+    direction /= scale;
+    return LocalRay{
+        .ray = math::Ray{math::Vector3::Transform(ray.position, local_matrix), direction},
+        .scale = scale,
+    };
+}
+
+ConvexHullCollision::ConvexHullCollision(std::shared_ptr<const Quickhull> hull, const borov_engine::Transform& transform)
+    : Collision{shape},
+      hull_{std::move(hull)},
+      transform_{transform} {
+    assert(hull_ != nullptr && !hull_->Vertices().empty() && "Hull must have at least one vertex");
+}
+
+auto ConvexHullCollision::Hull() const -> const std::shared_ptr<const Quickhull>& {
+    return hull_;
+}
+
+auto ConvexHullCollision::Hull() -> std::shared_ptr<const Quickhull>& {
+    return hull_;
+}
+
+auto ConvexHullCollision::Transform() const -> const borov_engine::Transform& {
+    return transform_;
+}
+
+auto ConvexHullCollision::Transform() -> borov_engine::Transform& {
+    return transform_;
+}
+
+math::Matrix4x4 ConvexHullCollision::WorldMatrix() const {
+    return transform_.ToMatrix();
+}
+
+math::Matrix4x4 ConvexHullCollision::LocalMatrix() const {
+    return transform_.ToMatrix().Invert();
+}
+
+bool ConvexHullCollision::Intersects(const Collision& other) const {
+    return IntersectsByShape(other);
+}
+
+bool ConvexHullCollision::Intersects(const math::Ray& ray, float& dist) const {
+    // Ray is clipped by the planes of every face in the space of the hull, where the direction stays unnormalized
+    // so that the distances along it are the same as in the world
+    const math::Matrix4x4 local_matrix = LocalMatrix();
+    const math::Vector3 origin = math::Vector3::Transform(ray.position, local_matrix);
+    const math::Vector3 direction = math::Vector3::TransformNormal(ray.direction, local_matrix);
+
+    const std::span vertices = hull_->Vertices();
+    const std::span indices = hull_->Indices();
+    if (indices.empty()) {
+        return false;
     }
-    if (const auto mesh = dynamic_cast<const MeshCollision*>(&other)) {
-        for (const math::Triangle& triangle : Triangles()) {
-            // ReSharper disable once CppTooWideScopeInitStatement
-            auto intersects = [=](const math::Triangle& other_triangle) { return triangle.Intersects(other_triangle); };
-            if (std::ranges::any_of(mesh->Triangles(), intersects)) {
-                return true;
+
+    float entry = 0.0f;
+    float exit = std::numeric_limits<float>::infinity();
+    for (std::size_t index = 0; index + 2 < indices.size(); index += 3) {
+        const math::Vector3& point = vertices[indices[index]];
+        const math::Vector3 normal =
+            (vertices[indices[index + 1]] - point).Cross(vertices[indices[index + 2]] - point);
+        const float height = normal.Dot(point - origin);
+        const float speed = normal.Dot(direction);
+        if (speed == 0.0f) {
+            if (height < 0.0f) {
+                return false;
             }
+            continue;
+        }
+
+        const float distance = height / speed;
+        if (speed < 0.0f) {
+            entry = (std::max)(entry, distance);
+        } else {
+            exit = (std::min)(exit, distance);
+        }
+        if (entry > exit) {
+            return false;
         }
-        return false;
     }
-    return other.Intersects(*this);
+    dist = entry;
+    return true;
 }
 
-bool MeshCollision::Intersects(const math::Ray& ray, float& dist) const {
-    auto intersects = [&](const math::Triangle& triangle) { return triangle.Intersects(ray, dist); };
-    return std::ranges::any_of(Triangles(), intersects);
+math::Vector3 ConvexHullCollision::ClosestPoint(const math::Vector3& point) const {
+    return ClosestPointOf(Placed(*this), point);
+}
+
+math::AxisAlignedBox ConvexHullCollision::Bounds() const {
+    return BoundsOf(Placed(*this));
 }
 
 }  // namespace borov_engine
@@ -0,0 +1,364 @@
+#include "borov_engine/collision_proxy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace borov_engine {
+
+namespace {
+
+using Index = CollisionProxy::Index;
+
+constexpr std::uint32_t cache_magic = 0x58525042;  // "BPRX"
+constexpr std::uint32_t cache_version = 1;
+
+// Cache is valid only for the same mesh file and the same options
+struct CacheStamp {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t mesh_size;
+    std::int64_t mesh_write_time;
+    std::uint64_t max_part_count;
+    float split_volume_ratio;
+
+    friend bool operator==(const CacheStamp &, const CacheStamp &) = default;
+};
+
+float Volume(const math::Box &box) {
+    return 8.0f * box.Extents.x * box.Extents.y * box.Extents.z;
+}
+
+// One face of the minimal box lies on some face of the hull in most cases, so the boxes flush with every face
+// and aligned with its edges are tried, together with the principal axes of the points
+math::Box FitBox(const Quickhull &hull) {
+    const std::span vertices = hull.Vertices();
+    const std::span indices = hull.Indices();
+
+    math::Box best;
+    math::Box::CreateFromPoints(best, vertices.size(), vertices.data(), sizeof(math::Vector3));
+    float best_volume = Volume(best);
+
+    for (std::size_t index = 0; index + 2 < indices.size(); index += 3) {
+        const std::array points{vertices[indices[index]], vertices[indices[index + 1]], vertices[indices[index + 2]]};
+        math::Vector3 normal = (points[1] - points[0]).Cross(points[2] - points[0]);
+        if (normal.LengthSquared() <= std::numeric_limits<float>::min()) {
+            continue;
+        }
+        normal.Normalize();
+
+        for (std::size_t edge = 0; edge < 3; ++edge) {
+            math::Vector3 tangent = points[(edge + 1) % 3] - points[edge];
+            if (tangent.LengthSquared() <= std::numeric_limits<float>::min()) {
+                continue;
+            }
+            tangent.Normalize();
+            const math::Vector3 binormal = normal.Cross(tangent);
+
+            math::Vector3 min{std::numeric_limits<float>::infinity()};
+            math::Vector3 max{-std::numeric_limits<float>::infinity()};
+            for (const math::Vector3 &vertex : vertices) {
+                const math::Vector3 local{vertex.Dot(tangent), vertex.Dot(binormal), vertex.Dot(normal)};
+                min = math::Vector3::Min(min, local);
+                max = math::Vector3::Max(max, local);
+            }
+            const math::Vector3 extents = (max - min) * 0.5f;
+            const float volume = 8.0f * extents.x * extents.y * extents.z;
+            if (volume >= best_volume) {
+                continue;
+            }
+
+            // Rows are the images of the local axes, and `tangent x binormal = normal` keeps it a rotation
+            const math::Matrix4x4 rotation{tangent, binormal, normal};
+            const math::Vector3 local_center = (min + max) * 0.5f;
+            best.Center = tangent * local_center.x + binormal * local_center.y + normal * local_center.z;
+            best.Extents = extents;
+            best.Orientation = math::Quaternion::CreateFromRotationMatrix(rotation);
+            best_volume = volume;
+        }
+    }
+    return best;
+}
+
+// Ritter's sphere is usually tight, but the one around the box wins for long and flat meshes
+math::Sphere FitSphere(const Quickhull &hull, const math::Box &box) {
+    const std::span vertices = hull.Vertices();
+
+    math::Sphere best;
+    math::Sphere::CreateFromPoints(best, vertices.size(), vertices.data(), sizeof(math::Vector3));
+
+    const math::Vector3 center{box.Center};
+    float radius_squared = 0.0f;
+    for (const math::Vector3 &vertex : vertices) {
+        radius_squared = (std::max)(radius_squared, math::Vector3::DistanceSquared(center, vertex));
+    }
+    if (const float radius = std::sqrt(radius_squared); radius < best.Radius) {
+        best = math::Sphere{center, radius};
+    }
+    return best;
+}
+
+struct Part {
+    std::vector<Index> triangles;
+    CollisionProxy::HullPointer hull;
+    bool is_final;
+};
+
+CollisionProxy::HullPointer HullOf(const std::span<const math::Vector3> vertices, const std::span<const Index> indices,
+                                   const std::span<const Index> triangles) {
+    std::vector<math::Vector3> points;
+    points.reserve(triangles.size() * 3);
+    for (const Index triangle : triangles) {
+        for (std::size_t corner = 0; corner < 3; ++corner) {
+            points.push_back(vertices[indices[triangle * 3 + corner]]);
+        }
+    }
+    return std::make_shared<const Quickhull>(points);
+}
+
+// Approximate decomposition by recursive halving: the part with the largest hull is split in two
+// by its triangle centroids across the longest axis, and the split is kept only if it removes
+// enough empty space from the hull, which is where the concave regions of the part are
+CollisionProxy::PartCollection Decompose(const std::span<const math::Vector3> vertices,
+                                         const std::span<const Index> indices, const CollisionProxy::HullPointer &hull,
+                                         const CollisionProxyOptions &options) {
+    std::vector<Part> parts(1);
+    parts.front().triangles.resize(indices.size() / 3);
+    for (Index triangle = 0; triangle < parts.front().triangles.size(); ++triangle) {
+        parts.front().triangles[triangle] = triangle;
+    }
+    parts.front().hull = hull;
+    parts.front().is_final = parts.front().triangles.size() < 2;
+
+    const auto centroid = [&](const Index triangle) {
+        return (vertices[indices[triangle * 3]] + vertices[indices[triangle * 3 + 1]] +
+                vertices[indices[triangle * 3 + 2]]) /
+               3.0f;
+    };
+
+    while (parts.size() < options.max_part_count) {
+        const auto part = std::ranges::max_element(parts, std::less{}, [](const Part &candidate) {
+            return candidate.is_final ? -std::numeric_limits<float>::infinity() : candidate.hull->Volume();
+        });
+        if (part->is_final) {
+            break;
+        }
+
+        math::Vector3 min{std::numeric_limits<float>::infinity()};
+        math::Vector3 max{-std::numeric_limits<float>::infinity()};
+        math::Vector3 mean;
+        for (const Index triangle : part->triangles) {
+            const math::Vector3 center = centroid(triangle);
+            min = math::Vector3::Min(min, center);
+            max = math::Vector3::Max(max, center);
+            mean += center;
+        }
+        mean /= static_cast<float>(part->triangles.size());
+
+        const math::Vector3 size = max - min;
+        const std::size_t axis = size.x >= size.y && size.x >= size.z ? 0 : (size.y >= size.z ? 1 : 2);
+        const auto middle = std::ranges::partition(part->triangles, [&](const Index triangle) {
+            const math::Vector3 center = centroid(triangle);
+            return (&center.x)[axis] < (&mean.x)[axis];
+        });
+        const auto split = static_cast<std::size_t>(middle.begin() - part->triangles.begin());
+        if (split == 0 || split == part->triangles.size()) {
+            part->is_final = true;
+            continue;
+        }
+
+        const std::span triangles{part->triangles};
+        CollisionProxy::HullPointer lhs = HullOf(vertices, indices, triangles.first(split));
+        CollisionProxy::HullPointer rhs = HullOf(vertices, indices, triangles.subspan(split));
+        if (lhs->Volume() + rhs->Volume() >= options.split_volume_ratio * part->hull->Volume()) {
+            part->is_final = true;
+            continue;
+        }
+
+        std::vector<Index> rhs_triangles(triangles.begin() + split, triangles.end());
+        part->triangles.resize(split);
+        part->hull = std::move(lhs);
+        part->is_final = part->triangles.size() < 2;
+
+        const bool is_rhs_final = rhs_triangles.size() < 2;
+        parts.push_back(Part{.triangles = std::move(rhs_triangles), .hull = std::move(rhs), .is_final = is_rhs_final});
+    }
+
+    CollisionProxy::PartCollection result;
+    result.reserve(parts.size());
+    for (Part &part : parts) {
+        result.push_back(std::move(part.hull));
+    }
+    return result;
+}
+
+// Missing or unreadable mesh gets the empty stamp, so its cache is never used
+CacheStamp StampOf(const std::filesystem::path &mesh_path, const CollisionProxyOptions &options) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(mesh_path, error);
+    const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(mesh_path, error);
+    return CacheStamp{
+        .magic = cache_magic,
+        .version = cache_version,
+        .mesh_size = error ? 0 : static_cast<std::uint64_t>(size),
+        .mesh_write_time = error ? 0 : static_cast<std::int64_t>(write_time.time_since_epoch().count()),
+        .max_part_count = static_cast<std::uint64_t>(options.max_part_count),
+        .split_volume_ratio = options.split_volume_ratio,
+    };
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+void Write(std::ostream &stream, const T &value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+void Write(std::ostream &stream, const std::span<const T> values) {
+    Write(stream, static_cast<std::uint64_t>(values.size()));
+    stream.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+bool Read(std::istream &stream, T &value) {
+    return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+// Size is checked against the rest of the file, so the corrupted cache never allocates too much
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+bool Read(std::istream &stream, std::vector<T> &values, const std::uint64_t remaining_size) {
+    std::uint64_t size;
+    if (!Read(stream, size) || size > remaining_size / sizeof(T)) {
+        return false;
+    }
+    values.resize(static_cast<std::size_t>(size));
+    return static_cast<bool>(
+        stream.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(size * sizeof(T))));
+}
+
+void WriteHull(std::ostream &stream, const Quickhull &hull) {
+    Write(stream, hull.Vertices());
+    Write(stream, hull.Indices());
+}
+
+CollisionProxy::HullPointer ReadHull(std::istream &stream, const std::uint64_t file_size) {
+    std::vector<math::Vector3> vertices;
+    std::vector<Index> indices;
+    if (!Read(stream, vertices, file_size) || !Read(stream, indices, file_size)) {
+        return nullptr;
+    }
+    if (std::ranges::any_of(indices, [&](const Index index) { return index >= vertices.size(); })) {
+        return nullptr;
+    }
+    return std::make_shared<const Quickhull>(std::move(vertices), std::move(indices));
+}
+
+}  // namespace
+
+CollisionProxy::CollisionProxy() : hull_{std::make_shared<const Quickhull>()}, parts_{hull_} {}
+
+CollisionProxy::CollisionProxy(const std::span<const math::Vector3> vertices, const std::span<const Index> indices,
+                               const CollisionProxyOptions &options)
+    : hull_{std::make_shared<const Quickhull>(vertices)} {
+    if (!hull_->Vertices().empty()) {
+        box_ = FitBox(*hull_);
+        sphere_ = FitSphere(*hull_, box_);
+    }
+
+    const std::span complete_indices = indices.first(indices.size() - indices.size() % 3);
+    parts_ = options.max_part_count > 1 ? Decompose(vertices, complete_indices, hull_, options) : PartCollection{hull_};
+}
+
+CollisionProxy::CollisionProxy(const math::Box &box, const math::Sphere &sphere, HullPointer hull,
+                               PartCollection &&parts)
+    : box_{box},
+      sphere_{sphere},
+      hull_{std::move(hull)},
+      parts_{std::move(parts)} {
+    if (parts_.empty()) {
+        parts_.push_back(hull_);
+    }
+}
+
+CollisionProxy CollisionProxy::Import(const std::filesystem::path &mesh_path,
+                                      const std::span<const math::Vector3> vertices,
+                                      const std::span<const Index> indices, const CollisionProxyOptions &options) {
+    const std::filesystem::path cache_path = CachePath(mesh_path);
+    const CacheStamp stamp = StampOf(mesh_path, options);
+
+    if (std::ifstream stream{cache_path, std::ios::binary}) {
+        std::error_code error;
+        const std::uint64_t file_size = std::filesystem::file_size(cache_path, error);
+
+        CacheStamp cached_stamp;
+        math::Box box;
+        math::Sphere sphere;
+        std::uint64_t part_count;
+        if (!error && Read(stream, cached_stamp) && cached_stamp == stamp && Read(stream, box) &&
+            Read(stream, sphere) && Read(stream, part_count) && part_count <= file_size) {
+            HullPointer hull = ReadHull(stream, file_size);
+            PartCollection parts;
+            for (std::uint64_t part = 0; hull != nullptr && part < part_count; ++part) {
+                if (HullPointer part_hull = ReadHull(stream, file_size)) {
+                    parts.push_back(std::move(part_hull));
+                } else {
+                    hull = nullptr;
+                }
+            }
+            if (hull != nullptr) {
+                return CollisionProxy{box, sphere, std::move(hull), std::move(parts)};
+            }
+        }
+    }
+
+    CollisionProxy proxy{vertices, indices, options};
+    if (std::ofstream stream{cache_path, std::ios::binary | std::ios::trunc}) {
+        // Proxy which was not decomposed stores its hull once
+        const bool is_whole = proxy.parts_.size() == 1 && proxy.parts_.front() == proxy.hull_;
+
+        Write(stream, stamp);
+        Write(stream, proxy.box_);
+        Write(stream, proxy.sphere_);
+        Write(stream, static_cast<std::uint64_t>(is_whole ? 0 : proxy.parts_.size()));
+        WriteHull(stream, *proxy.hull_);
+        if (!is_whole) {
+            for (const HullPointer &part : proxy.parts_) {
+                WriteHull(stream, *part);
+            }
+        }
+    }
+    return proxy;
+}
+
+std::filesystem::path CollisionProxy::CachePath(const std::filesystem::path &mesh_path) {
+    std::filesystem::path cache_path = mesh_path;
+    cache_path += ".proxy";
+    return cache_path;
+}
+
+const math::Box &CollisionProxy::Box() const {
+    return box_;
+}
+
+const math::Sphere &CollisionProxy::Sphere() const {
+    return sphere_;
+}
+
+auto CollisionProxy::Hull() const -> const HullPointer & {
+    return hull_;
+}
+
+auto CollisionProxy::Parts() const -> const PartCollection & {
+    return parts_;
+}
+
+}  // namespace borov_engine
@@ -0,0 +1,459 @@
+#include "borov_engine/collision_world.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <span>
+
+#include "borov_engine/thread_pool.hpp"
+#include "borov_engine/tree_broad_phase.hpp"
+
+namespace borov_engine {
+
+namespace {
+
+// Queries are cheap one by one, so every chunk of the batch is large enough to outweigh scheduling it
+constexpr std::size_t ray_chunk_packet_count = 4;
+constexpr std::size_t overlap_chunk_size = 16;
+constexpr std::size_t sweep_chunk_size = 4;
+
+// Sweep stops this close to the contact, relative to the larger of the radius and the length of the sweep
+constexpr float sweep_tolerance = 1e-4f;
+// Sphere sliding along the surface approaches it ever slower, so after this many steps it is reported to touch
+// the collision where it stopped, which is never past the real contact
+constexpr std::size_t max_sweep_step_count = 64;
+
+void BringHierarchyUpToDate(const Collision &collision) {
+    if (collision.Shape() == MeshCollision::shape) {
+        static_cast<void>(static_cast<const MeshCollision &>(collision).Hierarchy());
+    } else if (collision.Shape() == MeshInstanceCollision::shape) {
+        if (const auto &mesh = static_cast<const MeshInstanceCollision &>(collision).Mesh(); mesh != nullptr) {
+            static_cast<void>(mesh->Hierarchy());
+        }
+    }
+}
+
+// Layers out of range are on none of the masks, shifting by them would be undefined
+bool HasLayer(const CollisionLayerMask layer_mask, const CollisionLayer layer) {
+    return layer < Collision::max_layer_count && ((layer_mask >> layer) & 1);
+}
+
+bool IsOnLayers(const Collision &collision, const CollisionLayerMask layer_mask) {
+    return HasLayer(layer_mask, collision.Layer());
+}
+
+}  // namespace
+
+CollisionWorld::CollisionWorld() : broad_phase_{std::make_unique<TreeBroadPhase>()}, layer_matrix_{} {
+    layer_matrix_.fill(~CollisionLayerMask{});
+}
+
+void CollisionWorld::Add(Collision &collision) {
+    assert(!Contains(collision) && "Collision was already added to the world");
+
+    const BroadPhase::ProxyId proxy = broad_phase_->Add(collision.Bounds());
+    SetProxy(proxy, collision);
+
+    entry_indices_.emplace(&collision, entries_.size());
+    entries_.push_back(Entry{.collision = &collision, .proxy = proxy});
+}
+
+void CollisionWorld::Remove(const Collision &collision) {
+    const auto it = entry_indices_.find(&collision);
+    if (it == entry_indices_.end()) {
+        return;
+    }
+
+    const std::size_t index = it->second;
+    const BroadPhase::ProxyId proxy = entries_[index].proxy;
+    broad_phase_->Remove(proxy);
+    proxy_collisions_[proxy] = nullptr;
+
+    // Last entry takes the place of the removed one
+    if (index + 1 != entries_.size()) {
+        entries_[index] = entries_.back();
+        entry_indices_[entries_[index].collision] = index;
+    }
+    entries_.pop_back();
+    entry_indices_.erase(it);
+
+    // Overlaps which have begun for the handlers end with the removal, while the collision is still alive.
+    // Pending begun ones are not among them, since the handlers never heard of them
+    const auto has_collision = [&](const CollisionPair &pair) {
+        return pair.first == &collision || pair.second == &collision;
+    };
+    const std::span pending_begun_overlaps = std::span{begun_overlaps_}.subspan(next_begun_overlap_);
+    std::vector<CollisionPair> removed_overlaps;
+    for (const CollisionPair &pair : contacts_) {
+        const auto is_same = [&pair](const CollisionPair &other) {
+            return other.first == pair.first && other.second == pair.second;
+        };
+        if (has_collision(pair) && std::ranges::none_of(pending_begun_overlaps, is_same)) {
+            removed_overlaps.push_back(pair);
+        }
+    }
+    std::ranges::copy_if(std::span{ended_overlaps_}.subspan(next_ended_overlap_),
+                         std::back_inserter(removed_overlaps), has_collision);
+
+    // Pairs of the last update must not point to the removed collision, even the ones still waiting for the broadcast
+    std::erase_if(pairs_, has_collision);
+    std::erase_if(contacts_, has_collision);
+    std::erase_if(contact_proxies_, [proxy](const BroadPhase::ProxyPair &pair) {
+        return pair.first == proxy || pair.second == proxy;
+    });
+    for (auto *overlaps : {&begun_overlaps_, &ended_overlaps_}) {
+        std::ranges::replace_if(*overlaps, has_collision, CollisionPair{});
+    }
+
+    for (const CollisionPair &pair : removed_overlaps) {
+        on_end_overlap_.Broadcast(pair);
+    }
+}
+
+bool CollisionWorld::Contains(const Collision &collision) const {
+    return entry_indices_.contains(&collision);
+}
+
+std::size_t CollisionWorld::Size() const {
+    return entries_.size();
+}
+
+const BroadPhase &CollisionWorld::BroadPhase() const {
+    return *broad_phase_;
+}
+
+BroadPhase &CollisionWorld::BroadPhase() {
+    return *broad_phase_;
+}
+
+CollisionLayerMask CollisionWorld::LayerMask(const CollisionLayer layer) const {
+    assert(layer < Collision::max_layer_count && "Collision layer is out of range");
+    return (layer < Collision::max_layer_count) ? layer_matrix_[layer] : CollisionLayerMask{};
+}
+
+void CollisionWorld::LayerMask(const CollisionLayer layer, const CollisionLayerMask mask) {
+    assert(layer < Collision::max_layer_count && "Collision layer is out of range");
+    for (CollisionLayer other = 0; other < Collision::max_layer_count; ++other) {
+        LayerCollision(layer, other, (mask >> other) & 1);
+    }
+}
+
+void CollisionWorld::LayerCollision(const CollisionLayer lhs, const CollisionLayer rhs, const bool is_enabled) {
+    assert(lhs < Collision::max_layer_count && rhs < Collision::max_layer_count && "Collision layer is out of range");
+    if (lhs >= Collision::max_layer_count || rhs >= Collision::max_layer_count) {
+        return;
+    }
+
+    const auto set_bit = [is_enabled](CollisionLayerMask &mask, const CollisionLayer layer) {
+        const CollisionLayerMask bit = CollisionLayerMask{1} << layer;
+        mask = is_enabled ? (mask | bit) : (mask & ~bit);
+    };
+    set_bit(layer_matrix_[lhs], rhs);
+    set_bit(layer_matrix_[rhs], lhs);
+}
+
+bool CollisionWorld::CanCollide(const Collision &lhs, const Collision &rhs) const {
+    return HasLayer(LayerMask(lhs.Layer()), rhs.Layer());
+}
+
+void CollisionWorld::Update() {
+    for (const auto &[collision, proxy] : entries_) {
+        broad_phase_->Move(proxy, collision->Bounds());
+        proxy_layers_[proxy] = collision->Layer();
+    }
+    broad_phase_->UpdatePairs();
+
+    FilterPairs();
+    pairs_.clear();
+    pairs_.reserve(candidate_proxies_.size());
+    for (const auto &[first, second] : candidate_proxies_) {
+        pairs_.push_back(CollisionPair{.first = proxy_collisions_[first], .second = proxy_collisions_[second]});
+    }
+
+    FindContacts();
+    BroadcastOverlaps();
+}
+
+std::span<const CollisionPair> CollisionWorld::CandidatePairs() const {
+    return pairs_;
+}
+
+std::span<const CollisionPair> CollisionWorld::Contacts() const {
+    return contacts_;
+}
+
+const OnCollisionOverlap &CollisionWorld::OnBeginOverlap() const {
+    return on_begin_overlap_;
+}
+
+OnCollisionOverlap &CollisionWorld::OnBeginOverlap() {
+    return on_begin_overlap_;
+}
+
+const OnCollisionOverlap &CollisionWorld::OnEndOverlap() const {
+    return on_end_overlap_;
+}
+
+OnCollisionOverlap &CollisionWorld::OnEndOverlap() {
+    return on_end_overlap_;
+}
+
+void CollisionWorld::Raycast(const std::span<const math::Ray> rays, const std::span<RaycastHit> hits,
+                             const float max_distance, const CollisionLayerMask layer_mask) const {
+    assert(hits.size() == rays.size() && "Every ray must have its hit");
+
+    std::ranges::fill(hits, RaycastHit{.collision = nullptr, .distance = max_distance});
+
+    // Broad phase could report the same proxy for several lanes, so the lanes are merged
+    // before any exact test and every collision is tested once per packet
+    std::vector<std::pair<BroadPhase::ProxyId, RayPacket::Mask>> candidates;
+    for (std::size_t offset = 0; offset < rays.size(); offset += RayPacket::width) {
+        const std::size_t size = (std::min)(RayPacket::width, rays.size() - offset);
+        const RayPacket packet{rays.subspan(offset, size)};
+        const std::span packet_hits = hits.subspan(offset, size);
+
+        candidates.clear();
+        broad_phase_->Query(packet, max_distance, [&](const BroadPhase::ProxyId proxy, const RayPacket::Mask lanes) {
+            candidates.emplace_back(proxy, lanes);
+        });
+        std::ranges::sort(candidates);
+
+        for (auto it = candidates.begin(); it != candidates.end();) {
+            const BroadPhase::ProxyId proxy = it->first;
+            RayPacket::Mask lanes = 0;
+            for (; it != candidates.end() && it->first == proxy; ++it) {
+                lanes |= it->second;
+            }
+
+            Collision &collision = *proxy_collisions_[proxy];
+            if (!IsOnLayers(collision, layer_mask)) {
+                continue;
+            }
+            if (collision.Shape() == MeshCollision::shape) {
+                std::array<MeshCollision::RayHit, RayPacket::width> mesh_hits;
+                for (std::size_t lane = 0; lane < size; ++lane) {
+                    mesh_hits[lane].distance = packet_hits[lane].distance;
+                }
+                // Every lane is traced through the mesh, any hit closer than the current one is real
+                const auto &mesh = static_cast<const MeshCollision &>(collision);
+                lanes = mesh.ClosestHits(packet, mesh_hits);
+                for (; lanes != 0; lanes &= lanes - 1) {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                    packet_hits[lane] = RaycastHit{.collision = &collision, .distance = mesh_hits[lane].distance};
+                }
+                continue;
+            }
+
+            for (; lanes != 0; lanes &= lanes - 1) {
+                const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                if (float distance; collision.Intersects(rays[offset + lane], distance) &&
+                                    distance <= packet_hits[lane].distance) {
+                    packet_hits[lane] = RaycastHit{.collision = &collision, .distance = distance};
+                }
+            }
+        }
+    }
+}
+
+void CollisionWorld::Query(const SceneQueryBatch &batch, ThreadPool *thread_pool) const {
+    assert(batch.ray_hits.size() == batch.rays.size() && "Every ray must have its hit");
+    assert(batch.sphere_hits.size() == batch.spheres.size() && "Every sphere must have its hits");
+    assert(batch.box_hits.size() == batch.boxes.size() && "Every box must have its hits");
+    assert(batch.sweep_hits.size() == batch.sweeps.size() && "Every sweep must have its hit");
+    assert(batch.overlaps.size() >= (batch.spheres.size() + batch.boxes.size()) * batch.max_overlaps &&
+           "Every overlap query must have its slots");
+
+    // Hierarchies of meshes are rebuilt lazily after mutation, which must not happen in parallel
+    for (const Entry &entry : entries_) {
+        BringHierarchyUpToDate(*entry.collision);
+    }
+
+    const auto parallel_for = [thread_pool](const std::size_t count, const std::size_t min_chunk_size,
+                                            const auto &function) {
+        if (thread_pool == nullptr) {
+            function(std::size_t{0}, count);
+            return;
+        }
+        thread_pool->ParallelFor(count, min_chunk_size, function);
+    };
+
+    // Chunks consist of whole packets, so the rays of one packet are never split between threads
+    const std::size_t packet_count = (batch.rays.size() + RayPacket::width - 1) / RayPacket::width;
+    parallel_for(packet_count, ray_chunk_packet_count, [&](const std::size_t begin, const std::size_t end) {
+        const std::size_t first = begin * RayPacket::width;
+        const std::size_t count = (std::min)(end * RayPacket::width, batch.rays.size()) - first;
+        Raycast(batch.rays.subspan(first, count), batch.ray_hits.subspan(first, count), batch.max_ray_distance,
+                batch.layer_mask);
+    });
+
+    parallel_for(batch.spheres.size(), overlap_chunk_size, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            OverlapHits &hits = batch.sphere_hits[i];
+            hits.collisions = batch.overlaps.subspan(i * batch.max_overlaps, batch.max_overlaps);
+            Overlap(SphereCollision{batch.spheres[i]}, batch.layer_mask, hits);
+        }
+    });
+
+    const std::size_t box_offset = batch.spheres.size() * batch.max_overlaps;
+    parallel_for(batch.boxes.size(), overlap_chunk_size, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            OverlapHits &hits = batch.box_hits[i];
+            hits.collisions = batch.overlaps.subspan(box_offset + i * batch.max_overlaps, batch.max_overlaps);
+            Overlap(BoxCollision{batch.boxes[i]}, batch.layer_mask, hits);
+        }
+    });
+
+    parallel_for(batch.sweeps.size(), sweep_chunk_size, [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            batch.sweep_hits[i] = Sweep(batch.sweeps[i], batch.layer_mask);
+        }
+    });
+}
+
+void CollisionWorld::Overlap(const Collision &shape, const CollisionLayerMask layer_mask, OverlapHits &hits) const {
+    std::size_t count = 0;
+    hits.is_truncated = false;
+    broad_phase_->Query(shape.Bounds(), [&](const BroadPhase::ProxyId proxy) {
+        Collision &collision = *proxy_collisions_[proxy];
+        if (!IsOnLayers(collision, layer_mask) || !shape.Intersects(collision)) {
+            return;
+        }
+        if (count == hits.collisions.size()) {
+            hits.is_truncated = true;
+            return;
+        }
+        hits.collisions[count++] = &collision;
+    });
+    hits.collisions = hits.collisions.first(count);
+}
+
+SweepHit CollisionWorld::Sweep(const SphereSweep &sweep, const CollisionLayerMask layer_mask) const {
+    assert(std::isfinite(sweep.max_distance) && "Sweep must have the finite distance");
+
+    const math::Vector3 start{sweep.sphere.Center};
+    const float radius = sweep.sphere.Radius;
+    math::AxisAlignedBox region;
+    math::AxisAlignedBox::CreateFromPoints(region, start, start + sweep.direction * sweep.max_distance);
+    region.Extents = math::Vector3{region.Extents} + math::Vector3{radius};
+
+    const float tolerance = sweep_tolerance * (std::max)(radius, sweep.max_distance);
+    SphereCollision moved{sweep.sphere};
+    SweepHit hit{.collision = nullptr, .distance = sweep.max_distance};
+    broad_phase_->Query(region, [&](const BroadPhase::ProxyId proxy) {
+        Collision &collision = *proxy_collisions_[proxy];
+        if (!IsOnLayers(collision, layer_mask)) {
+            return;
+        }
+
+        // Sphere never moves farther than its distance to the collision, so it can not pass through it.
+        // Every collision is advanced only up to the nearest contact found so far, farther contacts do not matter
+        float distance = 0.0f;
+        for (std::size_t step = 1; distance < hit.distance; ++step) {
+            moved.Primitive().Center = start + sweep.direction * distance;
+            const float gap = moved.Distance(collision);
+            if (gap <= tolerance || step == max_sweep_step_count) {
+                hit.collision = &collision;
+                hit.distance = distance;
+                return;
+            }
+            distance += gap;
+        }
+    });
+
+    if (hit.collision != nullptr) {
+        const math::Vector3 center = start + sweep.direction * hit.distance;
+        hit.point = hit.collision->ClosestPoint(center);
+        const math::Vector3 offset = center - hit.point;
+        hit.normal = offset.LengthSquared() > 0.0f ? math::Normalize(offset) : -sweep.direction;
+    }
+    return hit;
+}
+
+void CollisionWorld::ResetBroadPhase(std::unique_ptr<class BroadPhase> broad_phase) {
+    broad_phase_ = std::move(broad_phase);
+    std::vector<BroadPhase::ProxyId> new_proxies(proxy_collisions_.size(), BroadPhase::invalid_proxy);
+    proxy_collisions_.clear();
+    proxy_layers_.clear();
+    candidate_proxies_.clear();
+    pairs_.clear();
+    for (auto &[collision, proxy] : entries_) {
+        const BroadPhase::ProxyId old_proxy = proxy;
+        proxy = broad_phase_->Add(collision->Bounds());
+        new_proxies[old_proxy] = proxy;
+        SetProxy(proxy, *collision);
+    }
+
+    // Contacts are kept, so the overlaps do not begin again just because the broad phase was replaced
+    for (auto &[first, second] : contact_proxies_) {
+        std::tie(first, second) = std::minmax(new_proxies[first], new_proxies[second]);
+    }
+    std::ranges::sort(contact_proxies_);
+}
+
+void CollisionWorld::SetProxy(const BroadPhase::ProxyId proxy, Collision &collision) {
+    if (proxy >= proxy_collisions_.size()) {
+        proxy_collisions_.resize(proxy + 1);
+        proxy_layers_.resize(proxy + 1);
+    }
+    proxy_collisions_[proxy] = &collision;
+    proxy_layers_[proxy] = collision.Layer();
+}
+
+void CollisionWorld::FilterPairs() {
+    // Sorted order of the broad phase pairs is kept, so the contacts could be compared with the previous ones
+    candidate_proxies_.clear();
+    std::ranges::copy_if(broad_phase_->Pairs(), std::back_inserter(candidate_proxies_),
+                         [this](const BroadPhase::ProxyPair &pair) {
+                             const CollisionLayer first = proxy_layers_[pair.first];
+                             const CollisionLayer second = proxy_layers_[pair.second];
+                             return first < Collision::max_layer_count && HasLayer(layer_matrix_[first], second);
+                         });
+}
+
+void CollisionWorld::FindContacts() {
+    found_contact_proxies_.clear();
+    for (const BroadPhase::ProxyPair &pair : candidate_proxies_) {
+        if (proxy_collisions_[pair.first]->Intersects(*proxy_collisions_[pair.second])) {
+            found_contact_proxies_.push_back(pair);
+        }
+    }
+
+    // Both lists are sorted, so the overlaps which began or ended are their differences
+    const auto to_collisions = [this](const BroadPhase::ProxyPair &pair) {
+        return CollisionPair{.first = proxy_collisions_[pair.first], .second = proxy_collisions_[pair.second]};
+    };
+    const auto find_changes = [&](const auto &lhs, const auto &rhs, std::vector<CollisionPair> &overlaps) {
+        changed_contact_proxies_.clear();
+        std::ranges::set_difference(lhs, rhs, std::back_inserter(changed_contact_proxies_));
+        overlaps.clear();
+        std::ranges::transform(changed_contact_proxies_, std::back_inserter(overlaps), to_collisions);
+    };
+    find_changes(found_contact_proxies_, contact_proxies_, begun_overlaps_);
+    find_changes(contact_proxies_, found_contact_proxies_, ended_overlaps_);
+
+    next_ended_overlap_ = 0;
+    next_begun_overlap_ = 0;
+
+    contact_proxies_.swap(found_contact_proxies_);
+    contacts_.clear();
+    std::ranges::transform(contact_proxies_, std::back_inserter(contacts_), to_collisions);
+}
+
+void CollisionWorld::BroadcastOverlaps() {
+    // Pairs are copied, since handlers could remove collisions and replace the pending pairs with nulls
+    while (next_ended_overlap_ < ended_overlaps_.size()) {
+        if (const CollisionPair pair = ended_overlaps_[next_ended_overlap_++]; pair.first != nullptr) {
+            on_end_overlap_.Broadcast(pair);
+        }
+    }
+    while (next_begun_overlap_ < begun_overlaps_.size()) {
+        if (const CollisionPair pair = begun_overlaps_[next_begun_overlap_++]; pair.first != nullptr) {
+            on_begin_overlap_.Broadcast(pair);
+        }
+    }
+}
+
+}  // namespace borov_engine
@@ -4,7 +4,7 @@
 
 namespace borov_engine {
 
-Component::Component(class Game &game, [[maybe_unused]] const Initializer &initializer) : game_{game} {}
+Component::Component(class Game &game, [[maybe_unused]] const Initializer &initializer) : game_{game}, handle_{} {}
 
 Component::~Component() = default;
 
@@ -14,6 +14,18 @@ void Component::Draw(const Camera *camera) {}
 
 void Component::OnTargetResize() {}
 
+std::int32_t Component::UpdatePhase() const {
+    return 0;
+}
+
+bool Component::IsUpdateParallelSafe() const {
+    return false;
+}
+
+ComponentHandle Component::Handle() const {
+    return handle_;
+}
+
 Game &Component::Game() {
     return game_;
 }
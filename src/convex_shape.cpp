@@ -0,0 +1,88 @@
+#include "borov_engine/convex_shape.hpp"
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace borov_engine {
+
+namespace {
+
+math::Vector3 FarthestPoint(const std::span<const math::Vector3> points, const math::Vector3 &direction) {
+    assert(!points.empty() && "Shape must have at least one point");
+
+    const math::Vector3 *farthest = &points.front();
+    float farthest_distance = farthest->Dot(direction);
+    for (const math::Vector3 &point : points.subspan(1)) {
+        const float distance = point.Dot(direction);
+        if (distance > farthest_distance) {
+            farthest = &point;
+            farthest_distance = distance;
+        }
+    }
+    return *farthest;
+}
+
+// Corner of the box centered at the origin
+math::Vector3 CornerAlong(const math::Vector3 &extents, const math::Vector3 &direction) {
+    return math::Vector3{
+        direction.x < 0.0f ? -extents.x : extents.x,
+        direction.y < 0.0f ? -extents.y : extents.y,
+        direction.z < 0.0f ? -extents.z : extents.z,
+    };
+}
+
+}  // namespace
+
+math::Vector3 Support(const math::Vector3 &point, const math::Vector3 &) {
+    return point;
+}
+
+math::Vector3 Support(const math::Sphere &sphere, const math::Vector3 &direction) {
+    const float length = direction.Length();
+    const math::Vector3 center{sphere.Center};
+    return length > 0.0f ? center + direction * (sphere.Radius / length) : center;
+}
+
+math::Vector3 Support(const math::AxisAlignedBox &box, const math::Vector3 &direction) {
+    return math::Vector3{box.Center} + CornerAlong(math::Vector3{box.Extents}, direction);
+}
+
+math::Vector3 Support(const math::Box &box, const math::Vector3 &direction) {
+    const math::Quaternion orientation{box.Orientation};
+    math::Quaternion inverse_orientation;
+    orientation.Conjugate(inverse_orientation);
+
+    const math::Vector3 local_direction = math::Vector3::Transform(direction, inverse_orientation);
+    const math::Vector3 local_corner = CornerAlong(math::Vector3{box.Extents}, local_direction);
+    return math::Vector3{box.Center} + math::Vector3::Transform(local_corner, orientation);
+}
+
+math::Vector3 Support(const math::Frustum &frustum, const math::Vector3 &direction) {
+    std::array<math::Vector3, math::Frustum::CORNER_COUNT> corners;
+    frustum.GetCorners(corners.data());
+    return FarthestPoint(corners, direction);
+}
+
+math::Vector3 Support(const math::Triangle &triangle, const math::Vector3 &direction) {
+    const std::array points{triangle.point0, triangle.point1, triangle.point2};
+    return FarthestPoint(points, direction);
+}
+
+ConvexHull::ConvexHull(const std::span<const math::Vector3> points) : points_(points.begin(), points.end()) {}
+
+ConvexHull::ConvexHull(PointCollection &&points) : points_{std::move(points)} {}
+
+auto ConvexHull::Points() const -> const PointCollection & {
+    return points_;
+}
+
+auto ConvexHull::Points() -> PointCollection & {
+    return points_;
+}
+
+math::Vector3 Support(const ConvexHull &hull, const math::Vector3 &direction) {
+    return FarthestPoint(hull.Points(), direction);
+}
+
+}  // namespace borov_engine
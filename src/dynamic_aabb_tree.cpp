@@ -0,0 +1,335 @@
+#include "borov_engine/dynamic_aabb_tree.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace borov_engine {
+
+namespace {
+
+// Half of the surface area, which is enough to compare costs of the nodes
+float Area(const math::Vector3 &min, const math::Vector3 &max) {
+    const math::Vector3 size = max - min;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+}  // namespace
+
+bool DynamicAabbTree::Node::IsLeaf() const {
+    return child1 == null_index;
+}
+
+DynamicAabbTree::DynamicAabbTree(const float margin)
+    : root_{null_index},
+      free_list_{null_index},
+      proxy_count_{},
+      margin_{margin} {}
+
+auto DynamicAabbTree::Add(const math::AxisAlignedBox &bounds) -> ProxyId {
+    const Index leaf = AllocateNode();
+
+    const math::Vector3 center{bounds.Center};
+    const math::Vector3 extents = math::Vector3{bounds.Extents} + math::Vector3{margin_};
+    Node &node = nodes_[leaf];
+    node.min = center - extents;
+    node.max = center + extents;
+    node.height = 0;
+
+    InsertLeaf(leaf);
+    proxy_count_ += 1;
+    return leaf;
+}
+
+void DynamicAabbTree::Remove(const ProxyId proxy) {
+    assert(proxy < nodes_.size() && nodes_[proxy].IsLeaf() && nodes_[proxy].height == 0 && "Proxy is not in the tree");
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    proxy_count_ -= 1;
+}
+
+bool DynamicAabbTree::Move(const ProxyId proxy, const math::AxisAlignedBox &bounds) {
+    assert(proxy < nodes_.size() && nodes_[proxy].IsLeaf() && nodes_[proxy].height == 0 && "Proxy is not in the tree");
+
+    const math::Vector3 center{bounds.Center};
+    const math::Vector3 extents{bounds.Extents};
+    const math::Vector3 min = center - extents;
+    const math::Vector3 max = center + extents;
+
+    Node &node = nodes_[proxy];
+    const bool is_contained = node.min.x <= min.x && node.min.y <= min.y && node.min.z <= min.z &&
+                              max.x <= node.max.x && max.y <= node.max.y && max.z <= node.max.z;
+    if (is_contained) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    node.min = min - math::Vector3{margin_};
+    node.max = max + math::Vector3{margin_};
+    InsertLeaf(proxy);
+    return true;
+}
+
+math::AxisAlignedBox DynamicAabbTree::FatBounds(const ProxyId proxy) const {
+    const Node &node = nodes_[proxy];
+    return math::AxisAlignedBox{(node.min + node.max) * 0.5f, (node.max - node.min) * 0.5f};
+}
+
+std::size_t DynamicAabbTree::Size() const {
+    return proxy_count_;
+}
+
+std::size_t DynamicAabbTree::Height() const {
+    return root_ != null_index ? nodes_[root_].height : 0;
+}
+
+void DynamicAabbTree::Pairs(std::vector<ProxyPair> &pairs) const {
+    if (root_ == null_index) {
+        return;
+    }
+
+    // Tree is traversed against itself: a node paired with itself stands for all the pairs inside of its subtree
+    std::vector<std::pair<Index, Index>> stack;
+    stack.emplace_back(root_, root_);
+    while (!stack.empty()) {
+        const auto [lhs_index, rhs_index] = stack.back();
+        stack.pop_back();
+
+        const Node &lhs = nodes_[lhs_index];
+        const Node &rhs = nodes_[rhs_index];
+        if (lhs_index == rhs_index) {
+            if (!lhs.IsLeaf()) {
+                stack.emplace_back(lhs.child1, lhs.child1);
+                stack.emplace_back(lhs.child2, lhs.child2);
+                stack.emplace_back(lhs.child1, lhs.child2);
+            }
+            continue;
+        }
+        if (!Overlaps(lhs, rhs)) {
+            continue;
+        }
+
+        if (lhs.IsLeaf() && rhs.IsLeaf()) {
+            pairs.emplace_back((std::min)(lhs_index, rhs_index), (std::max)(lhs_index, rhs_index));
+        } else if (rhs.IsLeaf() || (!lhs.IsLeaf() && Area(lhs.min, lhs.max) >= Area(rhs.min, rhs.max))) {
+            stack.emplace_back(lhs.child1, rhs_index);
+            stack.emplace_back(lhs.child2, rhs_index);
+        } else {
+            stack.emplace_back(lhs_index, rhs.child1);
+            stack.emplace_back(lhs_index, rhs.child2);
+        }
+    }
+}
+
+bool DynamicAabbTree::Overlaps(const Node &lhs, const Node &rhs) {
+    return Overlaps(lhs, rhs.min, rhs.max);
+}
+
+bool DynamicAabbTree::Overlaps(const Node &node, const math::Vector3 &min, const math::Vector3 &max) {
+    return node.min.x <= max.x && min.x <= node.max.x && node.min.y <= max.y && min.y <= node.max.y &&
+           node.min.z <= max.z && min.z <= node.max.z;
+}
+
+bool DynamicAabbTree::Intersects(const Node &node, const math::Ray &ray, const math::Vector3 &inverse_direction,
+                                 const float max_distance) {
+    const math::Vector3 near_planes = (node.min - ray.position) * inverse_direction;
+    const math::Vector3 far_planes = (node.max - ray.position) * inverse_direction;
+    const math::Vector3 entries = math::Vector3::Min(near_planes, far_planes);
+    const math::Vector3 exits = math::Vector3::Max(near_planes, far_planes);
+    const float entry = (std::max)({entries.x, entries.y, entries.z, 0.0f});
+    const float exit = (std::min)({exits.x, exits.y, exits.z, max_distance});
+    return entry <= exit;
+}
+
+auto DynamicAabbTree::AllocateNode() -> Index {
+    if (free_list_ == null_index) {
+        nodes_.emplace_back();
+        free_list_ = static_cast<Index>(nodes_.size() - 1);
+        nodes_.back().parent = null_index;
+    }
+
+    const Index index = free_list_;
+    Node &node = nodes_[index];
+    free_list_ = node.parent;
+    node.parent = null_index;
+    node.child1 = null_index;
+    node.child2 = null_index;
+    node.height = 0;
+    return index;
+}
+
+void DynamicAabbTree::FreeNode(const Index index) {
+    Node &node = nodes_[index];
+    node.parent = free_list_;
+    node.height = -1;
+    free_list_ = index;
+}
+
+void DynamicAabbTree::InsertLeaf(const Index leaf) {
+    if (root_ == null_index) {
+        root_ = leaf;
+        nodes_[leaf].parent = null_index;
+        return;
+    }
+
+    // Descend to the sibling which increases the total surface area of the tree the least
+    const math::Vector3 leaf_min = nodes_[leaf].min;
+    const math::Vector3 leaf_max = nodes_[leaf].max;
+    Index index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const Node &node = nodes_[index];
+        const float area = Area(node.min, node.max);
+        const float combined_area =
+            Area(math::Vector3::Min(node.min, leaf_min), math::Vector3::Max(node.max, leaf_max));
+
+        // Cost of the new parent right here, and the minimum cost pushed down to the children otherwise
+        const float cost = 2.0f * combined_area;
+        const float inheritance_cost = 2.0f * (combined_area - area);
+        auto child_cost = [&](const Index child_index) {
+            const Node &child = nodes_[child_index];
+            const float child_combined_area =
+                Area(math::Vector3::Min(child.min, leaf_min), math::Vector3::Max(child.max, leaf_max));
+            const float child_area = child.IsLeaf() ? 0.0f : Area(child.min, child.max);
+            return child_combined_area - child_area + inheritance_cost;
+        };
+        const float cost1 = child_cost(node.child1);
+        const float cost2 = child_cost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+    const Index sibling = index;
+
+    // Allocation could move the nodes, so every access below goes through the indices
+    const Index old_parent = nodes_[sibling].parent;
+    const Index new_parent = AllocateNode();
+    nodes_[new_parent].parent = old_parent;
+    nodes_[new_parent].child1 = sibling;
+    nodes_[new_parent].child2 = leaf;
+    nodes_[new_parent].min = math::Vector3::Min(nodes_[sibling].min, leaf_min);
+    nodes_[new_parent].max = math::Vector3::Max(nodes_[sibling].max, leaf_max);
+    nodes_[new_parent].height = nodes_[sibling].height + 1;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+
+    if (old_parent == null_index) {
+        root_ = new_parent;
+    } else if (nodes_[old_parent].child1 == sibling) {
+        nodes_[old_parent].child1 = new_parent;
+    } else {
+        nodes_[old_parent].child2 = new_parent;
+    }
+
+    for (Index current = nodes_[leaf].parent; current != null_index; current = nodes_[current].parent) {
+        current = Balance(current);
+        Refit(current);
+    }
+}
+
+void DynamicAabbTree::RemoveLeaf(const Index leaf) {
+    if (leaf == root_) {
+        root_ = null_index;
+        return;
+    }
+
+    const Index parent = nodes_[leaf].parent;
+    const Index grandparent = nodes_[parent].parent;
+    const Index sibling = (nodes_[parent].child1 == leaf) ? nodes_[parent].child2 : nodes_[parent].child1;
+    FreeNode(parent);
+
+    if (grandparent == null_index) {
+        root_ = sibling;
+        nodes_[sibling].parent = null_index;
+        return;
+    }
+
+    // Sibling takes the place of the parent, then every ancestor is rebalanced and shrunk
+    if (nodes_[grandparent].child1 == parent) {
+        nodes_[grandparent].child1 = sibling;
+    } else {
+        nodes_[grandparent].child2 = sibling;
+    }
+    nodes_[sibling].parent = grandparent;
+
+    for (Index current = grandparent; current != null_index; current = nodes_[current].parent) {
+        current = Balance(current);
+        Refit(current);
+    }
+}
+
+void DynamicAabbTree::Refit(const Index index) {
+    Node &node = nodes_[index];
+    const Node &child1 = nodes_[node.child1];
+    const Node &child2 = nodes_[node.child2];
+    node.min = math::Vector3::Min(child1.min, child2.min);
+    node.max = math::Vector3::Max(child1.max, child2.max);
+    node.height = 1 + (std::max)(child1.height, child2.height);
+}
+
+// Rotates the taller grandchild up if heights of the children differ by more than one,
+// returns the index of the node which took the place of the given one
+auto DynamicAabbTree::Balance(const Index index_a) -> Index {
+    Node &a = nodes_[index_a];
+    if (a.IsLeaf() || a.height < 2) {
+        return index_a;
+    }
+
+    const Index index_b = a.child1;
+    const Index index_c = a.child2;
+    Node &b = nodes_[index_b];
+    Node &c = nodes_[index_c];
+
+    // Replaces the child `a` of its parent with the node rotated up
+    auto replace_in_parent = [&](const Index index) {
+        Node &node = nodes_[index];
+        node.parent = a.parent;
+        a.parent = index;
+        if (node.parent == null_index) {
+            root_ = index;
+        } else if (nodes_[node.parent].child1 == index_a) {
+            nodes_[node.parent].child1 = index;
+        } else {
+            nodes_[node.parent].child2 = index;
+        }
+    };
+
+    const std::int32_t balance = c.height - b.height;
+    if (balance > 1) {
+        const Index index_f = c.child1;
+        const Index index_g = c.child2;
+        c.child1 = index_a;
+        replace_in_parent(index_c);
+
+        // Taller grandchild stays with `c`, the other one goes to `a`
+        const bool is_f_taller = nodes_[index_f].height > nodes_[index_g].height;
+        const Index kept = is_f_taller ? index_f : index_g;
+        const Index moved = is_f_taller ? index_g : index_f;
+        c.child2 = kept;
+        a.child2 = moved;
+        nodes_[moved].parent = index_a;
+        Refit(index_a);
+        Refit(index_c);
+        return index_c;
+    }
+    if (balance < -1) {
+        const Index index_d = b.child1;
+        const Index index_e = b.child2;
+        b.child1 = index_a;
+        replace_in_parent(index_b);
+
+        const bool is_d_taller = nodes_[index_d].height > nodes_[index_e].height;
+        const Index kept = is_d_taller ? index_d : index_e;
+        const Index moved = is_d_taller ? index_e : index_d;
+        b.child2 = kept;
+        a.child1 = moved;
+        nodes_[moved].parent = index_a;
+        Refit(index_a);
+        Refit(index_b);
+        return index_b;
+    }
+    return index_a;
+}
+
+}  // namespace borov_engine
@@ -0,0 +1,166 @@
+#include "borov_engine/ecs/archetype.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <stdexcept>
+
+namespace borov_engine::ecs {
+
+namespace {
+
+// Chunks are aligned at least by the cache line, so columns of different chunks never share one
+constexpr std::size_t chunk_alignment = 64;
+
+std::size_t AlignUp(const std::size_t value, const std::size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t ColumnsSize(const std::span<const ComponentTypeInfo *const> types, const std::size_t capacity,
+                        std::vector<std::size_t> *offsets) {
+    std::size_t size = 0;
+    for (const ComponentTypeInfo *type : types) {
+        size = AlignUp(size, type->alignment);
+        if (offsets != nullptr) {
+            offsets->push_back(size);
+        }
+        size += type->size * capacity;
+    }
+    return size;
+}
+
+}  // namespace
+
+Archetype::Archetype(std::vector<const ComponentTypeInfo *> types) : types_{std::move(types)}, chunk_capacity_{} {
+    assert(std::ranges::is_sorted(types_, std::ranges::less{}, &ComponentTypeInfo::id) &&
+           "Component types must be sorted by their ids");
+
+    std::size_t row_size = 0;
+    for (const ComponentTypeInfo *type : types_) {
+        if (type->alignment > chunk_alignment) {
+            throw std::runtime_error{"Component type is aligned stricter than the archetype chunk"};
+        }
+        row_size += type->size;
+    }
+
+    // Empty archetype still needs some capacity to hold entities without any components
+    chunk_capacity_ = (row_size > 0) ? chunk_bytes / row_size : chunk_bytes;
+    while (chunk_capacity_ > 1 && ColumnsSize(types_, chunk_capacity_, nullptr) > chunk_bytes) {
+        chunk_capacity_ -= 1;
+    }
+    if (chunk_capacity_ == 0 || ColumnsSize(types_, chunk_capacity_, nullptr) > chunk_bytes) {
+        throw std::runtime_error{"Components of the entity do not fit into the archetype chunk"};
+    }
+    ColumnsSize(types_, chunk_capacity_, &column_offsets_);
+}
+
+Archetype::~Archetype() {
+    for (std::size_t row = 0; row < entities_.size(); ++row) {
+        for (std::size_t column = 0; column < types_.size(); ++column) {
+            types_[column]->destroy(Value(row, column));
+        }
+    }
+}
+
+std::span<const ComponentTypeInfo *const> Archetype::Types() const {
+    return types_;
+}
+
+std::size_t Archetype::Column(const ComponentTypeId type_id) const {
+    const auto found = std::ranges::lower_bound(types_, type_id, std::ranges::less{}, &ComponentTypeInfo::id);
+    if (found == types_.end() || (*found)->id != type_id) {
+        return invalid_column;
+    }
+    return static_cast<std::size_t>(found - types_.begin());
+}
+
+bool Archetype::HasAll(const std::span<const ComponentTypeId> type_ids) const {
+    return std::ranges::all_of(type_ids, [this](const ComponentTypeId type_id) {
+        return Column(type_id) != invalid_column;
+    });
+}
+
+std::size_t Archetype::Size() const {
+    return entities_.size();
+}
+
+std::size_t Archetype::ChunkCapacity() const {
+    return chunk_capacity_;
+}
+
+std::size_t Archetype::ChunkCount() const {
+    return (entities_.size() + chunk_capacity_ - 1) / chunk_capacity_;
+}
+
+std::size_t Archetype::ChunkSize(const std::size_t chunk) const {
+    return (std::min)(chunk_capacity_, entities_.size() - chunk * chunk_capacity_);
+}
+
+void *Archetype::ColumnData(const std::size_t chunk, const std::size_t column) const {
+    return chunks_[chunk].get() + column_offsets_[column];
+}
+
+void *Archetype::Value(const std::size_t row, const std::size_t column) const {
+    const std::size_t chunk = row / chunk_capacity_;
+    const std::size_t index = row % chunk_capacity_;
+    return static_cast<std::byte *>(ColumnData(chunk, column)) + index * types_[column]->size;
+}
+
+Entity Archetype::EntityAt(const std::size_t row) const {
+    return entities_[row];
+}
+
+std::size_t Archetype::AllocateRow(const Entity entity) {
+    const std::size_t row = entities_.size();
+    if (row / chunk_capacity_ == chunks_.size()) {
+        auto *chunk = static_cast<std::byte *>(::operator new(chunk_bytes, std::align_val_t{chunk_alignment}));
+        chunks_.emplace_back(chunk);
+    }
+    entities_.push_back(entity);
+    return row;
+}
+
+Entity Archetype::RemoveRow(const std::size_t row) {
+    for (std::size_t column = 0; column < types_.size(); ++column) {
+        types_[column]->destroy(Value(row, column));
+    }
+    return FillHole(row);
+}
+
+Entity Archetype::MoveRow(const std::size_t row, Archetype &other, std::size_t &other_row) {
+    other_row = other.AllocateRow(entities_[row]);
+    for (std::size_t column = 0; column < types_.size(); ++column) {
+        const std::size_t other_column = other.Column(types_[column]->id);
+        if (other_column != invalid_column) {
+            types_[column]->relocate(other.Value(other_row, other_column), Value(row, column));
+        } else {
+            types_[column]->destroy(Value(row, column));
+        }
+    }
+    return FillHole(row);
+}
+
+Entity Archetype::FillHole(const std::size_t row) {
+    const std::size_t last_row = entities_.size() - 1;
+    Entity moved_entity{};
+    if (row != last_row) {
+        for (std::size_t column = 0; column < types_.size(); ++column) {
+            types_[column]->relocate(Value(row, column), Value(last_row, column));
+        }
+        moved_entity = entities_[last_row];
+        entities_[row] = moved_entity;
+    }
+    entities_.pop_back();
+
+    // One spare chunk is kept, so an entity moving back and forth at the boundary does not allocate every time
+    while (chunks_.size() > ChunkCount() + 1) {
+        chunks_.pop_back();
+    }
+    return moved_entity;
+}
+
+void Archetype::ChunkDeleter::operator()(std::byte *chunk) const {
+    ::operator delete(chunk, std::align_val_t{chunk_alignment});
+}
+
+}  // namespace borov_engine::ecs
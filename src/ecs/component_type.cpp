@@ -0,0 +1,12 @@
+#include "borov_engine/ecs/component_type.hpp"
+
+#include <atomic>
+
+namespace borov_engine::ecs::detail {
+
+ComponentTypeId NextComponentTypeId() {
+    static std::atomic<ComponentTypeId> next_id = 0;
+    return next_id++;
+}
+
+}  // namespace borov_engine::ecs::detail
@@ -0,0 +1,167 @@
+#include "borov_engine/ecs/world.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+#include "borov_engine/thread_pool.hpp"
+
+namespace borov_engine::ecs {
+
+bool SystemAccess::ConflictsWith(const SystemAccess &other) const {
+    auto intersects = [](const std::vector<ComponentTypeId> &lhs, const std::vector<ComponentTypeId> &rhs) {
+        auto lhs_it = lhs.begin();
+        auto rhs_it = rhs.begin();
+        while (lhs_it != lhs.end() && rhs_it != rhs.end()) {
+            if (*lhs_it == *rhs_it) {
+                return true;
+            }
+            (*lhs_it < *rhs_it) ? ++lhs_it : ++rhs_it;
+        }
+        return false;
+    };
+    // Reading the same components at the same time is fine, anything else with writing is a data race
+    return intersects(writes, other.writes) || intersects(writes, other.reads) || intersects(reads, other.writes);
+}
+
+World::World() : size_{}, is_running_systems_{} {}
+
+World::~World() = default;
+
+void World::DestroyEntity(const Entity entity) {
+    assert(!is_running_systems_ && "Entities must not be destroyed while systems are running");
+
+    const EntityRecord &record = Record(entity);
+    if (const Entity moved_entity = record.archetype->RemoveRow(record.row);
+        moved_entity.index != Entity::invalid_index) {
+        UpdateRecord(moved_entity, *record.archetype, record.row);
+    }
+
+    EntityRecord &freed_record = records_[entity.index];
+    freed_record.archetype = nullptr;
+    freed_record.generation += 1;
+    free_records_.push_back(entity.index);
+    size_ -= 1;
+}
+
+bool World::IsAlive(const Entity entity) const {
+    return entity.index < records_.size() && records_[entity.index].generation == entity.generation &&
+           records_[entity.index].archetype != nullptr;
+}
+
+std::size_t World::Size() const {
+    return size_;
+}
+
+void World::AddSystem(SystemAccess access, System system) {
+    std::ranges::sort(access.reads);
+    std::ranges::sort(access.writes);
+    systems_.push_back(SystemEntry{.access = std::move(access), .system = std::move(system)});
+    BuildSystemPhases();
+}
+
+void World::RunSystems(const float delta_time, ThreadPool *thread_pool) {
+    is_running_systems_ = true;
+    for (const std::vector<std::size_t> &phase : system_phases_) {
+        if (thread_pool == nullptr || phase.size() == 1) {
+            for (const std::size_t system : phase) {
+                systems_[system].system(*this, delta_time);
+            }
+            continue;
+        }
+
+        thread_pool->ParallelFor(phase.size(), 1, [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                systems_[phase[i]].system(*this, delta_time);
+            }
+        });
+    }
+    is_running_systems_ = false;
+}
+
+auto World::Record(const Entity entity) const -> const EntityRecord & {
+    assert(IsAlive(entity) && "Entity was already destroyed");
+    return records_[entity.index];
+}
+
+Entity World::AllocateEntity() {
+    size_ += 1;
+    if (free_records_.empty()) {
+        records_.push_back(EntityRecord{.archetype = nullptr, .row = 0, .generation = 0});
+        return Entity{.index = static_cast<std::uint32_t>(records_.size() - 1), .generation = 0};
+    }
+
+    const std::uint32_t index = free_records_.back();
+    free_records_.pop_back();
+    return Entity{.index = index, .generation = records_[index].generation};
+}
+
+Archetype &World::ArchetypeOf(std::vector<const ComponentTypeInfo *> types) {
+    std::vector<ComponentTypeId> type_ids;
+    type_ids.reserve(types.size());
+    std::ranges::transform(types, std::back_inserter(type_ids), &ComponentTypeInfo::id);
+
+    std::unique_ptr<Archetype> &archetype = archetypes_by_types_[std::move(type_ids)];
+    if (archetype == nullptr) {
+        archetype = std::make_unique<Archetype>(std::move(types));
+        archetypes_.push_back(archetype.get());
+    }
+    return *archetype;
+}
+
+std::vector<Archetype *> World::ArchetypesWith(const std::span<const ComponentTypeId> type_ids) const {
+    std::vector<Archetype *> archetypes;
+    for (Archetype *archetype : archetypes_) {
+        if (archetype->Size() > 0 && archetype->HasAll(type_ids)) {
+            archetypes.push_back(archetype);
+        }
+    }
+    return archetypes;
+}
+
+void World::UpdateRecord(const Entity entity, Archetype &archetype, const std::size_t row) {
+    EntityRecord &record = records_[entity.index];
+    record.archetype = &archetype;
+    record.row = static_cast<std::uint32_t>(row);
+}
+
+std::size_t World::ChangeArchetype(const Entity entity, const ComponentTypeInfo &type, const bool is_added) {
+    const EntityRecord record = Record(entity);
+
+    const std::span current_types = record.archetype->Types();
+    std::vector<const ComponentTypeInfo *> types;
+    std::ranges::copy_if(current_types, std::back_inserter(types), [&type](const ComponentTypeInfo *current_type) {
+        return current_type->id != type.id;
+    });
+    if (is_added) {
+        types.insert(std::ranges::upper_bound(types, type.id, std::ranges::less{}, &ComponentTypeInfo::id), &type);
+    }
+
+    Archetype &archetype = ArchetypeOf(std::move(types));
+    std::size_t row;
+    if (const Entity moved_entity = record.archetype->MoveRow(record.row, archetype, row);
+        moved_entity.index != Entity::invalid_index) {
+        UpdateRecord(moved_entity, *record.archetype, record.row);
+    }
+    UpdateRecord(entity, archetype, row);
+    return row;
+}
+
+void World::BuildSystemPhases() {
+    // System goes right after the last phase with a conflicting system, so the order of conflicting systems is kept
+    std::vector<std::size_t> system_phases(systems_.size());
+    system_phases_.clear();
+    for (std::size_t system = 0; system < systems_.size(); ++system) {
+        std::size_t phase = 0;
+        for (std::size_t previous = 0; previous < system; ++previous) {
+            if (systems_[system].access.ConflictsWith(systems_[previous].access)) {
+                phase = (std::max)(phase, system_phases[previous] + 1);
+            }
+        }
+        system_phases[system] = phase;
+        system_phases_.resize((std::max)(system_phases_.size(), phase + 1));
+        system_phases_[phase].push_back(system);
+    }
+}
+
+}  // namespace borov_engine::ecs
@@ -2,8 +2,11 @@
 
 #include <d3dcompiler.h>
 
+#include <algorithm>
 #include <array>
 #include <constexpr-to-string/to_string.hpp>
+#include <span>
+#include <utility>
 
 #include "borov_engine/camera.hpp"
 #include "borov_engine/camera_manager.hpp"
@@ -20,6 +23,9 @@ constexpr Timer::Duration default_time_per_update = std::chrono::microseconds{65
 Game::Game(class Window &window, class Input &input)
     : window_{window},
       input_{input},
+      transform_system_{&thread_pool_},
+      is_update_order_dirty_{},
+      is_parallel_update_{},
       time_per_update_{default_time_per_update},
       target_width_{},
       target_height_{},
@@ -101,6 +107,38 @@ TextureDraw &Game::TextureDraw() {
     return *texture_draw_;
 }
 
+const ThreadPool &Game::ThreadPool() const {
+    return thread_pool_;
+}
+
+ThreadPool &Game::ThreadPool() {
+    return thread_pool_;
+}
+
+const TransformSystem &Game::TransformSystem() const {
+    return transform_system_;
+}
+
+TransformSystem &Game::TransformSystem() {
+    return transform_system_;
+}
+
+const CollisionWorld &Game::CollisionWorld() const {
+    return collision_world_;
+}
+
+CollisionWorld &Game::CollisionWorld() {
+    return collision_world_;
+}
+
+const ecs::World &Game::World() const {
+    return world_;
+}
+
+ecs::World &Game::World() {
+    return world_;
+}
+
 const DirectionalLightComponent &Game::DirectionalLight() const {
     return *directional_light_;
 }
@@ -213,6 +251,45 @@ bool Game::IsRunning() const {
     return is_running_;
 }
 
+void Game::RemoveComponent(const Component &component) {
+    RemoveComponent(component.Handle());
+}
+
+void Game::RemoveComponent(const ComponentHandle handle) {
+    if (FindComponent(handle) == nullptr) {
+        return;
+    }
+
+    ComponentSlot &slot = component_slots_[handle.index];
+    if (slot.is_removed) {
+        return;
+    }
+    slot.is_removed = true;
+    removed_components_.push_back(handle);
+}
+
+alloc::PoolStats Game::ComponentAllocationStats() const {
+    alloc::PoolStats stats;
+    for (const auto &[type, pool] : component_pools_) {
+        stats += pool.Stats();
+    }
+    return stats;
+}
+
+const Component *Game::FindComponent(const ComponentHandle handle) const {
+    if (handle.index >= component_slots_.size()) {
+        return nullptr;
+    }
+
+    const ComponentSlot &slot = component_slots_[handle.index];
+    return (slot.generation == handle.generation) ? slot.component : nullptr;
+}
+
+Component *Game::FindComponent(const ComponentHandle handle) {
+    const auto &self = *this;
+    return const_cast<Component *>(self.FindComponent(handle));
+}
+
 void Game::Run() {
     if (is_running_) {
         return;
@@ -236,6 +313,7 @@ void Game::Run() {
         }
 
         DrawInternal();
+        DestroyRemovedComponents();
     }
 
     is_running_ = false;
@@ -459,8 +537,116 @@ void Game::UpdateShadowMapConstantBuffer(const ShadowMapConstantBuffer &data) {
     device_context_->Unmap(shadow_map_constant_buffer_.Get(), 0);
 }
 
+void Game::ComponentDeleter::operator()(Component *component) const {
+    component->~Component();
+    pool->Deallocate(memory);
+}
+
+alloc::SlabPool &Game::ComponentPool(const std::type_index type, const std::size_t size, const std::size_t alignment) {
+    auto [iterator, is_inserted] = component_pools_.try_emplace(type, size, alignment);
+    return iterator->second;
+}
+
+void Game::RegisterComponent(Component &component) {
+    std::uint32_t slot_index;
+    if (free_component_slots_.empty()) {
+        slot_index = static_cast<std::uint32_t>(component_slots_.size());
+        component_slots_.push_back(ComponentSlot{});
+    } else {
+        slot_index = free_component_slots_.back();
+        free_component_slots_.pop_back();
+    }
+
+    ComponentSlot &slot = component_slots_[slot_index];
+    slot.component = &component;
+    slot.index = static_cast<std::uint32_t>(components_.size() - 1);
+    slot.is_removed = false;
+    component.handle_ = ComponentHandle{.index = slot_index, .generation = slot.generation};
+
+    for (const auto &[type, component_list] : component_lists_) {
+        component_list->TryAdd(component);
+    }
+    if (auto *collision = dynamic_cast<Collision *>(&component)) {
+        collision_world_.Add(*collision);
+    }
+    is_update_order_dirty_ = true;
+}
+
+void Game::DestroyRemovedComponents() {
+    // Destructors of removed components could remove other ones, so repeat until nothing is left
+    while (!removed_components_.empty()) {
+        const std::vector<ComponentHandle> handles = std::exchange(removed_components_, {});
+
+        std::vector<const Component *> removed;
+        removed.reserve(handles.size());
+        for (const ComponentHandle handle : handles) {
+            removed.push_back(component_slots_[handle.index].component);
+        }
+        std::ranges::sort(removed, std::ranges::less{});
+        for (const auto &[type, component_list] : component_lists_) {
+            component_list->Remove(removed);
+        }
+        for (const Component *component : removed) {
+            if (const auto *collision = dynamic_cast<const Collision *>(component)) {
+                collision_world_.Remove(*collision);
+            }
+        }
+
+        std::vector<ComponentPtr> destroyed;
+        destroyed.reserve(handles.size());
+        for (const ComponentHandle handle : handles) {
+            ComponentSlot &slot = component_slots_[handle.index];
+            Component &component = *slot.component;
+
+            // Raw delegates are usually bound to the most derived object, which may differ from the component
+            for (void *owner : {static_cast<void *>(&component), dynamic_cast<void *>(&component)}) {
+                window_.OnResize().RemoveByOwner(owner);
+                input_.OnMouseMove().RemoveByOwner(owner);
+                input_.OnInputKeyUp().RemoveByOwner(owner);
+                input_.OnInputKeyDown().RemoveByOwner(owner);
+                collision_world_.OnBeginOverlap().RemoveByOwner(owner);
+                collision_world_.OnEndOverlap().RemoveByOwner(owner);
+            }
+
+            const std::uint32_t index = slot.index;
+            destroyed.push_back(std::move(components_[index]));
+            if (index + 1 != components_.size()) {
+                components_[index] = std::move(components_.back());
+                component_slots_[components_[index]->handle_.index].index = index;
+            }
+            components_.pop_back();
+
+            slot = ComponentSlot{.generation = slot.generation + 1};
+            free_component_slots_.push_back(handle.index);
+        }
+
+        // Every removed component is already unreachable, so destructors see the game in a consistent state
+        destroyed.clear();
+        is_update_order_dirty_ = true;
+    }
+}
+
+void Game::BuildUpdatePhases() {
+    // Phases are built from the components in their current order, so the sequential order stays the same as before
+    update_phases_.clear();
+    for (const auto &component : components_) {
+        const std::int32_t phase = component->UpdatePhase();
+        auto it = std::ranges::lower_bound(update_phases_, phase, std::ranges::less{}, &UpdatePhase::phase);
+        if (it == update_phases_.end() || it->phase != phase) {
+            it = update_phases_.insert(it, UpdatePhase{.phase = phase});
+        }
+
+        auto &phase_components =
+            component->IsUpdateParallelSafe() ? it->parallel_components : it->sequential_components;
+        phase_components.push_back(component.get());
+    }
+    is_update_order_dirty_ = false;
+}
+
 void Game::UpdateInternal(const float delta_time) {
     Update(delta_time);
+    world_.RunSystems(delta_time, &thread_pool_);
+    collision_world_.Update();
 
     if (camera_manager_ != nullptr) {
         camera_manager_->Update(delta_time);
@@ -470,12 +656,35 @@ void Game::UpdateInternal(const float delta_time) {
 }
 
 void Game::Update(const float delta_time) {
-    for (const auto &component : components_) {
-        component->Update(delta_time);
+    if (is_update_order_dirty_) {
+        BuildUpdatePhases();
+    }
+
+    // Components added during the update are not in the phases yet, so they are updated starting from the next one
+    for (const UpdatePhase &phase : update_phases_) {
+        const std::span parallel_components{phase.parallel_components};
+        if (!parallel_components.empty()) {
+            // Lazy world transform queries would write into the shared transform system otherwise
+            transform_system_.Update();
+
+            const auto update_chunk = [&](const std::size_t begin, const std::size_t end) {
+                for (Component *component : parallel_components.subspan(begin, end - begin)) {
+                    component->Update(delta_time);
+                }
+            };
+            is_parallel_update_ = true;
+            thread_pool_.ParallelFor(parallel_components.size(), 1, update_chunk);
+            is_parallel_update_ = false;
+        }
+        for (Component *component : phase.sequential_components) {
+            component->Update(delta_time);
+        }
     }
 }
 
 void Game::DrawInternal() {
+    transform_system_.Update();
+
     device_context_->ClearState();
     device_context_->ClearRenderTargetView(render_target_view_.Get(), clear_color_);
     device_context_->ClearDepthStencilView(depth_stencil_view_.Get(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
@@ -532,16 +741,8 @@ void Game::DrawInternal() {
         const std::array gs_constant_buffers{shadow_map_constant_buffer_.Get()};
         device_context_->GSSetConstantBuffers(0, gs_constant_buffers.size(), gs_constant_buffers.data());
 
-        auto is_triangle = [](const Component &component) {
-            return dynamic_cast<const TriangleComponent *>(&component) != nullptr;
-        };
-        auto to_triangle = [](Component &component) -> TriangleComponent & {
-            return dynamic_cast<TriangleComponent &>(component);
-        };
-        // ReSharper disable once CppTooWideScopeInitStatement
-        auto triangle_components = Components() | std::views::filter(is_triangle) | std::views::transform(to_triangle);
-        for (TriangleComponent &component : triangle_components) {
-            component.DrawInShadowMap(camera);
+        for (TriangleComponent *component : ComponentsOfType<TriangleComponent>()) {
+            component->DrawInShadowMap(camera);
         }
 
         for (std::uint32_t i = 0; i < shadow_map_cascade_count; i++) {
@@ -230,7 +230,7 @@ void GeometricPrimitiveComponent::Draw(const Camera *camera) {
         return;
     }
 
-    const math::Matrix4x4 world = WorldTransform().ToMatrix();
+    const math::Matrix4x4 world = WorldMatrix();
     const math::Matrix4x4 view = (camera != nullptr) ? camera->ViewMatrix() : math::Matrix4x4::Identity;
     const math::Matrix4x4 projection = (camera != nullptr) ? camera->ProjectionMatrix() : math::Matrix4x4::Identity;
 
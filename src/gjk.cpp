@@ -0,0 +1,540 @@
+#include "borov_engine/gjk.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+namespace borov_engine {
+
+namespace {
+
+using Vertex = GjkSimplex::Vertex;
+// Barycentric coordinates of the closest point in the vertices of the simplex
+using Weights = std::array<float, GjkSimplex::max_size>;
+
+constexpr std::size_t max_gjk_iterations = 64;
+constexpr std::size_t max_epa_iterations = 64;
+// Iteration which gets closer by less than this part of the distance ends the search
+constexpr float relative_tolerance = 1e-4f;
+// Squared distances below these are zero
+constexpr float touching_tolerance = 1e-10f;
+constexpr float duplicate_tolerance = 1e-10f;
+
+// Every EPA iteration adds one vertex, and the closed polytope has at most `2 * vertices - 4` faces
+constexpr std::size_t max_epa_vertex_count = GjkSimplex::max_size + max_epa_iterations;
+constexpr std::size_t max_epa_face_count = 2 * max_epa_vertex_count - 4;
+
+// Tilts of the second shape which reveal the rest of the manifold, diagonal to the tangent axes
+// so that the boxes aligned with them expose their corners instead of whole edges
+constexpr std::size_t perturbation_count = 4;
+constexpr float perturbation_angle = 0.05f;
+constexpr float merge_distance = 1e-3f;
+
+Vertex SupportVertex(const ConvexShape &lhs, const ConvexShape &rhs, const math::Vector3 &direction) {
+    const math::Vector3 lhs_point = lhs.Support(direction);
+    const math::Vector3 rhs_point = rhs.Support(-direction);
+    return Vertex{
+        .direction = direction,
+        .point = lhs_point - rhs_point,
+        .lhs_point = lhs_point,
+        .rhs_point = rhs_point,
+    };
+}
+
+bool Contains(const GjkSimplex &simplex, const math::Vector3 &point) {
+    for (std::size_t index = 0; index < simplex.size; ++index) {
+        if (math::Vector3::DistanceSquared(simplex.vertices[index].point, point) <= duplicate_tolerance) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Assign(GjkSimplex &simplex, Weights &weights, const std::initializer_list<std::pair<Vertex, float>> vertices) {
+    simplex.size = 0;
+    for (const auto &[vertex, weight] : vertices) {
+        weights[simplex.size] = weight;
+        simplex.vertices[simplex.size++] = vertex;
+    }
+}
+
+// Closest points to the origin reduce the simplex to the smallest feature which contains them
+
+math::Vector3 ClosestOnSegment(GjkSimplex &simplex, Weights &weights) {
+    const Vertex a = simplex.vertices[0];
+    const Vertex b = simplex.vertices[1];
+    const math::Vector3 ab = b.point - a.point;
+    const float t = -a.point.Dot(ab);
+    if (t <= 0.0f) {
+        Assign(simplex, weights, {{a, 1.0f}});
+        return a.point;
+    }
+
+    const float length_squared = ab.Dot(ab);
+    if (t >= length_squared) {
+        Assign(simplex, weights, {{b, 1.0f}});
+        return b.point;
+    }
+
+    const float s = t / length_squared;
+    Assign(simplex, weights, {{a, 1.0f - s}, {b, s}});
+    return a.point + ab * s;
+}
+
+// Voronoi regions of the vertices, the edges and the face, the same way as for the closest point to any point
+math::Vector3 ClosestOnTriangle(GjkSimplex &simplex, Weights &weights) {
+    const Vertex a = simplex.vertices[0];
+    const Vertex b = simplex.vertices[1];
+    const Vertex c = simplex.vertices[2];
+    const math::Vector3 ab = b.point - a.point;
+    const math::Vector3 ac = c.point - a.point;
+
+    const float d1 = -ab.Dot(a.point);
+    const float d2 = -ac.Dot(a.point);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        Assign(simplex, weights, {{a, 1.0f}});
+        return a.point;
+    }
+
+    const float d3 = -ab.Dot(b.point);
+    const float d4 = -ac.Dot(b.point);
+    if (d3 >= 0.0f && d4 <= d3) {
+        Assign(simplex, weights, {{b, 1.0f}});
+        return b.point;
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        const float v = d1 / (d1 - d3);
+        Assign(simplex, weights, {{a, 1.0f - v}, {b, v}});
+        return a.point + ab * v;
+    }
+
+    const float d5 = -ab.Dot(c.point);
+    const float d6 = -ac.Dot(c.point);
+    if (d6 >= 0.0f && d5 <= d6) {
+        Assign(simplex, weights, {{c, 1.0f}});
+        return c.point;
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        const float w = d2 / (d2 - d6);
+        Assign(simplex, weights, {{a, 1.0f - w}, {c, w}});
+        return a.point + ac * w;
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        Assign(simplex, weights, {{b, 1.0f - w}, {c, w}});
+        return b.point + (c.point - b.point) * w;
+    }
+
+    const float denominator = 1.0f / (va + vb + vc);
+    const float v = vb * denominator;
+    const float w = vc * denominator;
+    Assign(simplex, weights, {{a, 1.0f - v - w}, {b, v}, {c, w}});
+    return a.point + ab * v + ac * w;
+}
+
+// Only the faces which separate the origin from the opposite vertex could hold the closest point.
+// The origin is inside if there are none, then the simplex is kept whole
+math::Vector3 ClosestOnTetrahedron(GjkSimplex &simplex, Weights &weights) {
+    constexpr std::array<std::array<std::size_t, 4>, 4> faces{{{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}}};
+
+    const std::array vertices = simplex.vertices;
+    float closest_distance = std::numeric_limits<float>::infinity();
+    math::Vector3 closest = math::Vector3::Zero;
+    GjkSimplex closest_simplex = simplex;
+    Weights closest_weights = weights;
+    for (const auto &[a, b, c, d] : faces) {
+        const math::Vector3 normal =
+            (vertices[b].point - vertices[a].point).Cross(vertices[c].point - vertices[a].point);
+        const float origin_side = -normal.Dot(vertices[a].point);
+        const float opposite_side = normal.Dot(vertices[d].point - vertices[a].point);
+        if (origin_side * opposite_side > 0.0f) {
+            continue;
+        }
+
+        GjkSimplex face{.vertices = {vertices[a], vertices[b], vertices[c]}, .size = 3};
+        Weights face_weights;
+        const math::Vector3 point = ClosestOnTriangle(face, face_weights);
+        if (point.LengthSquared() < closest_distance) {
+            closest_distance = point.LengthSquared();
+            closest = point;
+            closest_simplex = face;
+            closest_weights = face_weights;
+        }
+    }
+
+    if (closest_distance == std::numeric_limits<float>::infinity()) {
+        weights.fill(1.0f / static_cast<float>(GjkSimplex::max_size));
+        return math::Vector3::Zero;
+    }
+    simplex = closest_simplex;
+    weights = closest_weights;
+    return closest;
+}
+
+math::Vector3 Reduce(GjkSimplex &simplex, Weights &weights) {
+    switch (simplex.size) {
+        case 1:
+            weights[0] = 1.0f;
+            return simplex.vertices[0].point;
+        case 2:
+            return ClosestOnSegment(simplex, weights);
+        case 3:
+            return ClosestOnTriangle(simplex, weights);
+        default:
+            return ClosestOnTetrahedron(simplex, weights);
+    }
+}
+
+// Returns true if the shapes overlap, otherwise the closest point of the Minkowski difference to the origin
+// is left with its weights in the vertices of the simplex
+bool RunGjk(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex, math::Vector3 &closest,
+            Weights &weights) {
+    // Directions of the previous query give the vertices at the current positions of the shapes
+    const std::size_t previous_size = simplex.size;
+    simplex.size = 0;
+    for (std::size_t index = 0; index < previous_size; ++index) {
+        const Vertex vertex = SupportVertex(lhs, rhs, simplex.vertices[index].direction);
+        if (!Contains(simplex, vertex.point)) {
+            simplex.vertices[simplex.size++] = vertex;
+        }
+    }
+    if (simplex.size == 0) {
+        simplex.vertices[simplex.size++] = SupportVertex(lhs, rhs, math::Vector3::UnitX);
+    }
+
+    for (std::size_t iteration = 0; iteration < max_gjk_iterations; ++iteration) {
+        closest = Reduce(simplex, weights);
+        const float distance_squared = closest.LengthSquared();
+        if (simplex.size == GjkSimplex::max_size || distance_squared <= touching_tolerance) {
+            return true;
+        }
+
+        // Nothing is farther towards the origin than the closest point itself, so it is final
+        const Vertex vertex = SupportVertex(lhs, rhs, -closest);
+        if (distance_squared - closest.Dot(vertex.point) <= relative_tolerance * distance_squared ||
+            Contains(simplex, vertex.point)) {
+            return false;
+        }
+        simplex.vertices[simplex.size++] = vertex;
+    }
+    return false;
+}
+
+// Simplex of the touching shapes could be flat, while EPA needs the tetrahedron around the origin
+bool BlowUp(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex) {
+    const auto try_add = [&](const math::Vector3 &direction, const auto &is_enough) {
+        const Vertex vertex = SupportVertex(lhs, rhs, direction);
+        if (!Contains(simplex, vertex.point) && is_enough(vertex.point)) {
+            simplex.vertices[simplex.size++] = vertex;
+            return true;
+        }
+        return false;
+    };
+    const auto any_point = [](const math::Vector3 &) { return true; };
+
+    if (simplex.size == 1) {
+        for (const math::Vector3 &axis : {math::Vector3::UnitX, math::Vector3::UnitY, math::Vector3::UnitZ,
+                                          -math::Vector3::UnitX, -math::Vector3::UnitY, -math::Vector3::UnitZ}) {
+            if (try_add(axis, any_point)) {
+                break;
+            }
+        }
+    }
+
+    if (simplex.size == 2) {
+        const math::Vector3 a = simplex.vertices[0].point;
+        math::Vector3 line = simplex.vertices[1].point - a;
+        line.Normalize();
+
+        const math::Vector3 absolute{std::abs(line.x), std::abs(line.y), std::abs(line.z)};
+        const math::Vector3 &axis = absolute.x < absolute.y ? (absolute.x < absolute.z ? math::Vector3::UnitX
+                                                                                        : math::Vector3::UnitZ)
+                                                            : (absolute.y < absolute.z ? math::Vector3::UnitY
+                                                                                        : math::Vector3::UnitZ);
+        math::Vector3 direction = line.Cross(axis);
+        const math::Quaternion rotation =
+            math::Quaternion::CreateFromAxisAngle(line, std::numbers::pi_v<float> / 3.0f);
+        const auto off_line = [&](const math::Vector3 &point) {
+            return (point - a).Cross(line).LengthSquared() > duplicate_tolerance;
+        };
+        for (std::size_t step = 0; step < 6 && !try_add(direction, off_line); ++step) {
+            direction = math::Vector3::Transform(direction, rotation);
+        }
+    }
+
+    if (simplex.size == 3) {
+        const math::Vector3 a = simplex.vertices[0].point;
+        math::Vector3 normal = (simplex.vertices[1].point - a).Cross(simplex.vertices[2].point - a);
+        normal.Normalize();
+
+        const auto off_plane = [&](const math::Vector3 &point) {
+            const float distance = normal.Dot(point - a);
+            return distance * distance > duplicate_tolerance;
+        };
+        if (!try_add(normal, off_plane)) {
+            try_add(-normal, off_plane);
+        }
+    }
+
+    return simplex.size == GjkSimplex::max_size;
+}
+
+struct Face {
+    std::array<std::size_t, 3> vertices;
+    math::Vector3 normal;
+    float distance;
+};
+
+struct Penetration {
+    math::Vector3 normal;
+    float depth;
+    math::Vector3 rhs_point;
+};
+
+Penetration PenetrationOf(const Face &face, const std::span<const Vertex> vertices) {
+    const Vertex &a = vertices[face.vertices[0]];
+    const Vertex &b = vertices[face.vertices[1]];
+    const Vertex &c = vertices[face.vertices[2]];
+
+    // Barycentric coordinates of the projection of the origin onto the face
+    const math::Vector3 ab = b.point - a.point;
+    const math::Vector3 ac = c.point - a.point;
+    const math::Vector3 ap = face.normal * face.distance - a.point;
+    const float d00 = ab.Dot(ab);
+    const float d01 = ab.Dot(ac);
+    const float d11 = ac.Dot(ac);
+    const float d20 = ap.Dot(ab);
+    const float d21 = ap.Dot(ac);
+    const float denominator = d00 * d11 - d01 * d01;
+
+    float v = 0.0f;
+    float w = 0.0f;
+    if (denominator > std::numeric_limits<float>::epsilon() * d00 * d11) {
+        v = (d11 * d20 - d01 * d21) / denominator;
+        w = (d00 * d21 - d01 * d20) / denominator;
+    }
+    return Penetration{
+        .normal = face.normal,
+        .depth = face.distance,
+        .rhs_point = a.rhs_point * (1.0f - v - w) + b.rhs_point * v + c.rhs_point * w,
+    };
+}
+
+// Expanding polytope: the face of the Minkowski difference nearest to the origin is pushed out
+// by the support point along its normal until it can not move anymore
+bool RunEpa(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex simplex, Penetration &penetration) {
+    if (!BlowUp(lhs, rhs, simplex)) {
+        return false;
+    }
+
+    std::array<Vertex, max_epa_vertex_count> vertices;
+    std::size_t vertex_count = 0;
+    for (const Vertex &vertex : simplex.vertices) {
+        vertices[vertex_count++] = vertex;
+    }
+
+    std::array<Face, max_epa_face_count> faces;
+    std::size_t face_count = 0;
+    const auto add_face = [&](const std::size_t a, const std::size_t b, const std::size_t c) {
+        math::Vector3 normal = (vertices[b].point - vertices[a].point).Cross(vertices[c].point - vertices[a].point);
+        const float length = normal.Length();
+        if (length <= std::numeric_limits<float>::epsilon() || face_count == faces.size()) {
+            return;
+        }
+        normal /= length;
+        faces[face_count++] = Face{.vertices = {a, b, c}, .normal = normal, .distance = normal.Dot(vertices[a].point)};
+    };
+
+    // Faces of the tetrahedron are wound so that their normals point away from the opposite vertex
+    for (auto [a, b, c, d] : {std::array<std::size_t, 4>{0, 1, 2, 3}, std::array<std::size_t, 4>{0, 2, 3, 1},
+                              std::array<std::size_t, 4>{0, 3, 1, 2}, std::array<std::size_t, 4>{1, 3, 2, 0}}) {
+        const math::Vector3 normal =
+            (vertices[b].point - vertices[a].point).Cross(vertices[c].point - vertices[a].point);
+        if (normal.Dot(vertices[d].point - vertices[a].point) > 0.0f) {
+            std::swap(b, c);
+        }
+        add_face(a, b, c);
+    }
+
+    std::array<std::pair<std::size_t, std::size_t>, max_epa_face_count * 3> horizon;
+    for (std::size_t iteration = 0; face_count > 0; ++iteration) {
+        const Face face = *std::ranges::min_element(std::span{faces}.first(face_count), std::less{}, &Face::distance);
+        const Vertex vertex = SupportVertex(lhs, rhs, face.normal);
+        const float distance = face.normal.Dot(vertex.point);
+        if (distance - face.distance <= relative_tolerance * (std::max)(face.distance, 1.0f) ||
+            iteration == max_epa_iterations || vertex_count == vertices.size()) {
+            penetration = PenetrationOf(face, std::span{vertices}.first(vertex_count));
+            return true;
+        }
+
+        // Faces which see the new vertex are removed, their edges which are not shared form the horizon
+        std::size_t horizon_size = 0;
+        for (std::size_t index = 0; index < face_count;) {
+            const Face &visible = faces[index];
+            if (visible.normal.Dot(vertex.point - vertices[visible.vertices[0]].point) <= 0.0f) {
+                ++index;
+                continue;
+            }
+
+            for (std::size_t edge = 0; edge < 3; ++edge) {
+                const std::size_t a = visible.vertices[edge];
+                const std::size_t b = visible.vertices[(edge + 1) % 3];
+                const auto begin = horizon.begin();
+                const auto end = begin + static_cast<std::ptrdiff_t>(horizon_size);
+                if (const auto it = std::find(begin, end, std::pair{b, a}); it != end) {
+                    *it = horizon[--horizon_size];
+                } else {
+                    horizon[horizon_size++] = {a, b};
+                }
+            }
+            faces[index] = faces[--face_count];
+        }
+
+        vertices[vertex_count] = vertex;
+        for (std::size_t index = 0; index < horizon_size; ++index) {
+            add_face(horizon[index].first, horizon[index].second, vertex_count);
+        }
+        vertex_count += 1;
+    }
+    return false;
+}
+
+// Second shape rotated around the pivot, which reveals other points of the contact
+struct PerturbedShape {
+    const ConvexShape *shape;
+    math::Quaternion rotation;
+    math::Quaternion inverse_rotation;
+    math::Vector3 pivot;
+};
+
+math::Vector3 Support(const PerturbedShape &shape, const math::Vector3 &direction) {
+    const math::Vector3 point = shape.shape->Support(math::Vector3::Transform(direction, shape.inverse_rotation));
+    return shape.pivot + math::Vector3::Transform(point - shape.pivot, shape.rotation);
+}
+
+// Deepest point goes first, then every next one is the farthest from the points already taken
+void SelectPoints(const std::span<const ContactPoint> candidates, ContactManifold &manifold) {
+    manifold.points[0] = candidates.front();
+    manifold.point_count = 1;
+    while (manifold.point_count < ContactManifold::max_point_count) {
+        const ContactPoint *farthest = nullptr;
+        float farthest_distance = merge_distance * merge_distance;
+        for (const ContactPoint &candidate : candidates.subspan(1)) {
+            float distance = std::numeric_limits<float>::infinity();
+            for (std::size_t index = 0; index < manifold.point_count; ++index) {
+                distance = (std::min)(distance, math::Vector3::DistanceSquared(candidate.position,
+                                                                                manifold.points[index].position));
+            }
+            if (distance > farthest_distance) {
+                farthest = &candidate;
+                farthest_distance = distance;
+            }
+        }
+        if (farthest == nullptr) {
+            break;
+        }
+        manifold.points[manifold.point_count++] = *farthest;
+    }
+}
+
+}  // namespace
+
+bool Intersects(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex) {
+    math::Vector3 closest;
+    Weights weights;
+    return RunGjk(lhs, rhs, simplex, closest, weights);
+}
+
+bool ClosestPoints(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex, ConvexDistance &result) {
+    math::Vector3 closest;
+    Weights weights;
+    if (RunGjk(lhs, rhs, simplex, closest, weights)) {
+        return false;
+    }
+
+    result = ConvexDistance{
+        .distance = closest.Length(),
+        .lhs_point = math::Vector3::Zero,
+        .rhs_point = math::Vector3::Zero,
+    };
+    for (std::size_t index = 0; index < simplex.size; ++index) {
+        result.lhs_point += simplex.vertices[index].lhs_point * weights[index];
+        result.rhs_point += simplex.vertices[index].rhs_point * weights[index];
+    }
+    return true;
+}
+
+bool Contact(const ConvexShape &lhs, const ConvexShape &rhs, GjkSimplex &simplex, ContactManifold &manifold) {
+    math::Vector3 closest;
+    Weights weights;
+    if (!RunGjk(lhs, rhs, simplex, closest, weights)) {
+        return false;
+    }
+
+    Penetration penetration;
+    if (!RunEpa(lhs, rhs, simplex, penetration)) {
+        // Minkowski difference is flat, so the shapes only touch and the normal is the one of the flat side
+        penetration = Penetration{.normal = math::Vector3::UnitY, .depth = 0.0f, .rhs_point = math::Vector3::Zero};
+        if (simplex.size == 3) {
+            const math::Vector3 a = simplex.vertices[0].point;
+            penetration.normal = (simplex.vertices[1].point - a).Cross(simplex.vertices[2].point - a);
+            penetration.normal.Normalize();
+        }
+        for (std::size_t index = 0; index < simplex.size; ++index) {
+            penetration.rhs_point += simplex.vertices[index].rhs_point * weights[index];
+        }
+    }
+
+    const math::Vector3 &normal = penetration.normal;
+    std::array<ContactPoint, perturbation_count + 1> candidates;
+    std::size_t candidate_count = 0;
+    candidates[candidate_count++] = ContactPoint{.position = penetration.rhs_point, .depth = penetration.depth};
+
+    math::Vector3 tangent = normal.Cross(std::abs(normal.x) < 0.5f ? math::Vector3::UnitX : math::Vector3::UnitY);
+    tangent.Normalize();
+    const math::Vector3 bitangent = normal.Cross(tangent);
+    for (std::size_t index = 0; index < perturbation_count; ++index) {
+        const float angle = std::numbers::pi_v<float> * (0.25f + 0.5f * static_cast<float>(index));
+        const math::Vector3 axis = tangent * std::cos(angle) + bitangent * std::sin(angle);
+
+        PerturbedShape perturbed{.shape = &rhs, .pivot = penetration.rhs_point};
+        perturbed.rotation = math::Quaternion::CreateFromAxisAngle(axis, perturbation_angle);
+        perturbed.rotation.Conjugate(perturbed.inverse_rotation);
+
+        const ConvexShape perturbed_shape{perturbed};
+        GjkSimplex perturbed_simplex = simplex;
+        Penetration perturbed_penetration;
+        if (!RunGjk(lhs, perturbed_shape, perturbed_simplex, closest, weights) ||
+            !RunEpa(lhs, perturbed_shape, perturbed_simplex, perturbed_penetration)) {
+            continue;
+        }
+
+        // Point is moved back onto the second shape, its depth is measured along the real normal.
+        // Tilted curved surface just rolls the point aside and up by the half of the angle,
+        // so only the points which stay near the plane of the contact are real ones
+        const math::Vector3 offset = perturbed_penetration.rhs_point - perturbed.pivot;
+        const math::Vector3 point = perturbed.pivot + math::Vector3::Transform(offset, perturbed.inverse_rotation);
+        const float height = (point - penetration.rhs_point).Dot(normal);
+        const float spread = (point - penetration.rhs_point - normal * height).Length();
+        const float depth = penetration.depth - height;
+        if (depth >= 0.0f && height <= spread * perturbation_angle * 0.25f) {
+            candidates[candidate_count++] = ContactPoint{.position = point, .depth = depth};
+        }
+    }
+
+    manifold.normal = normal;
+    manifold.depth = penetration.depth;
+    SelectPoints(std::span{candidates}.first(candidate_count), manifold);
+    return true;
+}
+
+}  // namespace borov_engine
@@ -1,6 +1,7 @@
 #include "borov_engine/math.hpp"
 
 #include <array>
+#include <cmath>
 #include <numeric>
 
 namespace borov_engine::math {
@@ -62,6 +63,24 @@ Vector3 FrustumCenter(const Frustum &frustum) {
     return std::accumulate(std::begin(corners), std::end(corners), Vector3::Zero) / static_cast<float>(corners.size());
 }
 
+Vector3 ClosestPoint(const AxisAlignedBox &box, const Vector3 &point) {
+    const Vector3 center{box.Center};
+    const Vector3 extents{box.Extents};
+    return Vector3::Clamp(point, center - extents, center + extents);
+}
+
+float Distance(const AxisAlignedBox &lhs, const AxisAlignedBox &rhs) {
+    // Gap along every axis between the boxes, negative gaps are overlaps
+    const Vector3 offset = Vector3{lhs.Center} - Vector3{rhs.Center};
+    const Vector3 extents = Vector3{lhs.Extents} + Vector3{rhs.Extents};
+    const Vector3 gap{
+        std::abs(offset.x) - extents.x,
+        std::abs(offset.y) - extents.y,
+        std::abs(offset.z) - extents.z,
+    };
+    return Vector3::Max(gap, Vector3::Zero).Length();
+}
+
 Vector3 Triangle::Tangent() const {
     return Normalize(point1 - point0);
 }
@@ -81,6 +100,54 @@ Plane Triangle::Plane() const {
     return math::Plane{point0, point1, point2};
 }
 
+Vector3 Triangle::ClosestPoint(const Vector3 &point) const {
+    const Vector3 edge01 = point1 - point0;
+    const Vector3 edge02 = point2 - point0;
+
+    // Vertex regions first, then edge regions, and the face itself if the point is in none of them
+    const Vector3 offset0 = point - point0;
+    const float d1 = edge01.Dot(offset0);
+    const float d2 = edge02.Dot(offset0);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return point0;
+    }
+
+    const Vector3 offset1 = point - point1;
+    const float d3 = edge01.Dot(offset1);
+    const float d4 = edge02.Dot(offset1);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return point1;
+    }
+
+    const float area2 = d1 * d4 - d3 * d2;
+    if (area2 <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return point0 + edge01 * (d1 / (d1 - d3));
+    }
+
+    const Vector3 offset2 = point - point2;
+    const float d5 = edge01.Dot(offset2);
+    const float d6 = edge02.Dot(offset2);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return point2;
+    }
+
+    const float area1 = d5 * d2 - d1 * d6;
+    if (area1 <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return point0 + edge02 * (d2 / (d2 - d6));
+    }
+
+    const float area0 = d3 * d6 - d5 * d4;
+    if (area0 <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return point1 + (point2 - point1) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float area = area0 + area1 + area2;
+    if (area <= 0.0f) {
+        return point0;
+    }
+    return point0 + edge01 * (area1 / area) + edge02 * (area2 / area);
+}
+
 bool Triangle::Intersects(const AxisAlignedBox &axis_aligned_box) const {
     return axis_aligned_box.Intersects(point0, point1, point2);
 }
@@ -91,7 +91,7 @@ Camera* OrbitCameraManager::MainCamera() {
 void OrbitCameraManager::Update(const float delta_time) {
     CameraManager::Update(delta_time);
 
-    Transform& transform = camera_.get().Transform();
+    TransformReference transform = camera_.get().Transform();
     if (const Input* input = Game().Input();
         enable_look_input_key_ == InputKey::None || (input != nullptr && input->IsKeyDown(enable_look_input_key_))) {
         auto [pitch, yaw, roll] = transform.rotation.ToEuler();
@@ -0,0 +1,342 @@
+#include "borov_engine/quickhull.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace borov_engine {
+
+namespace {
+
+using Index = Quickhull::Index;
+
+constexpr Index no_index = std::numeric_limits<Index>::max();
+
+struct Face {
+    // Edge `k` goes from `vertices[k]` to `vertices[(k + 1) % 3]`, and `neighbors[k]` is the face across it
+    std::array<Index, 3> vertices;
+    std::array<Index, 3> neighbors;
+    math::Vector3 normal;
+    float offset;
+    // Points above the face which are not assigned to any other face yet
+    std::vector<Index> outside;
+    bool is_deleted;
+};
+
+struct HorizonEdge {
+    Index from;
+    Index to;
+    // Face which stays on the hull behind the edge
+    Index neighbor;
+};
+
+class Builder {
+  public:
+    explicit Builder(const std::span<const math::Vector3> points) : points_{points} {
+        float max_coordinate = 0.0f;
+        for (const math::Vector3 &point : points_) {
+            max_coordinate += (std::max)({std::abs(point.x), std::abs(point.y), std::abs(point.z)});
+        }
+        // Same as qhull does, the tolerance grows with the magnitude of the coordinates
+        epsilon_ = 3.0f * std::numeric_limits<float>::epsilon() * max_coordinate / static_cast<float>(points_.size());
+        epsilon_ = (std::max)(epsilon_, std::numeric_limits<float>::min());
+    }
+
+    [[nodiscard]] bool Build() {
+        if (points_.size() < 4 || !BuildSimplex()) {
+            return false;
+        }
+
+        std::size_t cursor = 0;
+        while (true) {
+            // Faces never get new points after they were created, so the ones skipped once are done for good
+            while (cursor < faces_.size() && (faces_[cursor].is_deleted || faces_[cursor].outside.empty())) {
+                ++cursor;
+            }
+            if (cursor == faces_.size()) {
+                return true;
+            }
+            AddPoint(static_cast<Index>(cursor));
+        }
+    }
+
+    [[nodiscard]] const std::vector<Face> &Faces() const {
+        return faces_;
+    }
+
+  private:
+    [[nodiscard]] float Distance(const Face &face, const Index point) const {
+        return face.normal.Dot(points_[point]) - face.offset;
+    }
+
+    [[nodiscard]] bool BuildSimplex() {
+        const auto count = static_cast<Index>(points_.size());
+
+        // Two extreme points along the axes which are the farthest from each other
+        std::array<Index, 6> extremes{};
+        for (Index index = 1; index < count; ++index) {
+            const math::Vector3 &point = points_[index];
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                const float coordinate = (&point.x)[axis];
+                if (coordinate < (&points_[extremes[axis * 2]].x)[axis]) {
+                    extremes[axis * 2] = index;
+                }
+                if (coordinate > (&points_[extremes[axis * 2 + 1]].x)[axis]) {
+                    extremes[axis * 2 + 1] = index;
+                }
+            }
+        }
+        Index first = 0;
+        Index second = 0;
+        float max_distance = 0.0f;
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+            const Index min = extremes[axis * 2];
+            const Index max = extremes[axis * 2 + 1];
+            if (const float distance = math::Vector3::DistanceSquared(points_[min], points_[max]);
+                distance > max_distance) {
+                max_distance = distance;
+                first = min;
+                second = max;
+            }
+        }
+        if (max_distance <= epsilon_ * epsilon_) {
+            return false;
+        }
+
+        // Third one is the farthest from the line through them
+        const math::Vector3 line = points_[second] - points_[first];
+        Index third = 0;
+        max_distance = 0.0f;
+        for (Index index = 0; index < count; ++index) {
+            const float distance = line.Cross(points_[index] - points_[first]).LengthSquared();
+            if (distance > max_distance) {
+                max_distance = distance;
+                third = index;
+            }
+        }
+        if (max_distance <= epsilon_ * epsilon_ * line.LengthSquared()) {
+            return false;
+        }
+
+        // And the fourth one is the farthest from the plane through all three
+        math::Vector3 normal = line.Cross(points_[third] - points_[first]);
+        normal.Normalize();
+        Index fourth = 0;
+        max_distance = 0.0f;
+        for (Index index = 0; index < count; ++index) {
+            const float distance = std::abs(normal.Dot(points_[index] - points_[first]));
+            if (distance > max_distance) {
+                max_distance = distance;
+                fourth = index;
+            }
+        }
+        if (max_distance <= epsilon_) {
+            return false;
+        }
+
+        // Base is wound so that the fourth point is below it
+        if (normal.Dot(points_[fourth] - points_[first]) > 0.0f) {
+            std::swap(second, third);
+        }
+        AddFace(first, second, third);
+        AddFace(first, fourth, second);
+        AddFace(second, fourth, third);
+        AddFace(third, fourth, first);
+        for (Face &face : faces_) {
+            for (std::size_t edge = 0; edge < 3; ++edge) {
+                face.neighbors[edge] = FindFace(face.vertices[(edge + 1) % 3], face.vertices[edge]);
+            }
+        }
+
+        for (Index index = 0; index < count; ++index) {
+            if (index != first && index != second && index != third && index != fourth) {
+                AssignPoint(index, 0, static_cast<Index>(faces_.size()));
+            }
+        }
+        return true;
+    }
+
+    Index AddFace(const Index a, const Index b, const Index c) {
+        math::Vector3 normal = (points_[b] - points_[a]).Cross(points_[c] - points_[a]);
+        normal.Normalize();
+
+        faces_.push_back(Face{
+            .vertices = {a, b, c},
+            .neighbors = {no_index, no_index, no_index},
+            .normal = normal,
+            .offset = normal.Dot(points_[a]),
+            .outside = {},
+            .is_deleted = false,
+        });
+        return static_cast<Index>(faces_.size() - 1);
+    }
+
+    // Used for the initial simplex only, the hull is tiny then
+    [[nodiscard]] Index FindFace(const Index from, const Index to) const {
+        for (Index index = 0; index < faces_.size(); ++index) {
+            const auto &vertices = faces_[index].vertices;
+            for (std::size_t edge = 0; edge < 3; ++edge) {
+                if (vertices[edge] == from && vertices[(edge + 1) % 3] == to) {
+                    return index;
+                }
+            }
+        }
+        return no_index;
+    }
+
+    // Point goes to the first face it is above, points below every face are inside and dropped
+    void AssignPoint(const Index point, const Index first_face, const Index last_face) {
+        for (Index index = first_face; index < last_face; ++index) {
+            if (Distance(faces_[index], point) > epsilon_) {
+                faces_[index].outside.push_back(point);
+                return;
+            }
+        }
+    }
+
+    void AddPoint(const Index face_index) {
+        // Eye is the farthest point above the face
+        const std::vector<Index> &outside = faces_[face_index].outside;
+        const Index eye = *std::ranges::max_element(
+            outside, std::less{}, [&](const Index point) { return Distance(faces_[face_index], point); });
+
+        // Faces seen from the eye form a connected region, which is replaced by the cone from its horizon
+        std::vector<Index> visible{face_index};
+        faces_[face_index].is_deleted = true;
+        std::vector<HorizonEdge> horizon;
+        for (std::size_t next = 0; next < visible.size(); ++next) {
+            const Face &face = faces_[visible[next]];
+            for (std::size_t edge = 0; edge < 3; ++edge) {
+                const Index neighbor = face.neighbors[edge];
+                Face &neighbor_face = faces_[neighbor];
+                if (neighbor_face.is_deleted) {
+                    continue;
+                }
+                if (Distance(neighbor_face, eye) > epsilon_) {
+                    neighbor_face.is_deleted = true;
+                    visible.push_back(neighbor);
+                } else {
+                    horizon.push_back(HorizonEdge{
+                        .from = face.vertices[edge],
+                        .to = face.vertices[(edge + 1) % 3],
+                        .neighbor = neighbor,
+                    });
+                }
+            }
+        }
+
+        // Horizon is a loop, so every new face meets the others by the edges from and to the eye
+        const auto first_new_face = static_cast<Index>(faces_.size());
+        std::unordered_map<Index, Index> face_from;
+        std::unordered_map<Index, Index> face_to;
+        for (const auto &[from, to, neighbor] : horizon) {
+            const Index new_face = AddFace(from, to, eye);
+            faces_[new_face].neighbors[0] = neighbor;
+
+            auto &neighbor_vertices = faces_[neighbor].vertices;
+            for (std::size_t edge = 0; edge < 3; ++edge) {
+                if (neighbor_vertices[edge] == to && neighbor_vertices[(edge + 1) % 3] == from) {
+                    faces_[neighbor].neighbors[edge] = new_face;
+                }
+            }
+            face_from[from] = new_face;
+            face_to[to] = new_face;
+        }
+        for (Index index = first_new_face; index < faces_.size(); ++index) {
+            Face &face = faces_[index];
+            face.neighbors[1] = face_from[face.vertices[1]];
+            face.neighbors[2] = face_to[face.vertices[0]];
+        }
+
+        for (const Index visible_index : visible) {
+            for (const Index point : std::exchange(faces_[visible_index].outside, {})) {
+                if (point != eye) {
+                    AssignPoint(point, first_new_face, static_cast<Index>(faces_.size()));
+                }
+            }
+        }
+    }
+
+    std::span<const math::Vector3> points_;
+    std::vector<Face> faces_;
+    float epsilon_;
+};
+
+// Sum of the signed volumes of the tetrahedra from the origin to every triangle
+float VolumeOf(const std::span<const math::Vector3> vertices, const std::span<const Index> indices) {
+    float volume = 0.0f;
+    for (std::size_t index = 0; index + 2 < indices.size(); index += 3) {
+        const math::Vector3 &a = vertices[indices[index]];
+        const math::Vector3 &b = vertices[indices[index + 1]];
+        const math::Vector3 &c = vertices[indices[index + 2]];
+        volume += a.Dot(b.Cross(c));
+    }
+    return volume / 6.0f;
+}
+
+}  // namespace
+
+Quickhull::Quickhull(const std::span<const math::Vector3> points) {
+    Builder builder{points};
+    if (!builder.Build()) {
+        vertices_.assign(points.begin(), points.end());
+        return;
+    }
+
+    // Only the points referenced by the faces are kept, in the order they are met
+    std::unordered_map<Index, Index> remap;
+    for (const Face &face : builder.Faces()) {
+        if (face.is_deleted) {
+            continue;
+        }
+        for (const Index point : face.vertices) {
+            const auto [it, is_inserted] = remap.try_emplace(point, static_cast<Index>(vertices_.size()));
+            if (is_inserted) {
+                vertices_.push_back(points[point]);
+            }
+            indices_.push_back(it->second);
+        }
+    }
+
+    volume_ = VolumeOf(vertices_, indices_);
+}
+
+Quickhull::Quickhull(VertexCollection &&vertices, IndexCollection &&indices)
+    : vertices_{std::move(vertices)},
+      indices_{std::move(indices)} {
+    volume_ = VolumeOf(vertices_, indices_);
+}
+
+std::span<const math::Vector3> Quickhull::Vertices() const {
+    return vertices_;
+}
+
+auto Quickhull::Indices() const -> std::span<const Index> {
+    return indices_;
+}
+
+float Quickhull::Volume() const {
+    return volume_;
+}
+
+math::Vector3 Support(const Quickhull &hull, const math::Vector3 &direction) {
+    const std::span vertices = hull.Vertices();
+    assert(!vertices.empty() && "Hull must have at least one vertex");
+
+    const math::Vector3 *farthest = &vertices.front();
+    float farthest_distance = farthest->Dot(direction);
+    for (const math::Vector3 &vertex : vertices.subspan(1)) {
+        const float distance = vertex.Dot(direction);
+        if (distance > farthest_distance) {
+            farthest = &vertex;
+            farthest_distance = distance;
+        }
+    }
+    return *farthest;
+}
+
+}  // namespace borov_engine
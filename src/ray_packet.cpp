@@ -0,0 +1,281 @@
+#include "borov_engine/ray_packet.hpp"
+
+#include <immintrin.h>
+
+#include <cassert>
+#include <limits>
+
+namespace borov_engine {
+
+namespace {
+
+// Thin layer over the intrinsics of the widest instruction set enabled for the build,
+// so every kernel below is written once for both widths
+#if defined(__AVX__)
+using Float = __m256;
+
+Float Load(const float *pointer) {
+    return _mm256_loadu_ps(pointer);
+}
+
+void Store(float *pointer, const Float value) {
+    _mm256_storeu_ps(pointer, value);
+}
+
+Float Splat(const float value) {
+    return _mm256_set1_ps(value);
+}
+
+Float Add(const Float lhs, const Float rhs) {
+    return _mm256_add_ps(lhs, rhs);
+}
+
+Float Subtract(const Float lhs, const Float rhs) {
+    return _mm256_sub_ps(lhs, rhs);
+}
+
+Float Multiply(const Float lhs, const Float rhs) {
+    return _mm256_mul_ps(lhs, rhs);
+}
+
+Float Divide(const Float lhs, const Float rhs) {
+    return _mm256_div_ps(lhs, rhs);
+}
+
+Float Min(const Float lhs, const Float rhs) {
+    return _mm256_min_ps(lhs, rhs);
+}
+
+Float Max(const Float lhs, const Float rhs) {
+    return _mm256_max_ps(lhs, rhs);
+}
+
+Float And(const Float lhs, const Float rhs) {
+    return _mm256_and_ps(lhs, rhs);
+}
+
+Float AndNot(const Float lhs, const Float rhs) {
+    return _mm256_andnot_ps(lhs, rhs);
+}
+
+Float LessEqual(const Float lhs, const Float rhs) {
+    return _mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ);
+}
+
+RayPacket::Mask MaskOf(const Float value) {
+    return static_cast<RayPacket::Mask>(_mm256_movemask_ps(value));
+}
+#else
+using Float = __m128;
+
+Float Load(const float *pointer) {
+    return _mm_loadu_ps(pointer);
+}
+
+void Store(float *pointer, const Float value) {
+    _mm_storeu_ps(pointer, value);
+}
+
+Float Splat(const float value) {
+    return _mm_set1_ps(value);
+}
+
+Float Add(const Float lhs, const Float rhs) {
+    return _mm_add_ps(lhs, rhs);
+}
+
+Float Subtract(const Float lhs, const Float rhs) {
+    return _mm_sub_ps(lhs, rhs);
+}
+
+Float Multiply(const Float lhs, const Float rhs) {
+    return _mm_mul_ps(lhs, rhs);
+}
+
+Float Divide(const Float lhs, const Float rhs) {
+    return _mm_div_ps(lhs, rhs);
+}
+
+Float Min(const Float lhs, const Float rhs) {
+    return _mm_min_ps(lhs, rhs);
+}
+
+Float Max(const Float lhs, const Float rhs) {
+    return _mm_max_ps(lhs, rhs);
+}
+
+Float And(const Float lhs, const Float rhs) {
+    return _mm_and_ps(lhs, rhs);
+}
+
+Float AndNot(const Float lhs, const Float rhs) {
+    return _mm_andnot_ps(lhs, rhs);
+}
+
+Float LessEqual(const Float lhs, const Float rhs) {
+    return _mm_cmple_ps(lhs, rhs);
+}
+
+RayPacket::Mask MaskOf(const Float value) {
+    return static_cast<RayPacket::Mask>(_mm_movemask_ps(value));
+}
+#endif
+
+Float Abs(const Float value) {
+    return AndNot(Splat(-0.0f), value);
+}
+
+struct Vector {
+    Float x;
+    Float y;
+    Float z;
+};
+
+Vector Load(const std::array<RayPacket::Lanes, 3> &lanes) {
+    return Vector{.x = Load(lanes[0].data()), .y = Load(lanes[1].data()), .z = Load(lanes[2].data())};
+}
+
+Vector Splat(const math::Vector3 &vector) {
+    return Vector{.x = Splat(vector.x), .y = Splat(vector.y), .z = Splat(vector.z)};
+}
+
+Vector Subtract(const Vector &lhs, const Vector &rhs) {
+    return Vector{.x = Subtract(lhs.x, rhs.x), .y = Subtract(lhs.y, rhs.y), .z = Subtract(lhs.z, rhs.z)};
+}
+
+Float Dot(const Vector &lhs, const Vector &rhs) {
+    return Add(Add(Multiply(lhs.x, rhs.x), Multiply(lhs.y, rhs.y)), Multiply(lhs.z, rhs.z));
+}
+
+Vector Cross(const Vector &lhs, const Vector &rhs) {
+    return Vector{
+        .x = Subtract(Multiply(lhs.y, rhs.z), Multiply(lhs.z, rhs.y)),
+        .y = Subtract(Multiply(lhs.z, rhs.x), Multiply(lhs.x, rhs.z)),
+        .z = Subtract(Multiply(lhs.x, rhs.y), Multiply(lhs.y, rhs.x)),
+    };
+}
+
+// Entries and exits of every lane through the slabs of the box, the same way as for the single ray
+Float Slabs(const Vector &origin, const Vector &inverse_direction, const math::Vector3 &min, const math::Vector3 &max,
+            const Float max_distances, Float &entries) {
+    const Float near_x = Multiply(Subtract(Splat(min.x), origin.x), inverse_direction.x);
+    const Float near_y = Multiply(Subtract(Splat(min.y), origin.y), inverse_direction.y);
+    const Float near_z = Multiply(Subtract(Splat(min.z), origin.z), inverse_direction.z);
+    const Float far_x = Multiply(Subtract(Splat(max.x), origin.x), inverse_direction.x);
+    const Float far_y = Multiply(Subtract(Splat(max.y), origin.y), inverse_direction.y);
+    const Float far_z = Multiply(Subtract(Splat(max.z), origin.z), inverse_direction.z);
+
+    entries = Max(Max(Min(near_x, far_x), Min(near_y, far_y)), Max(Min(near_z, far_z), Splat(0.0f)));
+    const Float exits = Min(Min(Max(near_x, far_x), Max(near_y, far_y)), Min(Max(near_z, far_z), max_distances));
+    return LessEqual(entries, exits);
+}
+
+}  // namespace
+
+RayPacket::RayPacket(const std::span<const math::Ray> rays) : size_{rays.size()} {
+    assert(!rays.empty() && rays.size() <= width && "Packet must contain from one ray to its width of rays");
+
+    // Inactive lanes repeat the first ray, so they never produce anything unusual like NaNs
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        const math::Ray &ray = rays[lane < size_ ? lane : 0];
+        origin_[0][lane] = ray.position.x;
+        origin_[1][lane] = ray.position.y;
+        origin_[2][lane] = ray.position.z;
+        direction_[0][lane] = ray.direction.x;
+        direction_[1][lane] = ray.direction.y;
+        direction_[2][lane] = ray.direction.z;
+        inverse_direction_[0][lane] = 1.0f / ray.direction.x;
+        inverse_direction_[1][lane] = 1.0f / ray.direction.y;
+        inverse_direction_[2][lane] = 1.0f / ray.direction.z;
+    }
+}
+
+std::size_t RayPacket::Size() const {
+    return size_;
+}
+
+auto RayPacket::ActiveMask() const -> Mask {
+    return (Mask{1} << size_) - 1;
+}
+
+math::Ray RayPacket::Ray(const std::size_t lane) const {
+    return math::Ray{
+        math::Vector3{origin_[0][lane], origin_[1][lane], origin_[2][lane]},
+        math::Vector3{direction_[0][lane], direction_[1][lane], direction_[2][lane]},
+    };
+}
+
+auto RayPacket::Intersects(const math::AxisAlignedBox &box, const Lanes &max_distances, Lanes &entries) const
+    -> Mask {
+    const math::Vector3 center{box.Center};
+    const math::Vector3 extents{box.Extents};
+    return Intersects(center - extents, center + extents, max_distances, entries);
+}
+
+auto RayPacket::Intersects(const math::Vector3 &min, const math::Vector3 &max, const Lanes &max_distances,
+                           Lanes &entries) const -> Mask {
+    Float entry_lanes;
+    const Float is_hit =
+        Slabs(Load(origin_), Load(inverse_direction_), min, max, Load(max_distances.data()), entry_lanes);
+    Store(entries.data(), entry_lanes);
+    return MaskOf(is_hit) & ActiveMask();
+}
+
+auto RayPacket::Intersects(const math::Box &box, const Lanes &max_distances, Lanes &entries) const -> Mask {
+    // Projections on the axes of the box are the coordinates in its space
+    const math::Quaternion orientation{box.Orientation};
+    const Vector axis_x = Splat(math::Vector3::Transform(math::Vector3::UnitX, orientation));
+    const Vector axis_y = Splat(math::Vector3::Transform(math::Vector3::UnitY, orientation));
+    const Vector axis_z = Splat(math::Vector3::Transform(math::Vector3::UnitZ, orientation));
+
+    const Vector offset = Subtract(Load(origin_), Splat(math::Vector3{box.Center}));
+    const Vector direction = Load(direction_);
+    const Vector local_origin{.x = Dot(offset, axis_x), .y = Dot(offset, axis_y), .z = Dot(offset, axis_z)};
+    const Float one = Splat(1.0f);
+    const Vector local_inverse_direction{
+        .x = Divide(one, Dot(direction, axis_x)),
+        .y = Divide(one, Dot(direction, axis_y)),
+        .z = Divide(one, Dot(direction, axis_z)),
+    };
+
+    const math::Vector3 extents{box.Extents};
+    Float entry_lanes;
+    const Float is_hit = Slabs(local_origin, local_inverse_direction, -extents, extents, Load(max_distances.data()),
+                               entry_lanes);
+    Store(entries.data(), entry_lanes);
+    return MaskOf(is_hit) & ActiveMask();
+}
+
+auto RayPacket::Intersects(const math::Triangle &triangle, const Lanes &max_distances, Lanes &distances, Lanes &us,
+                           Lanes &vs) const -> Mask {
+    const Vector edge1 = Splat(triangle.point1 - triangle.point0);
+    const Vector edge2 = Splat(triangle.point2 - triangle.point0);
+    const Vector direction = Load(direction_);
+
+    const Vector p = Cross(direction, edge2);
+    const Float determinant = Dot(edge1, p);
+    const Float inverse_determinant = Divide(Splat(1.0f), determinant);
+
+    const Vector t = Subtract(Load(origin_), Splat(triangle.point0));
+    const Float u = Multiply(Dot(t, p), inverse_determinant);
+    const Vector q = Cross(t, edge1);
+    const Float v = Multiply(Dot(direction, q), inverse_determinant);
+    const Float distance = Multiply(Dot(edge2, q), inverse_determinant);
+
+    const Float zero = Splat(0.0f);
+    // Only parallel rays and degenerate triangles are rejected, any fixed cutoff would miss small triangles.
+    // Their inverse determinant is infinite or not a number, and both fail the ordered comparison
+    Float is_hit = LessEqual(Abs(inverse_determinant), Splat(std::numeric_limits<float>::max()));
+    is_hit = And(is_hit, LessEqual(zero, u));
+    is_hit = And(is_hit, LessEqual(zero, v));
+    is_hit = And(is_hit, LessEqual(Add(u, v), Splat(1.0f)));
+    is_hit = And(is_hit, LessEqual(zero, distance));
+    is_hit = And(is_hit, LessEqual(distance, Load(max_distances.data())));
+
+    Store(distances.data(), distance);
+    Store(us.data(), u);
+    Store(vs.data(), v);
+    return MaskOf(is_hit) & ActiveMask();
+}
+
+}  // namespace borov_engine
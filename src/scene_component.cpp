@@ -3,34 +3,55 @@
 namespace borov_engine {
 
 SceneComponent::SceneComponent(class Game &game, const Initializer &initializer)
-    : Component(game), transform_{initializer.transform}, parent_{initializer.parent} {}
+    : Component(game),
+      transform_handle_{},
+      parent_{initializer.parent},
+      first_child_{},
+      last_child_{},
+      prev_sibling_{},
+      next_sibling_{} {
+    const TransformSystem::Handle parent_handle =
+        (parent_ != nullptr) ? parent_->transform_handle_ : TransformSystem::invalid_handle;
+    transform_handle_ = Game().TransformSystem().Add(initializer.transform, parent_handle);
+    LinkToParent();
+}
 
-const Transform &SceneComponent::Transform() const {
-    return transform_;
+SceneComponent::~SceneComponent() {
+    while (first_child_ != nullptr) {
+        // Children are not owned by the parent, so keep them alive at the same place in the world
+        auto *child = const_cast<SceneComponent *>(first_child_);
+        child->Parent(nullptr);
+    }
+    UnlinkFromParent();
+    Game().TransformSystem().Remove(transform_handle_);
 }
 
-Transform &SceneComponent::Transform() {
-    return transform_;
+Transform SceneComponent::Transform() const {
+    return Game().TransformSystem().LocalTransform(transform_handle_);
 }
 
-Transform SceneComponent::WorldTransform() const {
-    class Transform world_current = transform_;
-    if (parent_ != nullptr) {
-        const class Transform world_parent = parent_->WorldTransform();
-        world_current = Transform::Concatenate(world_parent, world_current);
-    }
+TransformReference SceneComponent::Transform() {
+    MarkWorldTransformDirty();
+    return Game().TransformSystem().LocalTransform(transform_handle_);
+}
 
-    return world_current;
+Transform SceneComponent::WorldTransform() const {
+    return Game().TransformSystem().WorldTransform(transform_handle_);
 }
 
 void SceneComponent::WorldTransform(const class Transform &world_transform) {
+    TransformReference transform = Transform();
     if (parent_ == nullptr) {
-        transform_ = world_transform;
+        transform = world_transform;
         return;
     }
 
     const class Transform inv_world_parent = Transform::Inverse(parent_->WorldTransform());
-    transform_ = Transform::Concatenate(inv_world_parent, world_transform);
+    transform = Transform::Concatenate(inv_world_parent, world_transform);
+}
+
+math::Matrix4x4 SceneComponent::WorldMatrix() const {
+    return Game().TransformSystem().WorldMatrix(transform_handle_);
 }
 
 const SceneComponent *SceneComponent::Parent() const {
@@ -38,12 +59,19 @@ const SceneComponent *SceneComponent::Parent() const {
 }
 
 bool SceneComponent::Parent(const SceneComponent *parent) {
-    if (parent == this) {
+    if (parent == this || (parent != nullptr && parent->IsChildOf(*this))) {
         return false;
     }
 
     const class Transform world_transform = WorldTransform();
+    MarkWorldTransformDirty();
+    UnlinkFromParent();
     parent_ = parent;
+    LinkToParent();
+
+    const TransformSystem::Handle parent_handle =
+        (parent_ != nullptr) ? parent_->transform_handle_ : TransformSystem::invalid_handle;
+    Game().TransformSystem().Parent(transform_handle_, parent_handle);
     WorldTransform(world_transform);
     return true;
 }
@@ -64,4 +92,62 @@ bool SceneComponent::IsChildOf(const SceneComponent &scene_component, std::size_
     return false;
 }
 
+void SceneComponent::LinkToParent() const {
+    if (parent_ == nullptr) {
+        return;
+    }
+
+    prev_sibling_ = parent_->last_child_;
+    next_sibling_ = nullptr;
+    if (prev_sibling_ != nullptr) {
+        prev_sibling_->next_sibling_ = this;
+    } else {
+        parent_->first_child_ = this;
+    }
+    parent_->last_child_ = this;
+}
+
+void SceneComponent::UnlinkFromParent() const {
+    if (parent_ == nullptr) {
+        return;
+    }
+
+    if (prev_sibling_ != nullptr) {
+        prev_sibling_->next_sibling_ = next_sibling_;
+    } else {
+        parent_->first_child_ = next_sibling_;
+    }
+    if (next_sibling_ != nullptr) {
+        next_sibling_->prev_sibling_ = prev_sibling_;
+    } else {
+        parent_->last_child_ = prev_sibling_;
+    }
+    prev_sibling_ = nullptr;
+    next_sibling_ = nullptr;
+}
+
+void SceneComponent::MarkWorldTransformDirty() {
+    // Children of the dirty component are dirty too, so there is no need to visit them again
+    TransformSystem &transform_system = Game().TransformSystem();
+    if (transform_system.IsWorldTransformDirty(transform_handle_)) {
+        return;
+    }
+    transform_system.MarkWorldTransformDirty(transform_handle_);
+
+    const SceneComponent *node = first_child_;
+    while (node != nullptr) {
+        if (!transform_system.IsWorldTransformDirty(node->transform_handle_)) {
+            transform_system.MarkWorldTransformDirty(node->transform_handle_);
+            if (node->first_child_ != nullptr) {
+                node = node->first_child_;
+                continue;
+            }
+        }
+        while (node != this && node->next_sibling_ == nullptr) {
+            node = node->parent_;
+        }
+        node = (node != this) ? node->next_sibling_ : nullptr;
+    }
+}
+
 }  // namespace borov_engine
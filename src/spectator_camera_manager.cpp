@@ -99,7 +99,7 @@ void SpectatorCameraManager::Update(const float delta_time) {
         return;
     }
 
-    Transform& transform = camera_.get().Transform();
+    TransformReference transform = camera_.get().Transform();
     if (enable_look_input_key_ == InputKey::None || input->IsKeyDown(enable_look_input_key_)) {
         {
             auto axis_value = [input](const MovementInput::Axis axis) {
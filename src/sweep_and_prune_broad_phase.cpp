@@ -0,0 +1,299 @@
+#include "borov_engine/sweep_and_prune_broad_phase.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace borov_engine {
+
+namespace {
+
+constexpr float infinity = std::numeric_limits<float>::infinity();
+
+}  // namespace
+
+auto SweepAndPruneBroadPhase::Endpoint::Proxy() const -> ProxyId {
+    return data >> 1;
+}
+
+bool SweepAndPruneBroadPhase::Endpoint::IsMax() const {
+    return data & 1;
+}
+
+bool SweepAndPruneBroadPhase::Endpoint::operator<(const Endpoint &other) const {
+    return value < other.value || (value == other.value && !IsMax() && other.IsMax());
+}
+
+SweepAndPruneBroadPhase::SweepAndPruneBroadPhase(const Axes axes)
+    : axes_{0, 1, 2},
+      axis_count_{max_axis_count},
+      is_sorted_{true} {
+    if (axes != Axes::All) {
+        axes_[0] = static_cast<std::size_t>(axes);
+        axis_count_ = 1;
+    }
+}
+
+auto SweepAndPruneBroadPhase::Add(const math::AxisAlignedBox &bounds) -> ProxyId {
+    ProxyId proxy;
+    if (free_proxies_.empty()) {
+        proxy = static_cast<ProxyId>(proxies_.size());
+        proxies_.emplace_back();
+    } else {
+        proxy = free_proxies_.back();
+        free_proxies_.pop_back();
+    }
+
+    // Sorting every new proxy in is quadratic when many of them are added at once,
+    // so endpoints are appended as is and sorted all together by the next update
+    proxies_[proxy].is_free = false;
+    for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+        std::vector<Endpoint> &endpoints = endpoints_[axis];
+        proxies_[proxy].endpoints[axis] = {static_cast<Index>(endpoints.size()),
+                                           static_cast<Index>(endpoints.size() + 1)};
+        endpoints.push_back(Endpoint{.data = proxy << 1});
+        endpoints.push_back(Endpoint{.data = (proxy << 1) | 1});
+    }
+    SetBounds(proxy, bounds);
+    is_sorted_ = false;
+    return proxy;
+}
+
+void SweepAndPruneBroadPhase::Move(const ProxyId proxy, const math::AxisAlignedBox &bounds) {
+    assert(proxy < proxies_.size() && !proxies_[proxy].is_free && "Proxy is not in the broad phase");
+
+    const Proxy old_data = proxies_[proxy];
+    SetBounds(proxy, bounds);
+    if (!is_sorted_) {
+        return;
+    }
+
+    const Proxy &data = proxies_[proxy];
+    for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+        const std::size_t coordinate = axes_[axis];
+        const float min = data.min[coordinate];
+        const float max = data.max[coordinate];
+        const float old_min = old_data.min[coordinate];
+        const float old_max = old_data.max[coordinate];
+
+        // Growing sides go first, so the minimum never has to pass the maximum of the same proxy
+        if (min < old_min) {
+            SortDown(axis, data.endpoints[axis][0]);
+        }
+        if (max > old_max) {
+            SortUp(axis, data.endpoints[axis][1]);
+        }
+        if (min > old_min) {
+            SortUp(axis, data.endpoints[axis][0]);
+        }
+        if (max < old_max) {
+            SortDown(axis, data.endpoints[axis][1]);
+        }
+    }
+}
+
+std::size_t SweepAndPruneBroadPhase::Size() const {
+    return proxies_.size() - free_proxies_.size();
+}
+
+void SweepAndPruneBroadPhase::Query(const math::AxisAlignedBox &region, const QueryFunction &function) const {
+    const math::Vector3 center{region.Center};
+    const math::Vector3 extents{region.Extents};
+    const math::Vector3 min = center - extents;
+    const math::Vector3 max = center + extents;
+    const Proxy region_data{.min = {min.x, min.y, min.z}, .max = {max.x, max.y, max.z}};
+
+    // Every proxy which could overlap the region begins before its end along the first axis,
+    // unless some proxies were added since the last update and the endpoints are not sorted yet
+    const std::size_t coordinate = axes_[0];
+    for (const Endpoint &endpoint : endpoints_[0]) {
+        if (endpoint.value > region_data.max[coordinate] && is_sorted_) {
+            break;
+        }
+        if (endpoint.data == removed_endpoint || endpoint.IsMax()) {
+            continue;
+        }
+        if (Overlaps(proxies_[endpoint.Proxy()], region_data)) {
+            function(endpoint.Proxy());
+        }
+    }
+}
+
+void SweepAndPruneBroadPhase::Query(const math::Ray &ray, const float max_distance,
+                                    const QueryFunction &function) const {
+    const std::array origin{ray.position.x, ray.position.y, ray.position.z};
+    const std::array inverse_direction{1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+    for (ProxyId proxy = 0; proxy < proxies_.size(); ++proxy) {
+        const Proxy &data = proxies_[proxy];
+        if (data.is_free) {
+            continue;
+        }
+
+        float entry = 0.0f;
+        float exit = max_distance;
+        for (std::size_t coordinate = 0; coordinate < max_axis_count; ++coordinate) {
+            const float near_plane = (data.min[coordinate] - origin[coordinate]) * inverse_direction[coordinate];
+            const float far_plane = (data.max[coordinate] - origin[coordinate]) * inverse_direction[coordinate];
+            entry = (std::max)(entry, (std::min)(near_plane, far_plane));
+            exit = (std::min)(exit, (std::max)(near_plane, far_plane));
+        }
+        if (entry <= exit) {
+            function(proxy);
+        }
+    }
+}
+
+void SweepAndPruneBroadPhase::RemoveProxy(const ProxyId proxy) {
+    assert(proxy < proxies_.size() && !proxies_[proxy].is_free && "Proxy is not in the broad phase");
+
+    if (is_sorted_) {
+        // Moving the proxy after every other one ends all of its pairs, then its endpoints are simply dropped
+        Move(proxy, math::AxisAlignedBox{math::Vector3{infinity}, math::Vector3::Zero});
+        for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+            endpoints_[axis].resize(endpoints_[axis].size() - 2);
+        }
+    } else {
+        for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+            for (const Index index : proxies_[proxy].endpoints[axis]) {
+                endpoints_[axis][index] = Endpoint{.value = infinity, .data = removed_endpoint};
+            }
+        }
+    }
+
+    proxies_[proxy].is_free = true;
+    free_proxies_.push_back(proxy);
+}
+
+void SweepAndPruneBroadPhase::FindPairs(std::vector<ProxyPair> &pairs) {
+    if (!is_sorted_) {
+        Sort();
+    }
+
+    if (axis_count_ != max_axis_count) {
+        Sweep(pairs);
+        return;
+    }
+
+    pairs.reserve(pairs.size() + tracked_pairs_.size());
+    for (const std::uint64_t key : tracked_pairs_) {
+        pairs.emplace_back(static_cast<ProxyId>(key >> 32), static_cast<ProxyId>(key));
+    }
+}
+
+std::uint64_t SweepAndPruneBroadPhase::Key(const ProxyId lhs, const ProxyId rhs) {
+    return (std::uint64_t{(std::min)(lhs, rhs)} << 32) | (std::max)(lhs, rhs);
+}
+
+bool SweepAndPruneBroadPhase::Overlaps(const Proxy &lhs, const Proxy &rhs) {
+    for (std::size_t coordinate = 0; coordinate < max_axis_count; ++coordinate) {
+        if (lhs.min[coordinate] > rhs.max[coordinate] || rhs.min[coordinate] > lhs.max[coordinate]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SweepAndPruneBroadPhase::SetBounds(const ProxyId proxy, const math::AxisAlignedBox &bounds) {
+    const math::Vector3 center{bounds.Center};
+    const math::Vector3 extents{bounds.Extents};
+    const math::Vector3 min = center - extents;
+    const math::Vector3 max = center + extents;
+
+    Proxy &data = proxies_[proxy];
+    data.min = {min.x, min.y, min.z};
+    data.max = {max.x, max.y, max.z};
+    for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+        endpoints_[axis][data.endpoints[axis][0]].value = data.min[axes_[axis]];
+        endpoints_[axis][data.endpoints[axis][1]].value = data.max[axes_[axis]];
+    }
+}
+
+void SweepAndPruneBroadPhase::Sort() {
+    for (std::size_t axis = 0; axis < axis_count_; ++axis) {
+        std::vector<Endpoint> &endpoints = endpoints_[axis];
+        std::erase_if(endpoints, [](const Endpoint &endpoint) { return endpoint.data == removed_endpoint; });
+        std::ranges::sort(endpoints, std::less{});
+        for (Index index = 0; index < endpoints.size(); ++index) {
+            const Endpoint &endpoint = endpoints[index];
+            proxies_[endpoint.Proxy()].endpoints[axis][endpoint.IsMax()] = index;
+        }
+    }
+
+    if (axis_count_ == max_axis_count) {
+        swept_pairs_.clear();
+        Sweep(swept_pairs_);
+        tracked_pairs_.clear();
+        for (const auto &[first, second] : swept_pairs_) {
+            tracked_pairs_.insert(Key(first, second));
+        }
+    }
+    is_sorted_ = true;
+}
+
+void SweepAndPruneBroadPhase::Sweep(std::vector<ProxyPair> &pairs) {
+    // Every proxy is compared only with the ones whose intervals along the first axis are still open
+    open_proxies_.clear();
+    for (const Endpoint &endpoint : endpoints_[0]) {
+        const ProxyId proxy = endpoint.Proxy();
+        if (endpoint.IsMax()) {
+            const auto it = std::ranges::find(open_proxies_, proxy);
+            *it = open_proxies_.back();
+            open_proxies_.pop_back();
+            continue;
+        }
+
+        for (const ProxyId open_proxy : open_proxies_) {
+            if (Overlaps(proxies_[proxy], proxies_[open_proxy])) {
+                pairs.emplace_back((std::min)(proxy, open_proxy), (std::max)(proxy, open_proxy));
+            }
+        }
+        open_proxies_.push_back(proxy);
+    }
+}
+
+void SweepAndPruneBroadPhase::SortDown(const std::size_t axis, Index index) {
+    std::vector<Endpoint> &endpoints = endpoints_[axis];
+    const Endpoint moved = endpoints[index];
+    while (index > 0 && moved < endpoints[index - 1]) {
+        const Endpoint passed = endpoints[index - 1];
+        OnSwap(moved, passed, true);
+        endpoints[index] = passed;
+        proxies_[passed.Proxy()].endpoints[axis][passed.IsMax()] = index;
+        index -= 1;
+    }
+    endpoints[index] = moved;
+    proxies_[moved.Proxy()].endpoints[axis][moved.IsMax()] = index;
+}
+
+void SweepAndPruneBroadPhase::SortUp(const std::size_t axis, Index index) {
+    std::vector<Endpoint> &endpoints = endpoints_[axis];
+    const Endpoint moved = endpoints[index];
+    while (index + 1 < endpoints.size() && endpoints[index + 1] < moved) {
+        const Endpoint passed = endpoints[index + 1];
+        OnSwap(moved, passed, false);
+        endpoints[index] = passed;
+        proxies_[passed.Proxy()].endpoints[axis][passed.IsMax()] = index;
+        index += 1;
+    }
+    endpoints[index] = moved;
+    proxies_[moved.Proxy()].endpoints[axis][moved.IsMax()] = index;
+}
+
+void SweepAndPruneBroadPhase::OnSwap(const Endpoint &moved, const Endpoint &passed, const bool is_moving_down) {
+    // Only the minimum passing the maximum of the other proxy, or the other way around, changes the overlap.
+    // Pairs along the single axis are found by the sweep instead
+    if (moved.IsMax() == passed.IsMax() || moved.Proxy() == passed.Proxy() || axis_count_ != max_axis_count) {
+        return;
+    }
+
+    // Bounds of both proxies are already final, so the overlap along the other axes is known too
+    const ProxyId lhs = moved.Proxy();
+    const ProxyId rhs = passed.Proxy();
+    const bool is_begin = moved.IsMax() != is_moving_down;
+    if (!is_begin) {
+        tracked_pairs_.erase(Key(lhs, rhs));
+    } else if (Overlaps(proxies_[lhs], proxies_[rhs])) {
+        tracked_pairs_.insert(Key(lhs, rhs));
+    }
+}
+
+}  // namespace borov_engine
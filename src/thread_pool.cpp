@@ -0,0 +1,48 @@
+#include "borov_engine/thread_pool.hpp"
+
+namespace borov_engine {
+
+ThreadPool::ThreadPool() : ThreadPool((std::max)(std::thread::hardware_concurrency(), 1u) - 1) {}
+
+ThreadPool::ThreadPool(const std::size_t worker_count) {
+    workers_.reserve(worker_count);
+    for (std::size_t worker = 0; worker < worker_count; ++worker) {
+        workers_.emplace_back([this](const std::stop_token &stop_token) { WorkerLoop(stop_token); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    // Stop every worker before joining any of them, waiting on the condition is interrupted by the stop request
+    for (std::jthread &worker : workers_) {
+        worker.request_stop();
+    }
+}
+
+std::size_t ThreadPool::WorkerCount() const {
+    return workers_.size();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::scoped_lock lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::WorkerLoop(const std::stop_token &stop_token) {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{mutex_};
+            if (!condition_.wait(lock, stop_token, [this] { return !tasks_.empty(); })) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace borov_engine
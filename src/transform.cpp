@@ -1,10 +1,308 @@
 #include "borov_engine/transform.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cfloat>
+
 namespace borov_engine {
 
+namespace {
+
+#if defined(_XM_SSE_INTRINSICS_)
+
+// The tail is padded to the whole packet instead of using the scalar functions,
+// so the result for any transform does not depend on its position in the batch
+constexpr std::size_t packet_size = 4;
+
+// Four vectors or quaternions with each component stored in its own register
+struct Packet {
+    __m128 x, y, z, w;
+};
+
+// Positions, rotations and scales of four transforms
+struct TransformPacket {
+    Packet position, rotation, scale;
+};
+
+template <typename T>
+Packet LoadPacket(const Transform *transforms, T Transform::*member) {
+    // Every member is aligned to 16 bytes, so even 3D vectors could be loaded as a whole
+    Packet packet{
+        .x = _mm_load_ps(&(transforms[0].*member).x),
+        .y = _mm_load_ps(&(transforms[1].*member).x),
+        .z = _mm_load_ps(&(transforms[2].*member).x),
+        .w = _mm_load_ps(&(transforms[3].*member).x),
+    };
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    return packet;
+}
+
+template <typename T>
+void StorePacket(Packet packet, Transform *transforms, T Transform::*member) {
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    _mm_store_ps(&(transforms[0].*member).x, packet.x);
+    _mm_store_ps(&(transforms[1].*member).x, packet.y);
+    _mm_store_ps(&(transforms[2].*member).x, packet.z);
+    _mm_store_ps(&(transforms[3].*member).x, packet.w);
+}
+
+// Vectors of the separate arrays are packed tightly, so each of them is loaded on its own
+// to not read past the end of the array
+Packet LoadPacket(const math::Vector3 *vectors) {
+    Packet packet{
+        .x = DirectX::XMLoadFloat3(&vectors[0]),
+        .y = DirectX::XMLoadFloat3(&vectors[1]),
+        .z = DirectX::XMLoadFloat3(&vectors[2]),
+        .w = DirectX::XMLoadFloat3(&vectors[3]),
+    };
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    return packet;
+}
+
+void StorePacket(Packet packet, math::Vector3 *vectors) {
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    DirectX::XMStoreFloat3(&vectors[0], packet.x);
+    DirectX::XMStoreFloat3(&vectors[1], packet.y);
+    DirectX::XMStoreFloat3(&vectors[2], packet.z);
+    DirectX::XMStoreFloat3(&vectors[3], packet.w);
+}
+
+Packet LoadPacket(const math::Quaternion *quaternions) {
+    Packet packet{
+        .x = _mm_loadu_ps(&quaternions[0].x),
+        .y = _mm_loadu_ps(&quaternions[1].x),
+        .z = _mm_loadu_ps(&quaternions[2].x),
+        .w = _mm_loadu_ps(&quaternions[3].x),
+    };
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    return packet;
+}
+
+void StorePacket(Packet packet, math::Quaternion *quaternions) {
+    _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+    _mm_storeu_ps(&quaternions[0].x, packet.x);
+    _mm_storeu_ps(&quaternions[1].x, packet.y);
+    _mm_storeu_ps(&quaternions[2].x, packet.z);
+    _mm_storeu_ps(&quaternions[3].x, packet.w);
+}
+
+TransformPacket LoadTransforms(const Transform *transforms) {
+    return TransformPacket{
+        .position = LoadPacket(transforms, &Transform::position),
+        .rotation = LoadPacket(transforms, &Transform::rotation),
+        .scale = LoadPacket(transforms, &Transform::scale),
+    };
+}
+
+void StoreTransforms(const TransformPacket &packet, Transform *transforms) {
+    StorePacket(packet.position, transforms, &Transform::position);
+    StorePacket(packet.rotation, transforms, &Transform::rotation);
+    StorePacket(packet.scale, transforms, &Transform::scale);
+}
+
+TransformPacket LoadTransforms(const ConstTransformSpan &transforms, const std::size_t index) {
+    return TransformPacket{
+        .position = LoadPacket(&transforms.positions[index]),
+        .rotation = LoadPacket(&transforms.rotations[index]),
+        .scale = LoadPacket(&transforms.scales[index]),
+    };
+}
+
+void StoreTransforms(const TransformPacket &packet, const TransformSpan &transforms, const std::size_t index) {
+    StorePacket(packet.position, &transforms.positions[index]);
+    StorePacket(packet.rotation, &transforms.rotations[index]);
+    StorePacket(packet.scale, &transforms.scales[index]);
+}
+
+// Tail of the separate arrays padded to the whole packet
+struct TransformTail {
+    std::array<math::Vector3, packet_size> positions;
+    std::array<math::Quaternion, packet_size> rotations;
+    std::array<math::Vector3, packet_size> scales;
+
+    explicit TransformTail(const ConstTransformSpan &transforms = {}) {
+        std::ranges::copy(transforms.positions, positions.begin());
+        std::ranges::copy(transforms.rotations, rotations.begin());
+        std::ranges::copy(transforms.scales, scales.begin());
+    }
+
+    [[nodiscard]] ConstTransformSpan Span() const {
+        return ConstTransformSpan{.positions = positions, .rotations = rotations, .scales = scales};
+    }
+
+    [[nodiscard]] TransformSpan Span() {
+        return TransformSpan{.positions = positions, .rotations = rotations, .scales = scales};
+    }
+};
+
+__m128 Dot3(const Packet &lhs, const Packet &rhs) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.x, rhs.x), _mm_mul_ps(lhs.y, rhs.y)), _mm_mul_ps(lhs.z, rhs.z));
+}
+
+Packet Multiply3(const Packet &lhs, const Packet &rhs) {
+    return Packet{
+        .x = _mm_mul_ps(lhs.x, rhs.x),
+        .y = _mm_mul_ps(lhs.y, rhs.y),
+        .z = _mm_mul_ps(lhs.z, rhs.z),
+        .w = _mm_setzero_ps(),
+    };
+}
+
+// Same as `math::Quaternion::Concatenate(lhs, rhs)`, so `rhs` is applied first
+Packet ConcatenateQuaternions(const Packet &lhs, const Packet &rhs) {
+    const __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.w, rhs.x), _mm_mul_ps(lhs.x, rhs.w)),
+                                _mm_sub_ps(_mm_mul_ps(lhs.y, rhs.z), _mm_mul_ps(lhs.z, rhs.y)));
+    const __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.w, rhs.y), _mm_mul_ps(lhs.y, rhs.w)),
+                                _mm_sub_ps(_mm_mul_ps(lhs.z, rhs.x), _mm_mul_ps(lhs.x, rhs.z)));
+    const __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.w, rhs.z), _mm_mul_ps(lhs.z, rhs.w)),
+                                _mm_sub_ps(_mm_mul_ps(lhs.x, rhs.y), _mm_mul_ps(lhs.y, rhs.x)));
+    const __m128 w = _mm_sub_ps(_mm_mul_ps(lhs.w, rhs.w), Dot3(lhs, rhs));
+    return Packet{.x = x, .y = y, .z = z, .w = w};
+}
+
+// Same as `math::Vector3::Transform(vector, rotation)`, which does not require the quaternion to be normalized
+Packet RotateVectors(const Packet &vector, const Packet &rotation) {
+    // q * v * q^-1 = (w^2 - u.u) * v + 2 * (u.v) * u + 2 * w * (u x v)
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 vector_scale = _mm_sub_ps(_mm_mul_ps(rotation.w, rotation.w), Dot3(rotation, rotation));
+    const __m128 axis_scale = _mm_mul_ps(two, Dot3(rotation, vector));
+    const __m128 cross_scale = _mm_mul_ps(two, rotation.w);
+
+    const __m128 cross_x = _mm_sub_ps(_mm_mul_ps(rotation.y, vector.z), _mm_mul_ps(rotation.z, vector.y));
+    const __m128 cross_y = _mm_sub_ps(_mm_mul_ps(rotation.z, vector.x), _mm_mul_ps(rotation.x, vector.z));
+    const __m128 cross_z = _mm_sub_ps(_mm_mul_ps(rotation.x, vector.y), _mm_mul_ps(rotation.y, vector.x));
+
+    auto rotate_axis = [&](const __m128 vector_axis, const __m128 rotation_axis, const __m128 cross_axis) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(vector_scale, vector_axis), _mm_mul_ps(axis_scale, rotation_axis)),
+                          _mm_mul_ps(cross_scale, cross_axis));
+    };
+    return Packet{
+        .x = rotate_axis(vector.x, rotation.x, cross_x),
+        .y = rotate_axis(vector.y, rotation.y, cross_y),
+        .z = rotate_axis(vector.z, rotation.z, cross_z),
+        .w = _mm_setzero_ps(),
+    };
+}
+
+// Zero where the divisor is zero, as in `Transform::Inverse`
+__m128 SafeReciprocal(const __m128 value) {
+    const __m128 non_zero = _mm_cmpneq_ps(value, _mm_setzero_ps());
+    return _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), value), non_zero);
+}
+
+TransformPacket ConcatenatePacket(const TransformPacket &parent, const TransformPacket &child) {
+    Packet position = RotateVectors(Multiply3(parent.scale, child.position), parent.rotation);
+    position.x = _mm_add_ps(position.x, parent.position.x);
+    position.y = _mm_add_ps(position.y, parent.position.y);
+    position.z = _mm_add_ps(position.z, parent.position.z);
+
+    return TransformPacket{
+        .position = position,
+        .rotation = ConcatenateQuaternions(parent.rotation, child.rotation),
+        .scale = Multiply3(parent.scale, child.scale),
+    };
+}
+
+TransformPacket InversePacket(const TransformPacket &transform) {
+    const auto &[position, rotation, scale] = transform;
+
+    // Same as `math::Quaternion::Inverse`, which yields zero for quaternions of near zero length
+    const __m128 length_squared = _mm_add_ps(Dot3(rotation, rotation), _mm_mul_ps(rotation.w, rotation.w));
+    const __m128 is_invertible = _mm_cmpgt_ps(length_squared, _mm_set1_ps(FLT_EPSILON));
+    const __m128 inv_length_squared = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), length_squared), is_invertible);
+    const __m128 negative_inv_length_squared = _mm_sub_ps(_mm_setzero_ps(), inv_length_squared);
+    const Packet inv_rotation{
+        .x = _mm_mul_ps(rotation.x, negative_inv_length_squared),
+        .y = _mm_mul_ps(rotation.y, negative_inv_length_squared),
+        .z = _mm_mul_ps(rotation.z, negative_inv_length_squared),
+        .w = _mm_mul_ps(rotation.w, inv_length_squared),
+    };
+
+    const Packet inv_scale{
+        .x = SafeReciprocal(scale.x),
+        .y = SafeReciprocal(scale.y),
+        .z = SafeReciprocal(scale.z),
+        .w = _mm_setzero_ps(),
+    };
+
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const Packet negative_position{
+        .x = _mm_mul_ps(position.x, minus_one),
+        .y = _mm_mul_ps(position.y, minus_one),
+        .z = _mm_mul_ps(position.z, minus_one),
+        .w = _mm_setzero_ps(),
+    };
+
+    return TransformPacket{
+        .position = RotateVectors(Multiply3(inv_scale, negative_position), inv_rotation),
+        .rotation = inv_rotation,
+        .scale = inv_scale,
+    };
+}
+
+void ToMatrixPacket(const TransformPacket &transform, math::Matrix4x4 *matrices) {
+    const auto &[position, rotation, scale] = transform;
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 xx = _mm_mul_ps(two, _mm_mul_ps(rotation.x, rotation.x));
+    const __m128 yy = _mm_mul_ps(two, _mm_mul_ps(rotation.y, rotation.y));
+    const __m128 zz = _mm_mul_ps(two, _mm_mul_ps(rotation.z, rotation.z));
+    const __m128 xy = _mm_mul_ps(two, _mm_mul_ps(rotation.x, rotation.y));
+    const __m128 xz = _mm_mul_ps(two, _mm_mul_ps(rotation.x, rotation.z));
+    const __m128 yz = _mm_mul_ps(two, _mm_mul_ps(rotation.y, rotation.z));
+    const __m128 xw = _mm_mul_ps(two, _mm_mul_ps(rotation.x, rotation.w));
+    const __m128 yw = _mm_mul_ps(two, _mm_mul_ps(rotation.y, rotation.w));
+    const __m128 zw = _mm_mul_ps(two, _mm_mul_ps(rotation.z, rotation.w));
+
+    // Rows of the rotation matrix scaled by the corresponding axis, then translation as the last row
+    const std::array rows{
+        Packet{
+            .x = _mm_mul_ps(scale.x, _mm_sub_ps(one, _mm_add_ps(yy, zz))),
+            .y = _mm_mul_ps(scale.x, _mm_add_ps(xy, zw)),
+            .z = _mm_mul_ps(scale.x, _mm_sub_ps(xz, yw)),
+            .w = _mm_setzero_ps(),
+        },
+        Packet{
+            .x = _mm_mul_ps(scale.y, _mm_sub_ps(xy, zw)),
+            .y = _mm_mul_ps(scale.y, _mm_sub_ps(one, _mm_add_ps(xx, zz))),
+            .z = _mm_mul_ps(scale.y, _mm_add_ps(yz, xw)),
+            .w = _mm_setzero_ps(),
+        },
+        Packet{
+            .x = _mm_mul_ps(scale.z, _mm_add_ps(xz, yw)),
+            .y = _mm_mul_ps(scale.z, _mm_sub_ps(yz, xw)),
+            .z = _mm_mul_ps(scale.z, _mm_sub_ps(one, _mm_add_ps(xx, yy))),
+            .w = _mm_setzero_ps(),
+        },
+        Packet{.x = position.x, .y = position.y, .z = position.z, .w = one},
+    };
+
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        Packet packet = rows[row];
+        _MM_TRANSPOSE4_PS(packet.x, packet.y, packet.z, packet.w);
+        _mm_storeu_ps(matrices[0].m[row], packet.x);
+        _mm_storeu_ps(matrices[1].m[row], packet.y);
+        _mm_storeu_ps(matrices[2].m[row], packet.z);
+        _mm_storeu_ps(matrices[3].m[row], packet.w);
+    }
+}
+
+#endif
+
+}  // namespace
+
 math::Matrix4x4 Transform::ToMatrix() const {
-    return math::Matrix4x4::CreateScale(scale) * math::Matrix4x4::CreateFromQuaternion(rotation) *
-           math::Matrix4x4::CreateTranslation(position);
+    // Same as scale * rotation * translation matrices, but without multiplying them
+    math::Matrix4x4 matrix = math::Matrix4x4::CreateFromQuaternion(rotation);
+    for (std::size_t column = 0; column < 3; ++column) {
+        matrix.m[0][column] *= scale.x;
+        matrix.m[1][column] *= scale.y;
+        matrix.m[2][column] *= scale.z;
+    }
+    matrix.Translation(position);
+    return matrix;
 }
 
 math::Matrix4x4 Transform::ViewMatrix() const {
@@ -55,6 +353,130 @@ Transform Transform::Inverse(const Transform& transform) {
     return result;
 }
 
+void Transform::ConcatenateBatch(const std::span<const Transform> parents, const std::span<const Transform> children,
+                                 const std::span<Transform> results) {
+    assert(parents.size() == children.size() && children.size() == results.size());
+
+    std::size_t index = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    for (; index + packet_size <= results.size(); index += packet_size) {
+        StoreTransforms(ConcatenatePacket(LoadTransforms(&parents[index]), LoadTransforms(&children[index])),
+                        &results[index]);
+    }
+    if (const std::size_t rest = results.size() - index; rest > 0) {
+        std::array<Transform, packet_size> rest_parents, rest_children, rest_results;
+        std::ranges::copy(parents.subspan(index), rest_parents.begin());
+        std::ranges::copy(children.subspan(index), rest_children.begin());
+        StoreTransforms(ConcatenatePacket(LoadTransforms(rest_parents.data()), LoadTransforms(rest_children.data())),
+                        rest_results.data());
+        std::ranges::copy_n(rest_results.begin(), rest, results.subspan(index).begin());
+    }
+#else
+    for (; index < results.size(); ++index) {
+        Concatenate(parents[index], children[index], results[index]);
+    }
+#endif
+}
+
+void Transform::InverseBatch(const std::span<const Transform> transforms, const std::span<Transform> results) {
+    assert(transforms.size() == results.size());
+
+    std::size_t index = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    for (; index + packet_size <= results.size(); index += packet_size) {
+        StoreTransforms(InversePacket(LoadTransforms(&transforms[index])), &results[index]);
+    }
+    if (const std::size_t rest = results.size() - index; rest > 0) {
+        std::array<Transform, packet_size> rest_transforms, rest_results;
+        std::ranges::copy(transforms.subspan(index), rest_transforms.begin());
+        StoreTransforms(InversePacket(LoadTransforms(rest_transforms.data())), rest_results.data());
+        std::ranges::copy_n(rest_results.begin(), rest, results.subspan(index).begin());
+    }
+#else
+    for (; index < results.size(); ++index) {
+        Inverse(transforms[index], results[index]);
+    }
+#endif
+}
+
+void Transform::ToMatrixBatch(const std::span<const Transform> transforms, const std::span<math::Matrix4x4> matrices) {
+    assert(transforms.size() == matrices.size());
+
+    std::size_t index = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    for (; index + packet_size <= matrices.size(); index += packet_size) {
+        ToMatrixPacket(LoadTransforms(&transforms[index]), &matrices[index]);
+    }
+    if (const std::size_t rest = matrices.size() - index; rest > 0) {
+        std::array<Transform, packet_size> rest_transforms;
+        std::array<math::Matrix4x4, packet_size> rest_matrices;
+        std::ranges::copy(transforms.subspan(index), rest_transforms.begin());
+        ToMatrixPacket(LoadTransforms(rest_transforms.data()), rest_matrices.data());
+        std::ranges::copy_n(rest_matrices.begin(), rest, matrices.subspan(index).begin());
+    }
+#else
+    for (; index < matrices.size(); ++index) {
+        matrices[index] = transforms[index].ToMatrix();
+    }
+#endif
+}
+
+void Transform::ConcatenateBatch(const ConstTransformSpan& parents, const ConstTransformSpan& children,
+                                 const TransformSpan& results) {
+    assert(parents.Size() == children.Size() && children.Size() == results.Size());
+
+    std::size_t index = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    for (; index + packet_size <= results.Size(); index += packet_size) {
+        StoreTransforms(ConcatenatePacket(LoadTransforms(parents, index), LoadTransforms(children, index)), results,
+                        index);
+    }
+    if (const std::size_t rest = results.Size() - index; rest > 0) {
+        const TransformTail rest_parents{parents.Subspan(index, rest)};
+        const TransformTail rest_children{children.Subspan(index, rest)};
+        TransformTail rest_results;
+        const TransformPacket result =
+            ConcatenatePacket(LoadTransforms(rest_parents.Span(), 0), LoadTransforms(rest_children.Span(), 0));
+        StoreTransforms(result, rest_results.Span(), 0);
+        const TransformSpan tail = results.Subspan(index, rest);
+        std::ranges::copy_n(rest_results.positions.begin(), rest, tail.positions.begin());
+        std::ranges::copy_n(rest_results.rotations.begin(), rest, tail.rotations.begin());
+        std::ranges::copy_n(rest_results.scales.begin(), rest, tail.scales.begin());
+    }
+#else
+    for (; index < results.Size(); ++index) {
+        const Transform result = Concatenate(
+            Transform{parents.positions[index], parents.rotations[index], parents.scales[index]},
+            Transform{children.positions[index], children.rotations[index], children.scales[index]});
+        results.positions[index] = result.position;
+        results.rotations[index] = result.rotation;
+        results.scales[index] = result.scale;
+    }
+#endif
+}
+
+void Transform::ToMatrixBatch(const ConstTransformSpan& transforms, const std::span<math::Matrix4x4> matrices) {
+    assert(transforms.Size() == matrices.size());
+
+    std::size_t index = 0;
+#if defined(_XM_SSE_INTRINSICS_)
+    for (; index + packet_size <= matrices.size(); index += packet_size) {
+        ToMatrixPacket(LoadTransforms(transforms, index), &matrices[index]);
+    }
+    if (const std::size_t rest = matrices.size() - index; rest > 0) {
+        const TransformTail rest_transforms{transforms.Subspan(index, rest)};
+        std::array<math::Matrix4x4, packet_size> rest_matrices;
+        ToMatrixPacket(LoadTransforms(rest_transforms.Span(), 0), rest_matrices.data());
+        std::ranges::copy_n(rest_matrices.begin(), rest, matrices.subspan(index).begin());
+    }
+#else
+    for (; index < matrices.size(); ++index) {
+        const Transform transform{transforms.positions[index], transforms.rotations[index], transforms.scales[index]};
+        matrices[index] = transform.ToMatrix();
+    }
+#endif
+}
+
 math::Vector3 Transform::Right() const {
     return math::Vector3::Transform(math::Vector3::Right, rotation);
 }
@@ -71,4 +493,67 @@ void Transform::RotateAround(const math::Vector3& point, const math::Quaternion&
     position = math::RotateAround(position, point, rotate_by);
 }
 
+TransformReference& TransformReference::operator=(const Transform& transform) {
+    position = transform.position;
+    rotation = transform.rotation;
+    scale = transform.scale;
+    return *this;
+}
+
+TransformReference& TransformReference::operator=(const TransformReference& other) {
+    return *this = static_cast<Transform>(other);
+}
+
+TransformReference::operator Transform() const {
+    return Transform{.position = position, .rotation = rotation, .scale = scale};
+}
+
+math::Matrix4x4 TransformReference::ToMatrix() const {
+    return static_cast<Transform>(*this).ToMatrix();
+}
+
+math::Matrix4x4 TransformReference::ViewMatrix() const {
+    return static_cast<Transform>(*this).ViewMatrix();
+}
+
+math::Vector3 TransformReference::Right() const {
+    return math::Vector3::Transform(math::Vector3::Right, rotation);
+}
+
+math::Vector3 TransformReference::Up() const {
+    return math::Vector3::Transform(math::Vector3::Up, rotation);
+}
+
+math::Vector3 TransformReference::Forward() const {
+    return math::Vector3::Transform(math::Vector3::Forward, rotation);
+}
+
+void TransformReference::RotateAround(const math::Vector3& point, const math::Quaternion& rotate_by) {
+    position = math::RotateAround(position, point, rotate_by);
+}
+
+std::size_t TransformSpan::Size() const {
+    return positions.size();
+}
+
+TransformSpan TransformSpan::Subspan(const std::size_t offset, const std::size_t count) const {
+    return TransformSpan{
+        .positions = positions.subspan(offset, count),
+        .rotations = rotations.subspan(offset, count),
+        .scales = scales.subspan(offset, count),
+    };
+}
+
+std::size_t ConstTransformSpan::Size() const {
+    return positions.size();
+}
+
+ConstTransformSpan ConstTransformSpan::Subspan(const std::size_t offset, const std::size_t count) const {
+    return ConstTransformSpan{
+        .positions = positions.subspan(offset, count),
+        .rotations = rotations.subspan(offset, count),
+        .scales = scales.subspan(offset, count),
+    };
+}
+
 }  // namespace borov_engine
@@ -0,0 +1,375 @@
+#include "borov_engine/transform_system.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <span>
+
+#include "borov_engine/thread_pool.hpp"
+
+namespace borov_engine {
+
+TransformSystem::TransformSystem(ThreadPool *thread_pool)
+    : shared_size_{},
+      thread_pool_{thread_pool},
+      mode_{UpdateMode::Sequential},
+      removed_count_{},
+      is_order_dirty_{} {}
+
+auto TransformSystem::Add(const Transform &transform, const Handle parent) -> Handle {
+    const auto index = static_cast<Index>(local_positions_.size());
+
+    Handle handle;
+    if (free_handles_.empty()) {
+        handle = static_cast<Handle>(indices_.size());
+        indices_.push_back(index);
+    } else {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+        indices_[handle] = index;
+    }
+
+    // New entry is placed after every existing one, so its parent always comes first,
+    // but it is not placed next to the other entries of its subtree until the next sort
+    local_positions_.push_back(transform.position);
+    local_rotations_.push_back(transform.rotation);
+    local_scales_.push_back(transform.scale);
+    world_positions_.push_back(transform.position);
+    world_rotations_.push_back(transform.rotation);
+    world_scales_.push_back(transform.scale);
+    world_matrices_.push_back(math::Matrix4x4::Identity);
+    flags_.push_back(world_transform_dirty | world_matrix_dirty);
+    parents_.push_back(parent != invalid_handle ? indices_[parent] : invalid_index);
+    handles_.push_back(handle);
+    is_order_dirty_ = true;
+    return handle;
+}
+
+void TransformSystem::Remove(const Handle handle) {
+    const Index index = indices_[handle];
+    flags_[index] = removed;
+    indices_[handle] = invalid_index;
+    free_handles_.push_back(handle);
+
+    // Removed entries are compacted on the next sort, which is cheaper than fixing up parents of every entry now
+    removed_count_ += 1;
+    is_order_dirty_ = true;
+}
+
+std::size_t TransformSystem::Size() const {
+    return local_positions_.size() - removed_count_;
+}
+
+auto TransformSystem::Mode() const -> const UpdateMode & {
+    return mode_;
+}
+
+auto TransformSystem::Mode() -> UpdateMode & {
+    return mode_;
+}
+
+Transform TransformSystem::LocalTransform(const Handle handle) const {
+    const Index index = indices_[handle];
+    return Transform{
+        .position = local_positions_[index],
+        .rotation = local_rotations_[index],
+        .scale = local_scales_[index],
+    };
+}
+
+TransformReference TransformSystem::LocalTransform(const Handle handle) {
+    const Index index = indices_[handle];
+    return TransformReference{
+        .position = local_positions_[index],
+        .rotation = local_rotations_[index],
+        .scale = local_scales_[index],
+    };
+}
+
+auto TransformSystem::Parent(const Handle handle) const -> Handle {
+    const Index parent = parents_[indices_[handle]];
+    return parent != invalid_index ? handles_[parent] : invalid_handle;
+}
+
+void TransformSystem::Parent(const Handle handle, const Handle parent) {
+    const Index index = indices_[handle];
+    const Index parent_index = parent != invalid_handle ? indices_[parent] : invalid_index;
+    parents_[index] = parent_index;
+    is_order_dirty_ = true;
+}
+
+Transform TransformSystem::WorldTransform(const Handle handle) const {
+    const Index index = indices_[handle];
+    UpdateWorldTransform(index);
+    return Transform{
+        .position = world_positions_[index],
+        .rotation = world_rotations_[index],
+        .scale = world_scales_[index],
+    };
+}
+
+const math::Matrix4x4 &TransformSystem::WorldMatrix(const Handle handle) const {
+    const Index index = indices_[handle];
+    UpdateWorldTransform(index);
+    if (flags_[index] & world_matrix_dirty) {
+        const Transform world_transform{
+            .position = world_positions_[index],
+            .rotation = world_rotations_[index],
+            .scale = world_scales_[index],
+        };
+        world_matrices_[index] = world_transform.ToMatrix();
+        flags_[index] &= ~world_matrix_dirty;
+    }
+    return world_matrices_[index];
+}
+
+bool TransformSystem::IsWorldTransformDirty(const Handle handle) const {
+    return flags_[indices_[handle]] & world_transform_dirty;
+}
+
+void TransformSystem::MarkWorldTransformDirty(const Handle handle) {
+    flags_[indices_[handle]] |= world_transform_dirty | world_matrix_dirty;
+}
+
+void TransformSystem::Update() {
+    if (is_order_dirty_) {
+        SortHierarchy();
+    }
+
+    const bool is_parallel = mode_ == UpdateMode::Parallel && thread_pool_ != nullptr && thread_pool_->WorkerCount() > 0;
+    if (!is_parallel) {
+        UpdateRange(0, static_cast<Index>(local_positions_.size()));
+        return;
+    }
+
+    // Consecutive subtrees form a contiguous range, so every chunk of them is updated at once
+    UpdateRange(0, shared_size_);
+    const std::size_t subtree_count = subtree_offsets_.size() - 1;
+    thread_pool_->ParallelFor(subtree_count, 1, [this](const std::size_t begin, const std::size_t end) {
+        UpdateRange(subtree_offsets_[begin], subtree_offsets_[end]);
+    });
+}
+
+ConstTransformSpan TransformSystem::LocalTransforms() const {
+    return ConstTransformSpan{.positions = local_positions_, .rotations = local_rotations_, .scales = local_scales_};
+}
+
+TransformSpan TransformSystem::WorldTransforms() const {
+    return TransformSpan{.positions = world_positions_, .rotations = world_rotations_, .scales = world_scales_};
+}
+
+void TransformSystem::UpdateWorldTransform(const Index index) const {
+    if (!(flags_[index] & world_transform_dirty)) {
+        return;
+    }
+
+    // Parents of the clean entry are clean too, so only the dirty part of the chain is recomputed
+    std::vector<Index> dirty_chain;
+    for (Index current = index; current != invalid_index && (flags_[current] & world_transform_dirty);
+         current = parents_[current]) {
+        dirty_chain.push_back(current);
+    }
+
+    for (const Index current : dirty_chain | std::views::reverse) {
+        Transform world_transform{
+            .position = local_positions_[current],
+            .rotation = local_rotations_[current],
+            .scale = local_scales_[current],
+        };
+        if (const Index parent = parents_[current]; parent != invalid_index) {
+            const Transform parent_world_transform{
+                .position = world_positions_[parent],
+                .rotation = world_rotations_[parent],
+                .scale = world_scales_[parent],
+            };
+            world_transform = Transform::Concatenate(parent_world_transform, world_transform);
+        }
+        world_positions_[current] = world_transform.position;
+        world_rotations_[current] = world_transform.rotation;
+        world_scales_[current] = world_transform.scale;
+        flags_[current] &= ~world_transform_dirty;
+    }
+}
+
+void TransformSystem::UpdateRange(const Index range_begin, const Index range_end) {
+    const ConstTransformSpan local_transforms = LocalTransforms();
+    const TransformSpan world_transforms = WorldTransforms();
+    const std::span world_matrices{world_matrices_};
+
+    // Scratch buffers of the batched update, kept to avoid allocations every frame
+    thread_local std::vector<math::Vector3> parent_world_positions;
+    thread_local std::vector<math::Quaternion> parent_world_rotations;
+    thread_local std::vector<math::Vector3> parent_world_scales;
+
+    // Parents of every entry in the run come before the run itself, so the whole run could be computed at once
+    for (Index begin = range_begin; begin < range_end;) {
+        Index end = begin;
+        parent_world_positions.clear();
+        parent_world_rotations.clear();
+        parent_world_scales.clear();
+        while (end < range_end && (flags_[end] & world_transform_dirty) &&
+               (parents_[end] == invalid_index || parents_[end] < begin)) {
+            // Concatenation with the identity transform yields exactly the same local transform
+            if (const Index parent = parents_[end]; parent != invalid_index) {
+                parent_world_positions.push_back(world_positions_[parent]);
+                parent_world_rotations.push_back(world_rotations_[parent]);
+                parent_world_scales.push_back(world_scales_[parent]);
+            } else {
+                parent_world_positions.push_back(math::Vector3::Zero);
+                parent_world_rotations.push_back(math::Quaternion::Identity);
+                parent_world_scales.push_back(math::Vector3::One);
+            }
+            end += 1;
+        }
+        if (end == begin) {
+            begin += 1;
+            continue;
+        }
+
+        const std::size_t count = end - begin;
+        const ConstTransformSpan parent_world_transforms{
+            .positions = parent_world_positions,
+            .rotations = parent_world_rotations,
+            .scales = parent_world_scales,
+        };
+        Transform::ConcatenateBatch(parent_world_transforms, local_transforms.Subspan(begin, count),
+                                    world_transforms.Subspan(begin, count));
+        begin = end;
+    }
+
+    for (Index begin = range_begin; begin < range_end;) {
+        Index end = begin;
+        while (end < range_end && (flags_[end] & world_matrix_dirty)) {
+            end += 1;
+        }
+        if (end == begin) {
+            begin += 1;
+            continue;
+        }
+
+        const std::size_t count = end - begin;
+        const ConstTransformSpan world_transform_run{
+            .positions = world_transforms.positions.subspan(begin, count),
+            .rotations = world_transforms.rotations.subspan(begin, count),
+            .scales = world_transforms.scales.subspan(begin, count),
+        };
+        Transform::ToMatrixBatch(world_transform_run, world_matrices.subspan(begin, count));
+        begin = end;
+    }
+
+    for (std::uint8_t &flags : std::span{flags_}.subspan(range_begin, range_end - range_begin)) {
+        flags &= ~(world_transform_dirty | world_matrix_dirty);
+    }
+}
+
+void TransformSystem::SortHierarchy() {
+    const std::size_t size = local_positions_.size();
+
+    constexpr Index unknown_depth = invalid_index;
+    std::vector<Index> depths(size, unknown_depth);
+    std::vector<Index> chain;
+    for (Index index = 0; index < size; ++index) {
+        Index current = index;
+        while (current != invalid_index && depths[current] == unknown_depth) {
+            chain.push_back(current);
+            current = parents_[current];
+        }
+        Index depth = (current != invalid_index) ? depths[current] + 1 : 0;
+        for (const Index chained : chain | std::views::reverse) {
+            depths[chained] = depth;
+            depth += 1;
+        }
+        chain.clear();
+    }
+
+    // Sorting by depth keeps parents before children and groups entries of the same level together
+    std::vector<Index> order;
+    order.reserve(size - removed_count_);
+    for (Index index = 0; index < size; ++index) {
+        if (!(flags_[index] & removed)) {
+            order.push_back(index);
+        }
+    }
+    std::ranges::stable_sort(order, std::ranges::less{}, [&](const Index index) { return depths[index]; });
+
+    // Entries are split into subtrees at the first level which is wide enough to keep every thread busy,
+    // or at the widest one if there is no such level. Without a thread pool every root has its own subtree
+    std::vector<Index> level_sizes;
+    for (const Index index : order) {
+        level_sizes.resize((std::max)(level_sizes.size(), std::size_t{depths[index]} + 1));
+        level_sizes[depths[index]] += 1;
+    }
+    Index split_depth = 0;
+    if (thread_pool_ != nullptr && !level_sizes.empty()) {
+        const std::size_t min_subtree_count = (thread_pool_->WorkerCount() + 1) * 4;
+        const auto wide_level = std::ranges::find_if(level_sizes, [&](const Index level_size) {
+            return level_size >= min_subtree_count;
+        });
+        const auto split_level = (wide_level != level_sizes.end()) ? wide_level : std::ranges::max_element(level_sizes);
+        split_depth = static_cast<Index>(split_level - level_sizes.begin());
+    }
+
+    // Entries are visited level by level, so the subtree of the parent is always known already
+    std::vector<Index> subtrees(size, invalid_index);
+    for (const Index index : order) {
+        if (depths[index] == split_depth) {
+            subtrees[index] = index;
+        } else if (depths[index] > split_depth) {
+            subtrees[index] = subtrees[parents_[index]];
+        }
+    }
+    std::ranges::stable_sort(order, std::ranges::less{}, [&](const Index index) {
+        const bool is_shared = depths[index] < split_depth;
+        return is_shared ? std::pair{false, depths[index]} : std::pair{true, subtrees[index]};
+    });
+
+    std::vector<Index> new_indices(size, invalid_index);
+    for (Index new_index = 0; const Index old_index : order) {
+        new_indices[old_index] = new_index;
+        new_index += 1;
+    }
+
+    shared_size_ = 0;
+    subtree_offsets_.clear();
+    for (Index new_index = 0; const Index old_index : order) {
+        if (depths[old_index] < split_depth) {
+            shared_size_ += 1;
+        } else if (depths[old_index] == split_depth) {
+            subtree_offsets_.push_back(new_index);
+        }
+        new_index += 1;
+    }
+    subtree_offsets_.push_back(static_cast<Index>(order.size()));
+
+    auto permute = [&order](auto &values) {
+        std::remove_reference_t<decltype(values)> permuted;
+        permuted.reserve(order.size());
+        for (const Index old_index : order) {
+            permuted.push_back(values[old_index]);
+        }
+        values = std::move(permuted);
+    };
+    permute(local_positions_);
+    permute(local_rotations_);
+    permute(local_scales_);
+    permute(world_positions_);
+    permute(world_rotations_);
+    permute(world_scales_);
+    permute(world_matrices_);
+    permute(flags_);
+    permute(parents_);
+    permute(handles_);
+
+    for (Index &parent : parents_) {
+        if (parent != invalid_index) {
+            parent = new_indices[parent];
+        }
+    }
+    for (Index index = 0; index < handles_.size(); ++index) {
+        indices_[handles_[index]] = index;
+    }
+
+    removed_count_ = 0;
+    is_order_dirty_ = false;
+}
+
+}  // namespace borov_engine
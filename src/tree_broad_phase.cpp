@@ -0,0 +1,44 @@
+#include "borov_engine/tree_broad_phase.hpp"
+
+namespace borov_engine {
+
+TreeBroadPhase::TreeBroadPhase(const float margin) : tree_{margin} {}
+
+auto TreeBroadPhase::Add(const math::AxisAlignedBox &bounds) -> ProxyId {
+    return tree_.Add(bounds);
+}
+
+void TreeBroadPhase::Move(const ProxyId proxy, const math::AxisAlignedBox &bounds) {
+    tree_.Move(proxy, bounds);
+}
+
+std::size_t TreeBroadPhase::Size() const {
+    return tree_.Size();
+}
+
+void TreeBroadPhase::Query(const math::AxisAlignedBox &region, const QueryFunction &function) const {
+    tree_.Query(region, function);
+}
+
+void TreeBroadPhase::Query(const math::Ray &ray, const float max_distance, const QueryFunction &function) const {
+    tree_.Query(ray, max_distance, function);
+}
+
+void TreeBroadPhase::Query(const RayPacket &rays, const float max_distance,
+                           const PacketQueryFunction &function) const {
+    tree_.Query(rays, max_distance, function);
+}
+
+const DynamicAabbTree &TreeBroadPhase::Tree() const {
+    return tree_;
+}
+
+void TreeBroadPhase::RemoveProxy(const ProxyId proxy) {
+    tree_.Remove(proxy);
+}
+
+void TreeBroadPhase::FindPairs(std::vector<ProxyPair> &pairs) {
+    tree_.Pairs(pairs);
+}
+
+}  // namespace borov_engine
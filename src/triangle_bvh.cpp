@@ -0,0 +1,491 @@
+#include "borov_engine/triangle_bvh.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "borov_engine/ray_packet.hpp"
+
+namespace borov_engine {
+
+namespace {
+
+constexpr std::size_t bin_count = 16;
+constexpr std::size_t width = TrianglePackets::width;
+constexpr float infinity = std::numeric_limits<float>::infinity();
+
+float Component(const math::Vector3 &vector, const std::size_t axis) {
+    return (&vector.x)[axis];
+}
+
+float SurfaceArea(const math::Vector3 &min, const math::Vector3 &max) {
+    const math::Vector3 size = max - min;
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+float Volume(const math::AxisAlignedBox &box) {
+    return box.Extents.x * box.Extents.y * box.Extents.z;
+}
+
+math::AxisAlignedBox BoxFromMinMax(const math::Vector3 &min, const math::Vector3 &max) {
+    return math::AxisAlignedBox{(min + max) * 0.5f, (max - min) * 0.5f};
+}
+
+// Slab test, infinite components of the inverse direction are handled by ignoring NaNs in min and max
+bool RayIntersectsBounds(const math::Vector3 &origin, const math::Vector3 &inverse_direction,
+                         const math::AxisAlignedBox &bounds, const float max_distance, float &entry) {
+    const math::Vector3 center{bounds.Center};
+    const math::Vector3 extents{bounds.Extents};
+    const math::Vector3 near_planes = (center - extents - origin) * inverse_direction;
+    const math::Vector3 far_planes = (center + extents - origin) * inverse_direction;
+    const math::Vector3 entries = math::Vector3::Min(near_planes, far_planes);
+    const math::Vector3 exits = math::Vector3::Max(near_planes, far_planes);
+    entry = (std::max)({entries.x, entries.y, entries.z, 0.0f});
+    const float exit = (std::min)({exits.x, exits.y, exits.z, max_distance});
+    return entry <= exit;
+}
+
+math::Vector3 InverseDirection(const math::Ray &ray) {
+    return math::Vector3{1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+}
+
+}  // namespace
+
+struct TriangleBvh::Primitive {
+    math::Vector3 min;
+    math::Vector3 max;
+    math::Vector3 centroid;
+    Index index;
+};
+
+TriangleBvh::TriangleBvh(const std::span<const math::Vector3> vertices, const std::span<const Index> indices) {
+    const std::size_t triangle_count = indices.size() / 3;
+    std::vector<Primitive> primitives;
+    primitives.reserve(triangle_count);
+    for (Index triangle = 0; triangle < triangle_count; ++triangle) {
+        const math::Vector3 &point0 = vertices[indices[triangle * 3 + 0]];
+        const math::Vector3 &point1 = vertices[indices[triangle * 3 + 1]];
+        const math::Vector3 &point2 = vertices[indices[triangle * 3 + 2]];
+        const math::Vector3 min = math::Vector3::Min(point0, math::Vector3::Min(point1, point2));
+        const math::Vector3 max = math::Vector3::Max(point0, math::Vector3::Max(point1, point2));
+        primitives.push_back(Primitive{.min = min, .max = max, .centroid = (min + max) * 0.5f, .index = triangle});
+    }
+
+    triangles_.reserve(triangle_count);
+    triangle_indices_.reserve(triangle_count);
+    nodes_.reserve(triangle_count * 2);
+    if (!primitives.empty()) {
+        Build(primitives, 0);
+    }
+
+    packets_ = TrianglePackets{triangle_indices_.size()};
+    for (std::size_t i = 0; i < triangle_indices_.size(); ++i) {
+        const Index triangle = triangle_indices_[i];
+        if (triangle == empty_triangle) {
+            triangles_.emplace_back();
+            continue;
+        }
+        triangles_.push_back(math::Triangle{
+            .point0 = vertices[indices[triangle * 3 + 0]],
+            .point1 = vertices[indices[triangle * 3 + 1]],
+            .point2 = vertices[indices[triangle * 3 + 2]],
+        });
+        packets_.Triangle(static_cast<Index>(i), triangles_.back());
+    }
+}
+
+void TriangleBvh::Refit(const std::span<const math::Vector3> vertices, const std::span<const Index> indices) {
+    for (std::size_t i = 0; i < triangles_.size(); ++i) {
+        const Index triangle = triangle_indices_[i];
+        if (triangle == empty_triangle) {
+            continue;
+        }
+        assert(triangle < indices.size() / 3 && "Hierarchy was built for other indices");
+        triangles_[i] = math::Triangle{
+            .point0 = vertices[indices[triangle * 3 + 0]],
+            .point1 = vertices[indices[triangle * 3 + 1]],
+            .point2 = vertices[indices[triangle * 3 + 2]],
+        };
+        packets_.Triangle(static_cast<Index>(i), triangles_[i]);
+    }
+
+    // Children always follow their parent, so going backwards fits both children before the parent
+    for (std::size_t index = nodes_.size(); index-- > 0;) {
+        Node &node = nodes_[index];
+        math::Vector3 min{infinity}, max{-infinity};
+        if (node.count > 0) {
+            for (const math::Triangle &triangle : std::span{triangles_}.subspan(node.offset, node.count)) {
+                for (const math::Vector3 &point : {triangle.point0, triangle.point1, triangle.point2}) {
+                    min = math::Vector3::Min(min, point);
+                    max = math::Vector3::Max(max, point);
+                }
+            }
+        } else {
+            for (const Index child : {static_cast<Index>(index + 1), node.offset}) {
+                const math::Vector3 center{nodes_[child].bounds.Center};
+                const math::Vector3 extents{nodes_[child].bounds.Extents};
+                min = math::Vector3::Min(min, center - extents);
+                max = math::Vector3::Max(max, center + extents);
+            }
+        }
+        node.bounds = BoxFromMinMax(min, max);
+    }
+}
+
+auto TriangleBvh::Nodes() const -> std::span<const Node> {
+    return nodes_;
+}
+
+std::span<const math::Triangle> TriangleBvh::Triangles() const {
+    return triangles_;
+}
+
+auto TriangleBvh::TriangleIndices() const -> std::span<const Index> {
+    return triangle_indices_;
+}
+
+const TrianglePackets &TriangleBvh::Packets() const {
+    return packets_;
+}
+
+bool TriangleBvh::ClosestPoint(const math::Vector3 &point, PointHit &hit, const float max_distance) const {
+    const auto bound = [&](const math::AxisAlignedBox &bounds) {
+        return math::Vector3::Distance(point, math::ClosestPoint(bounds, point));
+    };
+
+    // Hit is written by every nearer triangle, so it holds the nearest one when the search stops
+    float nearest_distance = max_distance;
+    const auto distance = [&](const math::Triangle &triangle) {
+        const math::Vector3 closest = triangle.ClosestPoint(point);
+        const float closest_distance = math::Vector3::Distance(point, closest);
+        if (closest_distance < nearest_distance) {
+            const auto index = static_cast<std::size_t>(&triangle - triangles_.data());
+            hit = PointHit{.point = closest, .distance = closest_distance, .triangle = triangle_indices_[index]};
+            nearest_distance = closest_distance;
+        }
+        return closest_distance;
+    };
+    return MinOf(bound, distance, max_distance) < max_distance;
+}
+
+bool TriangleBvh::ClosestHit(const math::Ray &ray, RayHit &hit, const float max_distance) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    const math::Vector3 inverse_direction = InverseDirection(ray);
+    float nearest_distance = max_distance;
+    bool is_hit = false;
+    TrianglePackets::Lanes distances, us, vs;
+
+    // Nodes are stored with their entry distances, so the ones behind the nearest hit are skipped without a test
+    std::array<std::pair<Index, float>, max_depth + 2> stack;
+    std::size_t stack_size = 0;
+    if (float entry; RayIntersectsBounds(ray.position, inverse_direction, nodes_[0].bounds, nearest_distance, entry)) {
+        stack[stack_size++] = {0, entry};
+    }
+    while (stack_size > 0) {
+        const auto [node_index, node_entry] = stack[--stack_size];
+        if (node_entry > nearest_distance) {
+            continue;
+        }
+
+        const Node &node = nodes_[node_index];
+        if (node.count > 0) {
+            for (std::size_t first = node.offset; first < node.offset + node.count; first += width) {
+                TrianglePackets::Mask lanes = TrianglePackets::Intersects(packets_.Packets()[first / width], ray,
+                                                                          nearest_distance, distances, us, vs);
+                for (; lanes != 0; lanes &= lanes - 1) {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                    // Every lane was tested against the same distance, so the earlier lanes could have got closer hits
+                    if (distances[lane] <= nearest_distance) {
+                        nearest_distance = distances[lane];
+                        hit = RayHit{
+                            .distance = distances[lane],
+                            .triangle = triangle_indices_[first + lane],
+                            .u = us[lane],
+                            .v = vs[lane],
+                        };
+                        is_hit = true;
+                    }
+                }
+            }
+            continue;
+        }
+
+        const Index first = node_index + 1;
+        const Index second = node.offset;
+        float first_entry, second_entry;
+        const bool is_first_hit =
+            RayIntersectsBounds(ray.position, inverse_direction, nodes_[first].bounds, nearest_distance, first_entry);
+        const bool is_second_hit =
+            RayIntersectsBounds(ray.position, inverse_direction, nodes_[second].bounds, nearest_distance, second_entry);
+
+        // Nearer child is pushed last, so it is visited first
+        if (is_first_hit && is_second_hit) {
+            if (first_entry <= second_entry) {
+                stack[stack_size++] = {second, second_entry};
+                stack[stack_size++] = {first, first_entry};
+            } else {
+                stack[stack_size++] = {first, first_entry};
+                stack[stack_size++] = {second, second_entry};
+            }
+        } else if (is_first_hit) {
+            stack[stack_size++] = {first, first_entry};
+        } else if (is_second_hit) {
+            stack[stack_size++] = {second, second_entry};
+        }
+    }
+    return is_hit;
+}
+
+std::uint32_t TriangleBvh::ClosestHits(const RayPacket &rays, const std::span<RayHit> hits) const {
+    assert(hits.size() >= rays.Size() && "Every ray of the packet must have its hit");
+    if (nodes_.empty()) {
+        return 0;
+    }
+
+    RayPacket::Lanes nearest_distances{};
+    for (std::size_t lane = 0; lane < rays.Size(); ++lane) {
+        nearest_distances[lane] = hits[lane].distance;
+    }
+    const math::Vector3 direction = rays.Ray(0).direction;
+    RayPacket::Mask hit_lanes = 0;
+
+    // Node is visited if any lane hits it, children are ordered along the direction of the first ray
+    RayPacket::Lanes entries, distances, us, vs;
+    std::array<Index, max_depth + 2> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const Index node_index = stack[--stack_size];
+        const Node &node = nodes_[node_index];
+        if (rays.Intersects(node.bounds, nearest_distances, entries) == 0) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (Index triangle = node.offset; triangle < node.offset + node.count; ++triangle) {
+                RayPacket::Mask lanes = rays.Intersects(triangles_[triangle], nearest_distances, distances, us, vs);
+                hit_lanes |= lanes;
+                for (; lanes != 0; lanes &= lanes - 1) {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                    nearest_distances[lane] = distances[lane];
+                    hits[lane] = RayHit{
+                        .distance = distances[lane],
+                        .triangle = triangle_indices_[triangle],
+                        .u = us[lane],
+                        .v = vs[lane],
+                    };
+                }
+            }
+            continue;
+        }
+
+        const Index first = node_index + 1;
+        const Index second = node.offset;
+        const math::Vector3 first_center{nodes_[first].bounds.Center};
+        const math::Vector3 second_center{nodes_[second].bounds.Center};
+        if (direction.Dot(first_center) <= direction.Dot(second_center)) {
+            stack[stack_size++] = second;
+            stack[stack_size++] = first;
+        } else {
+            stack[stack_size++] = first;
+            stack[stack_size++] = second;
+        }
+    }
+    return hit_lanes;
+}
+
+bool TriangleBvh::AnyHit(const math::Ray &ray, const float max_distance) const {
+    const math::Vector3 inverse_direction = InverseDirection(ray);
+    TrianglePackets::Lanes distances, us, vs;
+    return AnyPacketOf(
+        [&](const math::AxisAlignedBox &bounds) {
+            float entry;
+            return RayIntersectsBounds(ray.position, inverse_direction, bounds, max_distance, entry);
+        },
+        [&](const TrianglePackets::Packet &packet, std::span<const math::Triangle>) {
+            return TrianglePackets::Intersects(packet, ray, max_distance, distances, us, vs);
+        });
+}
+
+bool TriangleBvh::Intersects(const math::Ray &ray, float &dist) const {
+    RayHit hit;
+    if (!ClosestHit(ray, hit)) {
+        return false;
+    }
+    dist = hit.distance;
+    return true;
+}
+
+bool TriangleBvh::Intersects(const TriangleBvh &other) const {
+    if (nodes_.empty() || other.nodes_.empty()) {
+        return false;
+    }
+
+    // Every step descends into one of the hierarchies, so the stack is bounded by the sum of their depths
+    std::array<std::pair<Index, Index>, max_depth * 2 + 2> stack;
+    std::size_t stack_size = 0;
+    stack[stack_size++] = {0, 0};
+    while (stack_size > 0) {
+        const auto [index, other_index] = stack[--stack_size];
+        const Node &node = nodes_[index];
+        const Node &other_node = other.nodes_[other_index];
+        if (!node.bounds.Intersects(other_node.bounds)) {
+            continue;
+        }
+
+        const bool is_leaf = node.count > 0;
+        const bool is_other_leaf = other_node.count > 0;
+        if (is_leaf && is_other_leaf) {
+            const std::size_t other_end = other_node.offset + other_node.count;
+            for (const math::Triangle &triangle : std::span{triangles_}.subspan(node.offset, node.count)) {
+                if (!triangle.Intersects(other_node.bounds)) {
+                    continue;
+                }
+
+                // Only the other triangles whose planes cross this one could intersect it
+                const std::array corners{triangle.point0, triangle.point1, triangle.point2};
+                for (std::size_t first = other_node.offset; first < other_end; first += width) {
+                    TrianglePackets::Mask lanes = TrianglePackets::NearPlanes(other.packets_.Packets()[first / width],
+                                                                              corners);
+                    for (; lanes != 0; lanes &= lanes - 1) {
+                        const auto lane = static_cast<std::size_t>(std::countr_zero(lanes));
+                        if (triangle.Intersects(other.triangles_[first + lane])) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            continue;
+        }
+
+        // Larger node is split first, so both hierarchies are descended at roughly the same scale
+        if (is_other_leaf || (!is_leaf && Volume(node.bounds) >= Volume(other_node.bounds))) {
+            stack[stack_size++] = {node.offset, other_index};
+            stack[stack_size++] = {index + 1, other_index};
+        } else {
+            stack[stack_size++] = {index, other_node.offset};
+            stack[stack_size++] = {index, other_index + 1};
+        }
+    }
+    return false;
+}
+
+auto TriangleBvh::Build(const std::span<Primitive> primitives, const std::size_t depth) -> Index {
+    const auto node_index = static_cast<Index>(nodes_.size());
+    nodes_.emplace_back();
+
+    math::Vector3 min{infinity}, max{-infinity};
+    math::Vector3 centroid_min{infinity}, centroid_max{-infinity};
+    for (const Primitive &primitive : primitives) {
+        min = math::Vector3::Min(min, primitive.min);
+        max = math::Vector3::Max(max, primitive.max);
+        centroid_min = math::Vector3::Min(centroid_min, primitive.centroid);
+        centroid_max = math::Vector3::Max(centroid_max, primitive.centroid);
+    }
+    nodes_[node_index].bounds = BoxFromMinMax(min, max);
+
+    auto make_leaf = [&] {
+        nodes_[node_index].offset = static_cast<Index>(triangle_indices_.size());
+        nodes_[node_index].count = static_cast<Index>(primitives.size());
+        for (const Primitive &primitive : primitives) {
+            triangle_indices_.push_back(primitive.index);
+        }
+        // Next leaf starts a new packet
+        while (triangle_indices_.size() % width != 0) {
+            triangle_indices_.push_back(empty_triangle);
+        }
+        return node_index;
+    };
+    // Splitting a single packet could only add traversal, which costs more than testing the empty lanes
+    if (primitives.size() <= max_leaf_size || depth >= max_depth) {
+        return make_leaf();
+    }
+
+    const math::Vector3 centroid_extent = centroid_max - centroid_min;
+    std::size_t axis = 0;
+    if (centroid_extent.y > Component(centroid_extent, axis)) {
+        axis = 1;
+    }
+    if (centroid_extent.z > Component(centroid_extent, axis)) {
+        axis = 2;
+    }
+    const float axis_min = Component(centroid_min, axis);
+    const float axis_extent = Component(centroid_extent, axis);
+
+    std::span<Primitive>::iterator middle;
+    if (axis_extent > 0.0f) {
+        struct Bin {
+            math::Vector3 min{infinity};
+            math::Vector3 max{-infinity};
+            std::size_t count = 0;
+        };
+        std::array<Bin, bin_count> bins{};
+        const float bin_scale = bin_count / axis_extent;
+        auto bin_of = [&](const Primitive &primitive) {
+            const auto bin = static_cast<std::size_t>((Component(primitive.centroid, axis) - axis_min) * bin_scale);
+            return (std::min)(bin, bin_count - 1);
+        };
+        for (const Primitive &primitive : primitives) {
+            Bin &bin = bins[bin_of(primitive)];
+            bin.min = math::Vector3::Min(bin.min, primitive.min);
+            bin.max = math::Vector3::Max(bin.max, primitive.max);
+            bin.count += 1;
+        }
+
+        // Cost of the split after every bin, accumulated from the right side first
+        std::array<float, bin_count - 1> right_costs{};
+        Bin right{};
+        for (std::size_t split = bin_count - 1; split > 0; --split) {
+            right.min = math::Vector3::Min(right.min, bins[split].min);
+            right.max = math::Vector3::Max(right.max, bins[split].max);
+            right.count += bins[split].count;
+            right_costs[split - 1] = right.count > 0 ? SurfaceArea(right.min, right.max) * right.count : 0.0f;
+        }
+
+        float best_cost = infinity;
+        std::size_t best_split = 0;
+        Bin left{};
+        for (std::size_t split = 0; split + 1 < bin_count; ++split) {
+            left.min = math::Vector3::Min(left.min, bins[split].min);
+            left.max = math::Vector3::Max(left.max, bins[split].max);
+            left.count += bins[split].count;
+            if (left.count == 0 || left.count == primitives.size()) {
+                continue;
+            }
+            const float cost = SurfaceArea(left.min, left.max) * left.count + right_costs[split];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_split = split;
+            }
+        }
+
+        middle = std::partition(primitives.begin(), primitives.end(),
+                                [&](const Primitive &primitive) { return bin_of(primitive) <= best_split; });
+    } else {
+        middle = primitives.end();
+    }
+
+    // Coincident centroids could not be separated by bins, so such primitives are split in halves
+    if (middle == primitives.begin() || middle == primitives.end()) {
+        middle = primitives.begin() + static_cast<std::ptrdiff_t>(primitives.size() / 2);
+        std::ranges::nth_element(primitives, middle, std::ranges::less{}, [axis](const Primitive &primitive) {
+            return Component(primitive.centroid, axis);
+        });
+    }
+
+    const auto left_size = static_cast<std::size_t>(middle - primitives.begin());
+    Build(primitives.first(left_size), depth + 1);
+    const Index right = Build(primitives.subspan(left_size), depth + 1);
+    nodes_[node_index].offset = right;
+    nodes_[node_index].count = 0;
+    return node_index;
+}
+
+}  // namespace borov_engine
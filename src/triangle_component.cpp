@@ -94,7 +94,7 @@ void TriangleComponent::DrawInShadowMap(const Camera *camera) {
     device_context.VSSetShader(shadow_map_vertex_shader_.Get(), vs_class_instances.data(), vs_class_instances.size());
 
     const VertexShaderConstantBuffer vs_constant_buffer{
-        .world = WorldTransform().ToMatrix(),
+        .world = WorldMatrix(),
         .view = (camera != nullptr) ? camera->ViewMatrix() : math::Matrix4x4::Identity,
         .projection = (camera != nullptr) ? camera->ProjectionMatrix() : math::Matrix4x4::Identity,
         .tile_count = tile_count_,
@@ -138,7 +138,7 @@ void TriangleComponent::Draw(const Camera *camera) {
     device_context.VSSetShader(vertex_shader_.Get(), vs_class_instances.data(), vs_class_instances.size());
 
     const VertexShaderConstantBuffer vs_constant_buffer{
-        .world = WorldTransform().ToMatrix(),
+        .world = WorldMatrix(),
         .view = (camera != nullptr) ? camera->ViewMatrix() : math::Matrix4x4::Identity,
         .projection = (camera != nullptr) ? camera->ProjectionMatrix() : math::Matrix4x4::Identity,
         .tile_count = tile_count_,
@@ -0,0 +1,204 @@
+#include "borov_engine/triangle_packets.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace borov_engine {
+
+namespace {
+
+constexpr std::size_t width = TrianglePackets::width;
+constexpr float infinity = std::numeric_limits<float>::infinity();
+
+using Mask = TrianglePackets::Mask;
+
+// Lanes are tested into the array first, so the tests themselves stay free of branches
+Mask MaskOf(const std::array<bool, width> &lanes) {
+    Mask mask = 0;
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        mask |= static_cast<Mask>(lanes[lane]) << lane;
+    }
+    return mask;
+}
+
+// Squared distance from the point to the segment, given relatively to the start of the segment
+float SegmentDistanceSquared(const float p_x, const float p_y, const float p_z, const float d_x, const float d_y,
+                             const float d_z) {
+    // Degenerate segment gets NaN, which is clamped to its end
+    const float t = (p_x * d_x + p_y * d_y + p_z * d_z) / (d_x * d_x + d_y * d_y + d_z * d_z);
+    const float clamped_t = (std::max)(0.0f, (std::min)(1.0f, t));
+    const float x = p_x - d_x * clamped_t;
+    const float y = p_y - d_y * clamped_t;
+    const float z = p_z - d_z * clamped_t;
+    return x * x + y * y + z * z;
+}
+
+}  // namespace
+
+TrianglePackets::TrianglePackets(const std::size_t size) : packets_((size + width - 1) / width), size_{size} {
+    for (Packet &packet : packets_) {
+        packet = Packet{};
+        packet.plane_distance.fill(infinity);
+    }
+}
+
+auto TrianglePackets::Packets() const -> std::span<const Packet> {
+    return packets_;
+}
+
+std::size_t TrianglePackets::Size() const {
+    return size_;
+}
+
+math::Triangle TrianglePackets::Triangle(const Index triangle) const {
+    const Packet &packet = packets_[triangle / width];
+    const std::size_t lane = triangle % width;
+    const math::Vector3 point0{packet.point0[0][lane], packet.point0[1][lane], packet.point0[2][lane]};
+    const math::Vector3 edge1{packet.edge1[0][lane], packet.edge1[1][lane], packet.edge1[2][lane]};
+    const math::Vector3 edge2{packet.edge2[0][lane], packet.edge2[1][lane], packet.edge2[2][lane]};
+    return math::Triangle{.point0 = point0, .point1 = point0 + edge1, .point2 = point0 + edge2};
+}
+
+void TrianglePackets::Triangle(const Index triangle, const math::Triangle &value) {
+    const math::Vector3 &point0 = value.point0;
+    const math::Vector3 edge1 = value.point1 - point0;
+    const math::Vector3 edge2 = value.point2 - point0;
+    math::Vector3 normal = edge1.Cross(edge2);
+    normal.Normalize();
+
+    Packet &packet = packets_[triangle / width];
+    const std::size_t lane = triangle % width;
+    packet.point0[0][lane] = point0.x;
+    packet.point0[1][lane] = point0.y;
+    packet.point0[2][lane] = point0.z;
+    packet.edge1[0][lane] = edge1.x;
+    packet.edge1[1][lane] = edge1.y;
+    packet.edge1[2][lane] = edge1.z;
+    packet.edge2[0][lane] = edge2.x;
+    packet.edge2[1][lane] = edge2.y;
+    packet.edge2[2][lane] = edge2.z;
+    packet.normal[0][lane] = normal.x;
+    packet.normal[1][lane] = normal.y;
+    packet.normal[2][lane] = normal.z;
+    packet.plane_distance[lane] = -normal.Dot(point0);
+}
+
+auto TrianglePackets::Intersects(const Packet &packet, const math::Ray &ray, const float max_distance,
+                                 Lanes &distances, Lanes &us, Lanes &vs) -> Mask {
+    const math::Vector3 &origin = ray.position;
+    const math::Vector3 &direction = ray.direction;
+    std::array<bool, width> is_hit;
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        const float edge1_x = packet.edge1[0][lane];
+        const float edge1_y = packet.edge1[1][lane];
+        const float edge1_z = packet.edge1[2][lane];
+        const float edge2_x = packet.edge2[0][lane];
+        const float edge2_y = packet.edge2[1][lane];
+        const float edge2_z = packet.edge2[2][lane];
+
+        const float p_x = direction.y * edge2_z - direction.z * edge2_y;
+        const float p_y = direction.z * edge2_x - direction.x * edge2_z;
+        const float p_z = direction.x * edge2_y - direction.y * edge2_x;
+        const float determinant = edge1_x * p_x + edge1_y * p_y + edge1_z * p_z;
+        const float inverse_determinant = 1.0f / determinant;
+
+        const float t_x = origin.x - packet.point0[0][lane];
+        const float t_y = origin.y - packet.point0[1][lane];
+        const float t_z = origin.z - packet.point0[2][lane];
+        const float u = (t_x * p_x + t_y * p_y + t_z * p_z) * inverse_determinant;
+
+        const float q_x = t_y * edge1_z - t_z * edge1_y;
+        const float q_y = t_z * edge1_x - t_x * edge1_z;
+        const float q_z = t_x * edge1_y - t_y * edge1_x;
+        const float v = (direction.x * q_x + direction.y * q_y + direction.z * q_z) * inverse_determinant;
+        const float distance = (edge2_x * q_x + edge2_y * q_y + edge2_z * q_z) * inverse_determinant;
+
+        // Only parallel rays and degenerate triangles are rejected, any fixed cutoff would miss small triangles
+        is_hit[lane] = std::isfinite(inverse_determinant) && u >= 0.0f && v >= 0.0f && u + v <= 1.0f &&
+                       distance >= 0.0f && distance <= max_distance;
+        distances[lane] = is_hit[lane] ? distance : infinity;
+        us[lane] = u;
+        vs[lane] = v;
+    }
+    return MaskOf(is_hit);
+}
+
+auto TrianglePackets::Intersects(const Packet &packet, const math::Sphere &sphere) -> Mask {
+    const math::Vector3 center{sphere.Center};
+    const float radius_squared = sphere.Radius * sphere.Radius;
+    std::array<bool, width> is_hit;
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        const float plane_distance = packet.normal[0][lane] * center.x + packet.normal[1][lane] * center.y +
+                                     packet.normal[2][lane] * center.z + packet.plane_distance[lane];
+
+        const float edge1_x = packet.edge1[0][lane];
+        const float edge1_y = packet.edge1[1][lane];
+        const float edge1_z = packet.edge1[2][lane];
+        const float edge2_x = packet.edge2[0][lane];
+        const float edge2_y = packet.edge2[1][lane];
+        const float edge2_z = packet.edge2[2][lane];
+        const float p_x = center.x - packet.point0[0][lane];
+        const float p_y = center.y - packet.point0[1][lane];
+        const float p_z = center.z - packet.point0[2][lane];
+
+        // Center projects inside the triangle if both of its barycentric weights and their sum are within [0, 1]
+        const float d00 = edge1_x * edge1_x + edge1_y * edge1_y + edge1_z * edge1_z;
+        const float d01 = edge1_x * edge2_x + edge1_y * edge2_y + edge1_z * edge2_z;
+        const float d11 = edge2_x * edge2_x + edge2_y * edge2_y + edge2_z * edge2_z;
+        const float d20 = p_x * edge1_x + p_y * edge1_y + p_z * edge1_z;
+        const float d21 = p_x * edge2_x + p_y * edge2_y + p_z * edge2_z;
+        const float inverse_denominator = 1.0f / (d00 * d11 - d01 * d01);
+        const float v = (d11 * d20 - d01 * d21) * inverse_denominator;
+        const float w = (d00 * d21 - d01 * d20) * inverse_denominator;
+        const bool is_inside = v >= 0.0f && w >= 0.0f && v + w <= 1.0f;
+
+        // Otherwise the nearest point lies on one of the edges
+        const float edge0_distance = SegmentDistanceSquared(p_x, p_y, p_z, edge1_x, edge1_y, edge1_z);
+        const float edge1_distance = SegmentDistanceSquared(p_x, p_y, p_z, edge2_x, edge2_y, edge2_z);
+        const float edge2_distance = SegmentDistanceSquared(p_x - edge1_x, p_y - edge1_y, p_z - edge1_z,
+                                                            edge2_x - edge1_x, edge2_y - edge1_y, edge2_z - edge1_z);
+        const float inside_distance = is_inside ? plane_distance * plane_distance : infinity;
+        const float distance = (std::min)({inside_distance, edge0_distance, edge1_distance, edge2_distance});
+
+        // Infinite plane distance of the empty lanes rejects them before their edges are considered
+        is_hit[lane] = std::abs(plane_distance) <= sphere.Radius && distance <= radius_squared;
+    }
+    return MaskOf(is_hit);
+}
+
+auto TrianglePackets::Intersects(const Packet &packet, const math::Plane &plane) -> Mask {
+    const math::Vector3 normal = plane.Normal();
+    std::array<bool, width> is_hit;
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        const float distance0 = normal.x * packet.point0[0][lane] + normal.y * packet.point0[1][lane] +
+                                normal.z * packet.point0[2][lane] + plane.D();
+        const float distance1 = distance0 + normal.x * packet.edge1[0][lane] + normal.y * packet.edge1[1][lane] +
+                                normal.z * packet.edge1[2][lane];
+        const float distance2 = distance0 + normal.x * packet.edge2[0][lane] + normal.y * packet.edge2[1][lane] +
+                                normal.z * packet.edge2[2][lane];
+
+        // Vertices of the empty lanes are all at the origin, so they are told apart by their planes only
+        const bool is_empty = packet.plane_distance[lane] == infinity;
+        is_hit[lane] = !is_empty && (std::min)({distance0, distance1, distance2}) <= 0.0f;
+    }
+    return MaskOf(is_hit);
+}
+
+auto TrianglePackets::NearPlanes(const Packet &packet, const std::span<const math::Vector3> corners) -> Mask {
+    std::array<bool, width> is_near;
+    for (std::size_t lane = 0; lane < width; ++lane) {
+        float min_distance = infinity;
+        float max_distance = -infinity;
+        for (const math::Vector3 &corner : corners) {
+            const float distance = packet.normal[0][lane] * corner.x + packet.normal[1][lane] * corner.y +
+                                   packet.normal[2][lane] * corner.z + packet.plane_distance[lane];
+            min_distance = (std::min)(min_distance, distance);
+            max_distance = (std::max)(max_distance, distance);
+        }
+        is_near[lane] = min_distance <= 0.0f && max_distance >= 0.0f;
+    }
+    return MaskOf(is_near);
+}
+
+}  // namespace borov_engine